@@ -45,7 +45,7 @@
 /*-----------------------------------------------------------*/
 // DEFINES
 
-#if defined(portEXT_RAM) && !defined(portEXT_RAMFS)
+#if defined(portEXT_RAM) && !defined(portEXT_RAMFS) && !defined(portEXT_RAM_TASK_BANKS)
 #define CMD_BUFFER_SIZE 8192	// size of working buffer (on heap) with extended RAM EtherMega
 #else
 #define CMD_BUFFER_SIZE 2048	// size of working buffer (on heap) for standard EtherMega
@@ -343,6 +343,11 @@ static void TaskSDMonitor(void *pvParameters) // Monitor for SD Card
 			}
 			break;
 
+#if ( configUSE_HEAP_STATS == 1 )
+		case 'h' :	/* h - Show heap state and recent allocations */
+			xSerialxPrintHeapStats( &xSerialPort );
+			break;
+#endif
 
 		case 'f' :
 			switch (*ptr++) {
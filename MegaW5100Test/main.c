@@ -20,6 +20,7 @@
 #include <task.h>
 #include <queue.h>
 #include <semphr.h>
+#include <event_groups.h>
 
 /* External RAM include file. */
 #include <ext_ram.h>
@@ -97,7 +98,10 @@ extern uint8_t rxsize[MAX_SOCK_NUM];
 
 
 xTaskHandle xTaskDHCP;			// make a Task handle so we can suspend and resume the DHCP task.
-xTaskHandle xTaskWebServer;		// make a Task handle so we can suspend and resume the WebServer task.
+
+xEventGroupHandle xNetworkEvents;	// set by the DHCP task, the WebServer task waits for all of them.
+#define mainIP_LEASED_BIT	( ( xEventBits ) 0x01 )	// DHCP has given us an IP address.
+#define mainSD_READY_BIT	( ( xEventBits ) 0x02 )	// the SD card initialised, so there are pages to serve.
 
 extern HTTP_REQUEST *pHTTPRequest;		// HTTPD request buffer - used in webserver.c - declared in http.c
 										// Pointer to HTTP request
@@ -193,6 +197,8 @@ int16_t main(void)
 		,  3
 		,  NULL ); // */
 
+	xNetworkEvents = xEventGroupCreate();
+
     xTaskCreate(
 		TaskDHCP
 		,  (const signed portCHAR *)"DHCP" // DHCP Client
@@ -207,7 +213,7 @@ int16_t main(void)
 		,  2048				// Tested x free
 		,  NULL
 		,  2
-		,  &xTaskWebServer ); // */ // This task has a handle, for suspension and resumption.
+		,  NULL ); // */
 
     xTaskCreate(
 		TaskSDMonitor
@@ -239,8 +245,9 @@ static void TaskWebServer (void *pvParameters) // Web Server
 	SOCKET ch;
 	uint16_t len;
 
-	vTaskSuspend( NULL );	// suspend ourselves, until we have IP address, etc.
-							// vTaskResume() found in DHCP task.
+	// wait until we have an IP address, and an SD card to serve pages from.
+	// the bits are set in the DHCP task.
+	xEventGroupWaitBits( xNetworkEvents, mainIP_LEASED_BIT | mainSD_READY_BIT, pdFALSE, pdTRUE, portMAX_DELAY );
 
 	// Initialise the HTTPD socket on the w5200
 	if(!init_HTTP(HTTP_PREFERRED_SOCKET)) // initialise the socket for HTTP service
@@ -349,6 +356,9 @@ static void TaskDHCP(void *pvParameters) // DHCP Client
 			if( disk_initialize (0) )		// If it didn't initialise, or the card is write protected, then call it out.
 				xSerialPrint_P(PSTR("\r\nSDCard initialisation failed..!\r\nPlease power cycle the SDCard.\r\nCheck write protect.\r\n"));
 
+	if( !(disk_status (0) & STA_NOINIT) )
+		xEventGroupSetBits( xNetworkEvents, mainSD_READY_BIT );
+
 	// Initialise the W5100 & SPI bus
 	init_DHCP_client(DHCP_PREFERRED_SOCKET,0,0);
 
@@ -362,8 +372,8 @@ static void TaskDHCP(void *pvParameters) // DHCP Client
 #endif
 	}
 
-	// resume the TaskWebServer() task, now that we have an IP address.
-	vTaskResume( xTaskWebServer );
+	// release the TaskWebServer() task, now that we have an IP address.
+	xEventGroupSetBits( xNetworkEvents, mainIP_LEASED_BIT );
 
 	init_NTP( NTP_PREFERRED_SOCKET );
 
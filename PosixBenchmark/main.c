@@ -0,0 +1,540 @@
+////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////
+////    main.c
+////	Kernel benchmark runner for the POSIX host port.
+////	Build with the Makefile in this directory, then run ./benchmark [iterations]
+////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>		// host <time.h>, for clock_gettime(). The AVR lib_time header is not on this path.
+
+/* Scheduler include files. */
+#include <FreeRTOS.h>
+#include <task.h>
+#include <queue.h>
+#include <semphr.h>
+#include <stream_buffer.h>
+#include <event_groups.h>
+
+/*-----------------------------------------------------------*/
+
+#define benchDEFAULT_ITERATIONS		100000UL
+#define benchQUEUE_LENGTH			8
+
+/* heap_1 cannot free, so the objects each benchmark creates are left
+   allocated and the pvPortMalloc()/vPortFree() rows are skipped. */
+#if defined( benchHEAP_heap_1 )
+	#define benchCAN_FREE			0
+#else
+	#define benchCAN_FREE			1
+#endif
+
+/* The controller runs at the same priority as the yield partner, and below the echo task. */
+#define benchCONTROL_PRIORITY		( tskIDLE_PRIORITY + 1 )
+#define benchECHO_PRIORITY			( tskIDLE_PRIORITY + 2 )
+
+static unsigned long ulIterations = benchDEFAULT_ITERATIONS;
+
+static xTaskHandle xBenchHandle = NULL;
+static xTaskHandle xYieldHandle = NULL;
+static xTaskHandle xNotifyHandle = NULL;
+
+/* The event group round trip: the benchmark task sets the ping bit, the event task answers with the pong bit. */
+#define benchEVENT_PING_BIT			( ( xEventBits ) 0x01 )
+#define benchEVENT_PONG_BIT			( ( xEventBits ) 0x02 )
+
+static xEventGroupHandle xEvents = NULL;
+
+static xQueueHandle xPingQueue = NULL;
+static xQueueHandle xPongQueue = NULL;
+
+/* The echo task and its queues are allocated at link time. */
+static portSTACK_TYPE xEchoStack[ configMINIMAL_STACK_SIZE ];
+static xStaticTask xEchoTask;
+static unsigned char ucPingStorage[ sizeof( unsigned long ) ];
+static unsigned char ucPongStorage[ sizeof( unsigned long ) ];
+static xStaticQueue xPingQueueBuffer;
+static xStaticQueue xPongQueueBuffer;
+
+static void TaskBenchmark(void *pvParameters); // Runs each benchmark in turn, then ends the scheduler.
+static void TaskYield(void *pvParameters);     // Yield partner for the context switch benchmark.
+static void TaskEcho(void *pvParameters);      // Echoes the ping queue back on the pong queue.
+static void TaskNotify(void *pvParameters);    // Echoes each notification back to the benchmark task.
+static void TaskEvents(void *pvParameters);    // Answers each ping bit with a pong bit.
+
+static unsigned long long prvNanoseconds( void );
+static void prvReport( const char *pcName, unsigned long long ullStart, unsigned long ulOperations );
+
+static void prvBenchYield( void );
+static void prvBenchQueue( unsigned portBASE_TYPE uxItemSize );
+static void prvBenchQueueZeroCopy( unsigned portBASE_TYPE uxItemSize );
+static void prvBenchQueuePingPong( void );
+static void prvBenchMessageBuffer( size_t xMessageSize );
+static void prvBenchSemaphore( void );
+static void prvBenchNotify( void );
+static void prvBenchEventGroup( void );
+static void prvBenchMutex( void );
+#if ( benchCAN_FREE == 1 )
+static void prvBenchHeap( size_t xSize );
+#endif
+static void prvBenchDelay( void );
+/*-----------------------------------------------------------*/
+
+int main( int argc, char *argv[] )
+{
+	if( argc > 1 )
+	{
+		ulIterations = strtoul( argv[ 1 ], NULL, 0 );
+		if( ulIterations == 0 ) ulIterations = benchDEFAULT_ITERATIONS;
+	}
+
+	printf( "FreeRTOS " tskKERNEL_VERSION_NUMBER " POSIX host port, %lu iterations\n\n", ulIterations );
+	printf( "%-32s %12s %14s\n", "benchmark", "ns/op", "operations" );
+
+	xTaskCreate(
+		TaskBenchmark
+		,  (const signed portCHAR *)"Bench"
+		,  configMINIMAL_STACK_SIZE
+		,  NULL
+		,  benchCONTROL_PRIORITY
+		,  &xBenchHandle );
+
+	xTaskCreate(
+		TaskYield
+		,  (const signed portCHAR *)"Yield"
+		,  configMINIMAL_STACK_SIZE
+		,  NULL
+		,  benchCONTROL_PRIORITY
+		,  &xYieldHandle );
+
+	xTaskCreateStatic(
+		TaskEcho
+		,  (const signed portCHAR *)"Echo"
+		,  configMINIMAL_STACK_SIZE
+		,  NULL
+		,  benchECHO_PRIORITY
+		,  xEchoStack
+		,  &xEchoTask );
+
+	xTaskCreate(
+		TaskNotify
+		,  (const signed portCHAR *)"Notify"
+		,  configMINIMAL_STACK_SIZE
+		,  NULL
+		,  benchECHO_PRIORITY
+		,  &xNotifyHandle );
+
+	xEvents = xEventGroupCreate();
+
+	xTaskCreate(
+		TaskEvents
+		,  (const signed portCHAR *)"Events"
+		,  configMINIMAL_STACK_SIZE
+		,  NULL
+		,  benchECHO_PRIORITY
+		,  NULL );
+
+	vTaskStartScheduler();
+
+	printf( "\nsimulated ticks: %llu\n", ullPortGetSimulatedTicks() );
+
+	return 0;
+}
+
+/*-----------------------------------------------------------*/
+
+static void TaskBenchmark(void *pvParameters)
+{
+	(void) pvParameters;
+
+	/* The yield partner is only wanted for the yield benchmark. */
+	vTaskSuspend( xYieldHandle );
+
+	prvBenchYield();
+
+	prvBenchQueue( 1 );
+	prvBenchQueue( 4 );
+	prvBenchQueue( 16 );
+	prvBenchQueue( 32 );
+	prvBenchQueue( 64 );
+
+	prvBenchQueueZeroCopy( 1 );
+	prvBenchQueueZeroCopy( 64 );
+
+	prvBenchQueuePingPong();
+
+	prvBenchMessageBuffer( 1 );
+	prvBenchMessageBuffer( 64 );
+
+	prvBenchSemaphore();
+	prvBenchNotify();
+	prvBenchEventGroup();
+	prvBenchMutex();
+
+#if ( benchCAN_FREE == 1 )
+	prvBenchHeap( 8 );
+	prvBenchHeap( 32 );
+	prvBenchHeap( 128 );
+#endif
+
+	prvBenchDelay();
+
+#if !defined( benchHEAP_heap_3 )
+	/* heap_3 is the C library malloc(), which has no free heap figure. */
+	printf( "\nFree Heap Size: %u\n", (unsigned int)xPortGetFreeHeapSize() );
+#endif
+
+	vTaskEndScheduler();
+
+	/* Not reached. */
+	for( ;; );
+}
+
+/*-----------------------------------------------------------*/
+
+static void TaskYield(void *pvParameters)
+{
+	(void) pvParameters;
+
+	for( ;; )
+	{
+		taskYIELD();
+	}
+}
+
+/*-----------------------------------------------------------*/
+
+static void TaskEcho(void *pvParameters)
+{
+	(void) pvParameters;
+	unsigned long ulValue;
+
+	xPingQueue = xQueueCreateStatic( 1, sizeof( ulValue ), ucPingStorage, &xPingQueueBuffer );
+	xPongQueue = xQueueCreateStatic( 1, sizeof( ulValue ), ucPongStorage, &xPongQueueBuffer );
+
+	for( ;; )
+	{
+		if( xQueueReceive( xPingQueue, &ulValue, portMAX_DELAY ) == pdPASS )
+		{
+			xQueueSend( xPongQueue, &ulValue, portMAX_DELAY );
+		}
+	}
+}
+
+static void TaskNotify(void *pvParameters)
+{
+	(void) pvParameters;
+
+	for( ;; )
+	{
+		ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+		xTaskNotifyGive( xBenchHandle );
+	}
+}
+
+static void TaskEvents(void *pvParameters)
+{
+	(void) pvParameters;
+
+	for( ;; )
+	{
+		xEventGroupWaitBits( xEvents, benchEVENT_PING_BIT, pdTRUE, pdFALSE, portMAX_DELAY );
+		xEventGroupSetBits( xEvents, benchEVENT_PONG_BIT );
+	}
+}
+
+/*-----------------------------------------------------------*/
+
+static unsigned long long prvNanoseconds( void )
+{
+	struct timespec xNow;
+
+	clock_gettime( CLOCK_MONOTONIC, &xNow );
+
+	return ( unsigned long long ) xNow.tv_sec * 1000000000ULL + ( unsigned long long ) xNow.tv_nsec;
+}
+
+static void prvReport( const char *pcName, unsigned long long ullStart, unsigned long ulOperations )
+{
+	unsigned long long ullElapsed = prvNanoseconds() - ullStart;
+
+	printf( "%-32s %12.1f %14lu\n", pcName, ( double ) ullElapsed / ( double ) ulOperations, ulOperations );
+}
+
+/*-----------------------------------------------------------*/
+
+/* Two tasks of equal priority yielding to each other. Each taskYIELD() is one context switch. */
+static void prvBenchYield( void )
+{
+	unsigned long ulCount;
+	unsigned long long ullStart;
+
+	vTaskResume( xYieldHandle );
+
+	ullStart = prvNanoseconds();
+	for( ulCount = 0; ulCount < ulIterations; ulCount++ )
+	{
+		taskYIELD();
+	}
+	prvReport( "taskYIELD (one switch)", ullStart, ulIterations * 2 );
+
+	vTaskSuspend( xYieldHandle );
+}
+
+/* Send and receive on a queue without blocking, so only the copy and list handling is measured. */
+static void prvBenchQueue( unsigned portBASE_TYPE uxItemSize )
+{
+	unsigned long ulCount;
+	unsigned long long ullStart;
+	uint8_t ucItem[ 64 ];
+	char cName[ 32 ];
+	xQueueHandle xQueue;
+
+	xQueue = xQueueCreate( benchQUEUE_LENGTH, uxItemSize );
+	configASSERT( xQueue );
+
+	memset( ucItem, 0x55, sizeof( ucItem ) );
+
+	ullStart = prvNanoseconds();
+	for( ulCount = 0; ulCount < ulIterations; ulCount++ )
+	{
+		xQueueSend( xQueue, ucItem, 0 );
+		xQueueReceive( xQueue, ucItem, 0 );
+	}
+
+	snprintf( cName, sizeof( cName ), "queue send+receive %3u byte", ( unsigned int ) uxItemSize );
+	prvReport( cName, ullStart, ulIterations );
+
+#if ( benchCAN_FREE == 1 )
+	vQueueDelete( xQueue );
+#endif
+}
+
+/* As prvBenchQueue(), but the item is built and read in the queue storage, without the copies. */
+static void prvBenchQueueZeroCopy( unsigned portBASE_TYPE uxItemSize )
+{
+	unsigned long ulCount;
+	unsigned long long ullStart;
+	uint8_t *pucSlot;
+	char cName[ 32 ];
+	xQueueHandle xQueue;
+
+	xQueue = xQueueCreate( benchQUEUE_LENGTH, uxItemSize );
+	configASSERT( xQueue );
+
+	ullStart = prvNanoseconds();
+	for( ulCount = 0; ulCount < ulIterations; ulCount++ )
+	{
+		pucSlot = ( uint8_t * ) pvQueueReserve( xQueue, 0 );
+		pucSlot[ 0 ] = ( uint8_t ) ulCount;
+		xQueueCommit( xQueue );
+
+		pucSlot = ( uint8_t * ) pvQueuePeekInPlace( xQueue, 0 );
+		configASSERT( pucSlot[ 0 ] == ( uint8_t ) ulCount );
+		xQueueRelease( xQueue );
+	}
+
+	snprintf( cName, sizeof( cName ), "queue reserve+peek %3u byte", ( unsigned int ) uxItemSize );
+	prvReport( cName, ullStart, ulIterations );
+
+#if ( benchCAN_FREE == 1 )
+	vQueueDelete( xQueue );
+#endif
+}
+
+/* Round trip through the higher priority echo task. Each round trip is two blocking handoffs. */
+static void prvBenchQueuePingPong( void )
+{
+	unsigned long ulCount;
+	unsigned long ulValue;
+	unsigned long long ullStart;
+
+	ullStart = prvNanoseconds();
+	for( ulCount = 0; ulCount < ulIterations; ulCount++ )
+	{
+		xQueueSend( xPingQueue, &ulCount, portMAX_DELAY );
+		xQueueReceive( xPongQueue, &ulValue, portMAX_DELAY );
+		configASSERT( ulValue == ulCount );
+	}
+	prvReport( "queue ping-pong (round trip)", ullStart, ulIterations );
+}
+
+/* Write and read one message without blocking, so only the copies and index handling are measured. */
+static void prvBenchMessageBuffer( size_t xMessageSize )
+{
+	unsigned long ulCount;
+	unsigned long long ullStart;
+	uint8_t ucMessage[ 64 ];
+	char cName[ 32 ];
+	xMessageBufferHandle xMessageBuffer;
+
+	xMessageBuffer = xMessageBufferCreate( benchQUEUE_LENGTH * ( sizeof( ucMessage ) + sizeof( size_t ) ) );
+	configASSERT( xMessageBuffer );
+
+	memset( ucMessage, 0x55, sizeof( ucMessage ) );
+
+	ullStart = prvNanoseconds();
+	for( ulCount = 0; ulCount < ulIterations; ulCount++ )
+	{
+		xMessageBufferSend( xMessageBuffer, ucMessage, xMessageSize, 0 );
+		xMessageBufferReceive( xMessageBuffer, ucMessage, sizeof( ucMessage ), 0 );
+	}
+
+	snprintf( cName, sizeof( cName ), "message buffer send+rx %3u byte", ( unsigned int ) xMessageSize );
+	prvReport( cName, ullStart, ulIterations );
+
+#if ( benchCAN_FREE == 1 )
+	vMessageBufferDelete( xMessageBuffer );
+#endif
+}
+
+static void prvBenchSemaphore( void )
+{
+	unsigned long ulCount;
+	unsigned long long ullStart;
+	xSemaphoreHandle xSemaphore;
+
+	vSemaphoreCreateBinary( xSemaphore );
+	configASSERT( xSemaphore );
+
+	ullStart = prvNanoseconds();
+	for( ulCount = 0; ulCount < ulIterations; ulCount++ )
+	{
+		xSemaphoreTake( xSemaphore, 0 );
+		xSemaphoreGive( xSemaphore );
+	}
+	prvReport( "binary semaphore take+give", ullStart, ulIterations );
+
+#if ( benchCAN_FREE == 1 )
+	vSemaphoreDelete( xSemaphore );
+#endif
+}
+
+/* The same give and take as a task notification, then a round trip through the higher priority notify task. */
+static void prvBenchNotify( void )
+{
+	unsigned long ulCount;
+	unsigned long long ullStart;
+
+	ullStart = prvNanoseconds();
+	for( ulCount = 0; ulCount < ulIterations; ulCount++ )
+	{
+		xTaskNotifyGive( xBenchHandle );
+		ulTaskNotifyTake( pdTRUE, 0 );
+	}
+	prvReport( "task notify give+take", ullStart, ulIterations );
+
+	ullStart = prvNanoseconds();
+	for( ulCount = 0; ulCount < ulIterations; ulCount++ )
+	{
+		xTaskNotifyGive( xNotifyHandle );
+		ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+	}
+	prvReport( "task notify (round trip)", ullStart, ulIterations );
+}
+
+/* Setting and waiting for a bit that is already set, then a round trip through the higher priority event task. */
+static void prvBenchEventGroup( void )
+{
+	unsigned long ulCount;
+	unsigned long long ullStart;
+	xEventGroupHandle xGroup;
+
+	xGroup = xEventGroupCreate();
+	configASSERT( xGroup );
+
+	ullStart = prvNanoseconds();
+	for( ulCount = 0; ulCount < ulIterations; ulCount++ )
+	{
+		xEventGroupSetBits( xGroup, 0x01 );
+		xEventGroupWaitBits( xGroup, 0x01, pdTRUE, pdFALSE, 0 );
+	}
+	prvReport( "event group set+wait", ullStart, ulIterations );
+
+#if ( benchCAN_FREE == 1 )
+	vEventGroupDelete( xGroup );
+#endif
+
+	ullStart = prvNanoseconds();
+	for( ulCount = 0; ulCount < ulIterations; ulCount++ )
+	{
+		xEventGroupSetBits( xEvents, benchEVENT_PING_BIT );
+		xEventGroupWaitBits( xEvents, benchEVENT_PONG_BIT, pdTRUE, pdFALSE, portMAX_DELAY );
+	}
+	prvReport( "event group (round trip)", ullStart, ulIterations );
+}
+
+static void prvBenchMutex( void )
+{
+	unsigned long ulCount;
+	unsigned long long ullStart;
+	xSemaphoreHandle xMutex;
+
+	xMutex = xSemaphoreCreateMutex();
+	configASSERT( xMutex );
+
+	ullStart = prvNanoseconds();
+	for( ulCount = 0; ulCount < ulIterations; ulCount++ )
+	{
+		xSemaphoreTake( xMutex, 0 );
+		xSemaphoreGive( xMutex );
+	}
+	prvReport( "mutex take+give", ullStart, ulIterations );
+
+#if ( benchCAN_FREE == 1 )
+	vSemaphoreDelete( xMutex );
+#endif
+}
+
+#if ( benchCAN_FREE == 1 )
+static void prvBenchHeap( size_t xSize )
+{
+	unsigned long ulCount;
+	unsigned long long ullStart;
+	void *pvBlock;
+	char cName[ 32 ];
+
+	ullStart = prvNanoseconds();
+	for( ulCount = 0; ulCount < ulIterations; ulCount++ )
+	{
+		pvBlock = pvPortMalloc( xSize );
+		configASSERT( pvBlock );
+		vPortFree( pvBlock );
+	}
+
+	snprintf( cName, sizeof( cName ), "pvPortMalloc+vPortFree %3u", ( unsigned int ) xSize );
+	prvReport( cName, ullStart, ulIterations );
+}
+#endif
+
+/* Block for one tick. The idle task raises the tick, so this is the full
+   block, idle, tick, unblock and switch back path. */
+static void prvBenchDelay( void )
+{
+	unsigned long ulCount;
+	unsigned long ulDelays = ulIterations / 10 + 1;
+	unsigned long long ullStart;
+
+	ullStart = prvNanoseconds();
+	for( ulCount = 0; ulCount < ulDelays; ulCount++ )
+	{
+		vTaskDelay( 1 );
+	}
+	prvReport( "vTaskDelay(1) block+wake", ullStart, ulDelays );
+}
+
+/*-----------------------------------------------------------*/
+
+void vApplicationStackOverflowHook( xTaskHandle xTask,
+                                    signed portCHAR *pcTaskName )
+{
+	(void) xTask;
+
+	fprintf( stderr, "stack overflow in task %s\n", ( char * ) pcTaskName );
+	abort();
+}
+
+/*-----------------------------------------------------------*/
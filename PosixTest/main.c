@@ -0,0 +1,286 @@
+////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////
+////    main.c
+////	Library and kernel checks for the POSIX host port.
+////	Build with the Makefile in this directory, then run ./check
+////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <time.h>		// the AVR lib_time <time.h>, which is first on this path.
+
+/* Scheduler include files. */
+#include <FreeRTOS.h>
+#include <task.h>
+#include <queue.h>
+
+#include <lib_crc.h>
+#include <ringBuffer.h>
+
+/*-----------------------------------------------------------*/
+
+#define checkPRIORITY				( tskIDLE_PRIORITY + 1 )
+
+/* Count and report a check, with the expression and line when it fails. */
+#define checkTRUE( x )				prvCheck( ( x ), #x, __LINE__ )
+
+static unsigned int uxChecks = 0;
+static unsigned int uxFailures = 0;
+
+/* The queue the overwrite task writes to, and what xQueueOverwrite() returned. */
+static xQueueHandle xInPlaceQueue = NULL;
+static signed portBASE_TYPE xOverwriteResult = pdPASS;
+
+static void TaskCheck(void *pvParameters);     // Runs each group of checks in turn, then ends the scheduler.
+static void TaskOverwrite(void *pvParameters); // Overwrites the in place queue once, then suspends itself.
+
+static void prvCheck( int iPassed, const char *pcExpression, int iLine );
+
+static void prvCheckCRC( void );
+static void prvCheckRingBuffer( void );
+static void prvCheckTime( void );
+static void prvCheckQueueInPlace( void );
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xTaskCreate(
+		TaskCheck
+		,  (const signed portCHAR *)"Check"
+		,  configMINIMAL_STACK_SIZE
+		,  NULL
+		,  checkPRIORITY
+		,  NULL );
+
+	vTaskStartScheduler();
+
+	printf( "%u checks, %u failed\n", uxChecks, uxFailures );
+
+	return ( uxFailures == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*-----------------------------------------------------------*/
+
+static void TaskCheck(void *pvParameters)
+{
+	(void) pvParameters;
+
+	prvCheckCRC();
+	prvCheckRingBuffer();
+	prvCheckTime();
+	prvCheckQueueInPlace();
+
+	vTaskEndScheduler();
+
+	/* Not reached. */
+	for( ;; );
+}
+
+static void TaskOverwrite(void *pvParameters)
+{
+	(void) pvParameters;
+	unsigned long ulValue = 2;
+
+	xOverwriteResult = xQueueOverwrite( xInPlaceQueue, &ulValue );
+
+	vTaskSuspend( NULL );
+	for( ;; );
+}
+
+/*-----------------------------------------------------------*/
+
+static void prvCheck( int iPassed, const char *pcExpression, int iLine )
+{
+	++uxChecks;
+
+	if( !iPassed )
+	{
+		++uxFailures;
+		printf( "main.c:%d: failed: %s\n", iLine, pcExpression );
+	}
+}
+
+/*-----------------------------------------------------------*/
+
+/* The usual "123456789" check values, and the empty message. */
+static void prvCheckCRC( void )
+{
+	static const uint8_t ucMessage[] = "123456789";
+
+	checkTRUE( crc8( ucMessage, 9 ) == 0xA1 );
+	checkTRUE( crc8( ucMessage, 0 ) == 0x00 );
+
+	checkTRUE( crc16_ccitt( ucMessage, 9 ) == 0x31C3 );
+	checkTRUE( crc16_ccitt( ucMessage, 0 ) == 0x0000 );
+}
+
+/* Fill, wrap and drain a small buffer, counting as it goes. */
+static void prvCheckRingBuffer( void )
+{
+	ringBuffer_t xBuffer;
+	uint8_t ucStorage[ 4 ];
+	uint8_t ucByte;
+
+	ringBuffer_InitBuffer( &xBuffer, ucStorage, sizeof( ucStorage ) );
+	checkTRUE( ringBuffer_IsEmpty( &xBuffer ) );
+	checkTRUE( ringBuffer_GetFreeCount( &xBuffer ) == 4 );
+
+	for( ucByte = 1; ucByte <= 4; ucByte++ )
+	{
+		ringBuffer_Poke( &xBuffer, ucByte );
+	}
+	checkTRUE( ringBuffer_IsFull( &xBuffer ) );
+	checkTRUE( ringBuffer_Peek( &xBuffer ) == 1 );
+	checkTRUE( ringBuffer_Pop( &xBuffer ) == 1 );
+	checkTRUE( ringBuffer_Pop( &xBuffer ) == 2 );
+
+	/* These two wrap round to the start of the storage. */
+	ringBuffer_Poke( &xBuffer, 5 );
+	ringBuffer_Poke( &xBuffer, 6 );
+	checkTRUE( ringBuffer_GetCount( &xBuffer ) == 4 );
+
+	for( ucByte = 3; ucByte <= 6; ucByte++ )
+	{
+		checkTRUE( ringBuffer_Pop( &xBuffer ) == ucByte );
+	}
+	checkTRUE( ringBuffer_IsEmpty( &xBuffer ) );
+
+	ringBuffer_Poke( &xBuffer, 7 );
+	ringBuffer_Flush( &xBuffer );
+	checkTRUE( ringBuffer_GetCount( &xBuffer ) == 0 );
+}
+
+/* Conversions either side of the Y2K epoch, leap years and the time zone. */
+static void prvCheckTime( void )
+{
+	struct tm xTime;
+	time_t xStamp;
+	char cBuffer[ 32 ];
+
+	xStamp = 0;
+	gmtime_r( &xStamp, &xTime );
+	checkTRUE( xTime.tm_year == 100 && xTime.tm_mon == 0 && xTime.tm_mday == 1 );
+	checkTRUE( xTime.tm_hour == 0 && xTime.tm_min == 0 && xTime.tm_sec == 0 );
+	checkTRUE( xTime.tm_wday == 6 && xTime.tm_yday == 0 );
+
+	isotime_r( &xTime, cBuffer );
+	checkTRUE( strcmp( cBuffer, "2000-01-01 00:00:00" ) == 0 );
+
+	/* 2012-02-29 12:34:56 UTC is 1330518896 as a Unix time stamp. */
+	xStamp = 1330518896UL - UNIX_OFFSET;
+	gmtime_r( &xStamp, &xTime );
+	checkTRUE( xTime.tm_year == 112 && xTime.tm_mon == 1 && xTime.tm_mday == 29 );
+	checkTRUE( xTime.tm_hour == 12 && xTime.tm_min == 34 && xTime.tm_sec == 56 );
+	checkTRUE( xTime.tm_wday == 3 && xTime.tm_yday == 59 );
+	checkTRUE( mk_gmtime( &xTime ) == xStamp );
+
+	strftime( cBuffer, sizeof( cBuffer ), "%a %d %b %Y %H:%M:%S", &xTime );
+	checkTRUE( strcmp( cBuffer, "Wed 29 Feb 2012 12:34:56" ) == 0 );
+
+	checkTRUE( month_length( 2012, 2 ) == 29 );
+	checkTRUE( month_length( 2100, 2 ) == 28 );
+	checkTRUE( is_leap_year( 2000 ) && !is_leap_year( 2100 ) );
+
+	/* Five hours West of UTC, midnight on the 2nd is the evening of the 1st. */
+	set_zone( -5 * ONE_HOUR );
+	xStamp = ONE_DAY;
+	localtime_r( &xStamp, &xTime );
+	checkTRUE( xTime.tm_year == 100 && xTime.tm_mon == 0 && xTime.tm_mday == 1 );
+	checkTRUE( xTime.tm_hour == 19 );
+	checkTRUE( mktime( &xTime ) == xStamp );
+	set_zone( 0 );
+
+	checkTRUE( difftime( 100, 40 ) == 60 );
+}
+
+/* Neither overwriting nor sending to the front may touch a slot reserved by
+   pvQueueReserve() or an item held by pvQueuePeekInPlace(), from a task or an
+   interrupt, until it is committed or released. */
+static void prvCheckQueueInPlace( void )
+{
+	xQueueHandle xQueue;
+	unsigned long ulValue;
+	unsigned long *pulItem;
+	signed portBASE_TYPE xWoken = pdFALSE;
+
+	xInPlaceQueue = xQueueCreate( 1, sizeof( ulValue ) );
+	checkTRUE( xInPlaceQueue != NULL );
+
+	pulItem = ( unsigned long * ) pvQueueReserve( xInPlaceQueue, 0 );
+	checkTRUE( pulItem != NULL );
+	*pulItem = 1;
+
+	/* The overwrite task is the higher priority, so it runs as it is created. */
+	xTaskCreate(
+		TaskOverwrite
+		,  (const signed portCHAR *)"Overwrite"
+		,  configMINIMAL_STACK_SIZE
+		,  NULL
+		,  checkPRIORITY + 1
+		,  NULL );
+	checkTRUE( xOverwriteResult == errQUEUE_FULL );
+
+	ulValue = 3;
+	checkTRUE( xQueueOverwriteFromISR( xInPlaceQueue, &ulValue, &xWoken ) == errQUEUE_FULL );
+
+	checkTRUE( xQueueCommit( xInPlaceQueue ) == pdPASS );
+	checkTRUE( uxQueueMessagesWaiting( xInPlaceQueue ) == 1 );
+	checkTRUE( xQueueReceive( xInPlaceQueue, &ulValue, 0 ) == pdPASS );
+	checkTRUE( ulValue == 1 );
+	checkTRUE( uxQueueMessagesWaiting( xInPlaceQueue ) == 0 );
+
+	ulValue = 4;
+	xQueueSend( xInPlaceQueue, &ulValue, 0 );
+	pulItem = ( unsigned long * ) pvQueuePeekInPlace( xInPlaceQueue, 0 );
+	checkTRUE( pulItem != NULL );
+
+	ulValue = 5;
+	checkTRUE( xQueueOverwrite( xInPlaceQueue, &ulValue ) == errQUEUE_FULL );
+	checkTRUE( xQueueOverwriteFromISR( xInPlaceQueue, &ulValue, &xWoken ) == errQUEUE_FULL );
+	checkTRUE( *pulItem == 4 );
+
+	checkTRUE( xQueueRelease( xInPlaceQueue ) == pdPASS );
+	checkTRUE( uxQueueMessagesWaiting( xInPlaceQueue ) == 0 );
+	checkTRUE( xQueueOverwrite( xInPlaceQueue, &ulValue ) == pdPASS );
+	checkTRUE( xQueueReceive( xInPlaceQueue, &ulValue, 0 ) == pdPASS );
+	checkTRUE( ulValue == 5 );
+
+	/* With room in the queue, a send to the front waits for the held item, and
+	   the release still removes the item that was read. */
+	xQueue = xQueueCreate( 4, sizeof( ulValue ) );
+	checkTRUE( xQueue != NULL );
+
+	ulValue = 6;
+	xQueueSend( xQueue, &ulValue, 0 );
+	ulValue = 7;
+	xQueueSend( xQueue, &ulValue, 0 );
+	pulItem = ( unsigned long * ) pvQueuePeekInPlace( xQueue, 0 );
+	checkTRUE( pulItem != NULL && *pulItem == 6 );
+
+	ulValue = 8;
+	checkTRUE( xQueueSendToFront( xQueue, &ulValue, 2 ) == errQUEUE_FULL );
+	checkTRUE( xQueueSendToFrontFromISR( xQueue, &ulValue, &xWoken ) == errQUEUE_FULL );
+	checkTRUE( xQueueSendToBack( xQueue, &ulValue, 0 ) == pdPASS );
+
+	checkTRUE( xQueueRelease( xQueue ) == pdPASS );
+	checkTRUE( xQueueReceive( xQueue, &ulValue, 0 ) == pdPASS );
+	checkTRUE( ulValue == 7 );
+	checkTRUE( xQueueSendToFront( xQueue, &ulValue, 0 ) == pdPASS );
+	checkTRUE( uxQueueMessagesWaiting( xQueue ) == 2 );
+}
+
+/*-----------------------------------------------------------*/
+
+void vApplicationStackOverflowHook( xTaskHandle xTask,
+                                    signed portCHAR *pcTaskName )
+{
+	(void) xTask;
+
+	fprintf( stderr, "stack overflow in task %s\n", ( char * ) pcTaskName );
+	abort();
+}
+
+/*-----------------------------------------------------------*/
@@ -0,0 +1,474 @@
+////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////
+////    main.c
+////	Cycle counting benchmark of the kernel primitives, for the real AVR build.
+////	Runs under simavr (see run_benchmarks.sh) or on the board itself.
+////	Cycles are counted by Timer1 running at the CPU clock, which is not the
+////	tick timer on any of the Uno, Goldilocks or Mega boards.
+////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+#include <avr/sleep.h>
+
+/* Scheduler include files. */
+#include <FreeRTOS.h>
+#include <task.h>
+#include <queue.h>
+#include <semphr.h>
+
+/* serial interface include file. */
+#include <lib_serial.h>
+
+/*-----------------------------------------------------------*/
+// DEFINES
+
+#define benchSAMPLES				32		// samples taken of each primitive
+#define benchTICK_SAMPLES			16		// ticks sampled for the tick ISR and wake up latency
+#define benchTICK_GAP				64		// cycles. A longer gap in the spin loop means the tick ISR ran
+
+#define benchCONTROL_PRIORITY		( tskIDLE_PRIORITY + 2 )	// benchmark task, and its yield partner
+#define benchWAKE_PRIORITY			( tskIDLE_PRIORITY + 3 )	// vTaskDelayUntil() task, preempts everything
+#define benchSPIN_PRIORITY			( tskIDLE_PRIORITY + 1 )	// stamps the cycle count while others block
+
+// Timer1 free running at the CPU clock. The count wraps every 65536 cycles,
+// so everything measured must be shorter than that.
+#define benchCYCLES()				TCNT1
+
+typedef struct xCYCLE_STATS
+{
+	PGM_P pcName;
+	uint16_t usMin;
+	uint16_t usMax;
+	uint32_t ulSum;
+	uint16_t usCount;
+} xCycleStats;
+
+enum
+{
+	eYieldOne = 0,
+	eYieldRound,
+	eTickIsr,
+	eDelayUntilWake,
+	eQueueSend1,
+	eQueueReceive1,
+	eQueueSend4,
+	eQueueReceive4,
+	eQueueSend8,
+	eQueueReceive8,
+	eQueueSend16,
+	eQueueReceive16,
+	eSemaphoreGive,
+	eSemaphoreTake,
+	eMutexTake,
+	eMutexGive,
+	eStatsCount
+};
+
+static const char pcYieldOne[] PROGMEM       = "vPortYield (one switch)";
+static const char pcYieldRound[] PROGMEM     = "vPortYield (round trip)";
+static const char pcTickIsr[] PROGMEM        = "tick ISR (no switch)";
+static const char pcDelayUntilWake[] PROGMEM = "vTaskDelayUntil wake";
+static const char pcQueueSend1[] PROGMEM     = "xQueueSend 1 byte";
+static const char pcQueueReceive1[] PROGMEM  = "xQueueReceive 1 byte";
+static const char pcQueueSend4[] PROGMEM     = "xQueueSend 4 byte";
+static const char pcQueueReceive4[] PROGMEM  = "xQueueReceive 4 byte";
+static const char pcQueueSend8[] PROGMEM     = "xQueueSend 8 byte";
+static const char pcQueueReceive8[] PROGMEM  = "xQueueReceive 8 byte";
+static const char pcQueueSend16[] PROGMEM    = "xQueueSend 16 byte";
+static const char pcQueueReceive16[] PROGMEM = "xQueueReceive 16 byte";
+static const char pcSemaphoreGive[] PROGMEM  = "xSemaphoreGive";
+static const char pcSemaphoreTake[] PROGMEM  = "xSemaphoreTake";
+static const char pcMutexTake[] PROGMEM      = "xSemaphoreTake mutex";
+static const char pcMutexGive[] PROGMEM      = "xSemaphoreGive mutex";
+
+static xCycleStats xStats[ eStatsCount ] =
+{
+	{ pcYieldOne, 0xffff, 0, 0, 0 },
+	{ pcYieldRound, 0xffff, 0, 0, 0 },
+	{ pcTickIsr, 0xffff, 0, 0, 0 },
+	{ pcDelayUntilWake, 0xffff, 0, 0, 0 },
+	{ pcQueueSend1, 0xffff, 0, 0, 0 },
+	{ pcQueueReceive1, 0xffff, 0, 0, 0 },
+	{ pcQueueSend4, 0xffff, 0, 0, 0 },
+	{ pcQueueReceive4, 0xffff, 0, 0, 0 },
+	{ pcQueueSend8, 0xffff, 0, 0, 0 },
+	{ pcQueueReceive8, 0xffff, 0, 0, 0 },
+	{ pcQueueSend16, 0xffff, 0, 0, 0 },
+	{ pcQueueReceive16, 0xffff, 0, 0, 0 },
+	{ pcSemaphoreGive, 0xffff, 0, 0, 0 },
+	{ pcSemaphoreTake, 0xffff, 0, 0, 0 },
+	{ pcMutexTake, 0xffff, 0, 0, 0 },
+	{ pcMutexGive, 0xffff, 0, 0, 0 }
+};
+
+/* Cost of reading the cycle counter twice, removed from every sample. */
+static uint16_t usOverhead;
+
+/* Stamps written by the partner and spin tasks, read after the switch. */
+static volatile uint16_t usPartnerStamp;
+static volatile uint16_t usSpinStamp;
+
+static xTaskHandle xPartnerHandle;
+static xTaskHandle xWakeHandle;
+
+/* Create a handle for the serial port. */
+extern xComPortHandle xSerialPort;
+
+static void TaskBenchmark(void *pvParameters); // Runs each benchmark in turn, then reports.
+static void TaskPartner(void *pvParameters);   // Yield partner, at the benchmark priority.
+static void TaskWake(void *pvParameters);      // Measures the vTaskDelayUntil() wake up.
+static void TaskSpin(void *pvParameters);      // Lowest priority, stamps the cycle count.
+
+static void vStatsAdd( uint8_t ucIndex, uint16_t usCycles );
+static void vStatsReport( void );
+
+static void prvBenchYield( void );
+static void prvBenchTick( void );
+static void prvBenchDelayUntil( void );
+static void prvBenchQueue( uint8_t ucItemSize, uint8_t ucSendIndex );
+static void prvBenchSemaphore( void );
+static void prvBenchMutex( void );
+/*-----------------------------------------------------------*/
+
+/* Main program loop */
+int16_t main(void) __attribute__((OS_main));
+
+int16_t main(void)
+{
+	/* Timer1 normal mode, no prescale, no interrupts. */
+	TCCR1A = 0;
+	TCCR1B = _BV(CS10);
+
+	// turn on the serial port for the report. Only the polled avrSerial routines are used, so the
+	// serial interrupt does not disturb the measurements.
+	xSerialPort = xSerialPortInitMinimal( USART0, 38400, 80, 8); //  serial port: WantedBaud, TxQueueLength, RxQueueLength (8n1)
+
+    xTaskCreate(
+		TaskBenchmark
+		,  (const signed portCHAR *)"Bench"
+		,  200
+		,  NULL
+		,  benchCONTROL_PRIORITY
+		,  NULL ); // */
+
+    xTaskCreate(
+		TaskPartner
+		,  (const signed portCHAR *)"Partner"
+		,  configMINIMAL_STACK_SIZE
+		,  NULL
+		,  benchCONTROL_PRIORITY
+		,  &xPartnerHandle ); // */
+
+    xTaskCreate(
+		TaskWake
+		,  (const signed portCHAR *)"Wake"
+		,  configMINIMAL_STACK_SIZE
+		,  NULL
+		,  benchWAKE_PRIORITY
+		,  &xWakeHandle ); // */
+
+    xTaskCreate(
+		TaskSpin
+		,  (const signed portCHAR *)"Spin"
+		,  configMINIMAL_STACK_SIZE
+		,  NULL
+		,  benchSPIN_PRIORITY
+		,  NULL ); // */
+
+	vTaskStartScheduler();
+
+	avrSerialPrint_P(PSTR("\r\n\n\nGoodbye... no space for idle task!\r\n")); // Doh, so we're dead...
+}
+
+/*-----------------------------------------------------------*/
+
+static void TaskBenchmark(void *pvParameters)
+{
+	(void) pvParameters;
+	uint16_t usStart;
+
+	/* The partner is only wanted for the yield benchmark. The wake task
+	suspends itself. */
+	vTaskSuspend( xPartnerHandle );
+
+	usStart = benchCYCLES();
+	usOverhead = benchCYCLES() - usStart;
+
+	prvBenchYield();
+	prvBenchTick();
+	prvBenchDelayUntil();
+
+	prvBenchQueue( 1, eQueueSend1 );
+	prvBenchQueue( 4, eQueueSend4 );
+	prvBenchQueue( 8, eQueueSend8 );
+	prvBenchQueue( 16, eQueueSend16 );
+
+	prvBenchSemaphore();
+	prvBenchMutex();
+
+	vStatsReport();
+
+	/* simavr exits when the CPU sleeps with interrupts off. */
+	cli();
+	sleep_enable();
+	for(;;)
+		sleep_cpu();
+}
+
+/*-----------------------------------------------------------*/
+
+static void TaskPartner(void *pvParameters)
+{
+	(void) pvParameters;
+
+	for(;;)
+	{
+		cli();
+		usPartnerStamp = benchCYCLES();
+		sei();
+		taskYIELD();
+	}
+}
+
+/*-----------------------------------------------------------*/
+
+static void TaskWake(void *pvParameters)
+{
+	(void) pvParameters;
+	uint8_t ucCount;
+	uint16_t usNow;
+	portTickType xLastWakeTime;
+
+	for(;;)
+	{
+		/* Wait here until prvBenchDelayUntil() resumes us. */
+		vTaskSuspend( NULL );
+
+		xLastWakeTime = xTaskGetTickCount();
+
+		for( ucCount = 0; ucCount < benchTICK_SAMPLES; ucCount++ )
+		{
+			vTaskDelayUntil( &xLastWakeTime, 1 );
+			usNow = benchCYCLES();
+
+			/* The spin task was running until the tick, so its last stamp is
+			at most one loop before the tick ISR started. */
+			vStatsAdd( eDelayUntilWake, usNow - usSpinStamp - usOverhead );
+		}
+	}
+}
+
+/*-----------------------------------------------------------*/
+
+static void TaskSpin(void *pvParameters)
+{
+	(void) pvParameters;
+
+	for(;;)
+	{
+		cli();
+		usSpinStamp = benchCYCLES();
+		sei();
+	}
+}
+
+/*-----------------------------------------------------------*/
+
+static void vStatsAdd( uint8_t ucIndex, uint16_t usCycles )
+{
+	xCycleStats *pxStats = &xStats[ ucIndex ];
+
+	if( usCycles < pxStats->usMin ) pxStats->usMin = usCycles;
+	if( usCycles > pxStats->usMax ) pxStats->usMax = usCycles;
+	pxStats->ulSum += usCycles;
+	pxStats->usCount++;
+}
+
+static void vStatsReport( void )
+{
+	uint8_t ucIndex;
+	xCycleStats *pxStats;
+
+	avrSerialPrintf_P(PSTR("\r\nsimavr cycle report: %lu Hz, tick %u Hz, %u priorities\r\n"),
+			configCPU_CLOCK_HZ, configTICK_RATE_HZ, configMAX_PRIORITIES );
+	avrSerialPrintf_P(PSTR("%-24s %6s %6s %6s\r\n"), "benchmark", "min", "avg", "max" );
+
+	for( ucIndex = 0; ucIndex < eStatsCount; ucIndex++ )
+	{
+		pxStats = &xStats[ ucIndex ];
+
+		if( pxStats->usCount == 0 ) continue;
+
+		avrSerialPrintf_P(PSTR("%-24S %6u %6u %6u\r\n"), pxStats->pcName,
+				pxStats->usMin, (uint16_t)(pxStats->ulSum / pxStats->usCount), pxStats->usMax );
+	}
+
+	avrSerialPrint_P(PSTR("end of report\r\n"));
+}
+
+/*-----------------------------------------------------------*/
+
+/* Two tasks of equal priority yielding to each other. A tick landing inside
+   a sample shows up in the max column, never the min. */
+static void prvBenchYield( void )
+{
+	uint8_t ucCount;
+	uint16_t usStart, usEnd;
+
+	vTaskResume( xPartnerHandle );
+
+	for( ucCount = 0; ucCount < benchSAMPLES; ucCount++ )
+	{
+		usStart = benchCYCLES();
+		taskYIELD();
+		usEnd = benchCYCLES();
+
+		vStatsAdd( eYieldOne, usPartnerStamp - usStart - usOverhead );
+		vStatsAdd( eYieldRound, usEnd - usStart - usOverhead );
+	}
+
+	vTaskSuspend( xPartnerHandle );
+}
+
+/* Spin reading the cycle counter. The loop time is calibrated first, any
+   longer gap is the tick ISR, with no task switch as nothing else is ready at
+   this priority. */
+static void prvBenchTick( void )
+{
+	uint8_t ucTicks = 0;
+	uint16_t usPrevious, usNow, usGap, usLoop = 0xffff;
+	uint16_t usCount;
+
+	usPrevious = benchCYCLES();
+	for( usCount = 0; usCount < 64; usCount++ )
+	{
+		usNow = benchCYCLES();
+		usGap = usNow - usPrevious;
+		if( usGap < usLoop ) usLoop = usGap;
+		usPrevious = usNow;
+	}
+
+	usPrevious = benchCYCLES();
+	while( ucTicks < benchTICK_SAMPLES )
+	{
+		usNow = benchCYCLES();
+		usGap = usNow - usPrevious;
+		if( usGap > benchTICK_GAP )
+		{
+			vStatsAdd( eTickIsr, usGap - usLoop );
+			ucTicks++;
+		}
+		usPrevious = usNow;
+	}
+}
+
+/* The wake task measures from the spin task's last stamp, so this covers the
+   tick ISR, the unblock and vPortYieldFromTick() switching to the new task. */
+static void prvBenchDelayUntil( void )
+{
+	vTaskResume( xWakeHandle );
+
+	/* Let the wake task run its samples, with the spin task filling in. */
+	vTaskDelay( benchTICK_SAMPLES + 2 );
+}
+
+/* Send and receive without blocking, so only the copy and list handling is
+   measured. ucSendIndex is the send entry, the receive entry follows it. */
+static void prvBenchQueue( uint8_t ucItemSize, uint8_t ucSendIndex )
+{
+	uint8_t ucCount;
+	uint16_t usStart, usMiddle, usEnd;
+	uint8_t ucItem[ 16 ];
+	xQueueHandle xQueue;
+
+	xQueue = xQueueCreate( 2, ucItemSize );
+	if( xQueue == NULL ) return;
+
+	memset( ucItem, 0x55, sizeof( ucItem ) );
+
+	for( ucCount = 0; ucCount < benchSAMPLES; ucCount++ )
+	{
+		usStart = benchCYCLES();
+		xQueueSend( xQueue, ucItem, 0 );
+		usMiddle = benchCYCLES();
+		xQueueReceive( xQueue, ucItem, 0 );
+		usEnd = benchCYCLES();
+
+		vStatsAdd( ucSendIndex, usMiddle - usStart - usOverhead );
+		vStatsAdd( ucSendIndex + 1, usEnd - usMiddle - usOverhead );
+	}
+
+	vQueueDelete( xQueue );
+}
+
+static void prvBenchSemaphore( void )
+{
+	uint8_t ucCount;
+	uint16_t usStart, usMiddle, usEnd;
+	xSemaphoreHandle xSemaphore;
+
+	vSemaphoreCreateBinary( xSemaphore );
+	if( xSemaphore == NULL ) return;
+
+	/* Created available, so take it first. */
+	xSemaphoreTake( xSemaphore, 0 );
+
+	for( ucCount = 0; ucCount < benchSAMPLES; ucCount++ )
+	{
+		usStart = benchCYCLES();
+		xSemaphoreGive( xSemaphore );
+		usMiddle = benchCYCLES();
+		xSemaphoreTake( xSemaphore, 0 );
+		usEnd = benchCYCLES();
+
+		vStatsAdd( eSemaphoreGive, usMiddle - usStart - usOverhead );
+		vStatsAdd( eSemaphoreTake, usEnd - usMiddle - usOverhead );
+	}
+
+	vSemaphoreDelete( xSemaphore );
+}
+
+static void prvBenchMutex( void )
+{
+	uint8_t ucCount;
+	uint16_t usStart, usMiddle, usEnd;
+	xSemaphoreHandle xMutex;
+
+	xMutex = xSemaphoreCreateMutex();
+	if( xMutex == NULL ) return;
+
+	for( ucCount = 0; ucCount < benchSAMPLES; ucCount++ )
+	{
+		usStart = benchCYCLES();
+		xSemaphoreTake( xMutex, 0 );
+		usMiddle = benchCYCLES();
+		xSemaphoreGive( xMutex );
+		usEnd = benchCYCLES();
+
+		vStatsAdd( eMutexTake, usMiddle - usStart - usOverhead );
+		vStatsAdd( eMutexGive, usEnd - usMiddle - usOverhead );
+	}
+
+	vSemaphoreDelete( xMutex );
+}
+
+/*-----------------------------------------------------------*/
+
+void vApplicationStackOverflowHook( xTaskHandle xTask,
+                                    signed portCHAR *pcTaskName )
+{
+	avrSerialPrintf_P(PSTR("\r\nstack overflow in task %s\r\n"), pcTaskName );
+
+	cli();
+	sleep_enable();
+	for(;;)
+		sleep_cpu();
+}
+
+/*-----------------------------------------------------------*/
@@ -0,0 +1,67 @@
+#!/bin/sh
+#
+# Build the cycle benchmark for each board, run it under simavr, and keep the
+# report in reports/<board>.txt.
+#
+# If baseline/<board>.txt exists, every benchmark whose average cycle count
+# grew by more than REGRESSION_PCT percent (default 5) is listed, and the
+# script exits non zero. Commit a baseline with:
+#
+#     ./run_benchmarks.sh --update-baseline
+#
+# Needs avr-gcc, avr-libc and simavr (run_avr) on the path. The simulated
+# clock is F_CPU from the Makefile, so the cycle counts are those of the board.
+
+BOARDS="${BOARDS:-uno goldilocks mega}"
+REGRESSION_PCT="${REGRESSION_PCT:-5}"
+SIMAVR="${SIMAVR:-run_avr}"
+TIMEOUT="${TIMEOUT:-60}"
+
+cd "$(dirname "$0")" || exit 1
+
+mkdir -p reports
+status=0
+
+for board in $BOARDS; do
+	case $board in
+		uno)        mcu=atmega328p ;;
+		goldilocks) mcu=atmega1284p ;;
+		mega)       mcu=atmega2560 ;;
+		*)          echo "unknown board $board"; exit 1 ;;
+	esac
+
+	make -s BOARD=$board || exit 1
+
+	# simavr colours the uart output, and the firmware sends \r\n.
+	timeout "$TIMEOUT" "$SIMAVR" -m $mcu -f 16000000 bench-$board.elf 2>&1 \
+		| sed -e 's/\x1b\[[0-9;]*m//g' -e 's/\r//g' \
+		| sed -n '/^simavr cycle report/,/^end of report/p' > reports/$board.txt
+
+	if ! grep -q '^end of report' reports/$board.txt; then
+		echo "$board: no report from simavr (does it support $mcu?)"
+		status=1
+		continue
+	fi
+
+	echo "== $board ($mcu)"
+	cat reports/$board.txt
+
+	if [ "$1" = "--update-baseline" ]; then
+		mkdir -p baseline
+		cp reports/$board.txt baseline/$board.txt
+	elif [ -f baseline/$board.txt ]; then
+		# Benchmark names contain spaces, so the numbers are taken from the end of the line.
+		awk -v pct="$REGRESSION_PCT" -v board="$board" '
+			/^simavr|^benchmark|^end/ { next }
+			{ name = $0; sub(/ +[0-9]+ +[0-9]+ +[0-9]+$/, "", name); avg = $(NF-1) }
+			FNR == NR { base[name] = avg; next }
+			(name in base) && avg > base[name] * (1 + pct / 100) {
+				printf "%s: REGRESSION %s avg %d cycles, baseline %d\n", board, name, avg, base[name]
+				bad = 1
+			}
+			END { exit bad }
+		' baseline/$board.txt reports/$board.txt || status=1
+	fi
+done
+
+exit $status
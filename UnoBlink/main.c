@@ -19,6 +19,7 @@
 #include <task.h>
 #include <queue.h>
 #include <semphr.h>
+#include <timers.h>
 
 /* serial interface include file. */
 #include <lib_serial.h>
@@ -30,9 +31,11 @@
 /* Optionally, create reference to the handle for the serial port. */
 extern xComPortHandle xSerialPort;
 
-static void TaskBlinkRedLED(void *pvParameters); // Main Arduino Mega 2560, Freetronics EtherMega (Red) LED Blink
+static void TimerBlinkRedLED(xTimerHandle xTimer); // Main Arduino Mega 2560, Freetronics EtherMega (Red) LED Blink
 
-static void TaskBlinkGreenLED(void *pvParameters); // Main Arduino Uno 328p (Green) LED Blink
+static void TimerBlinkGreenLED(xTimerHandle xTimer); // Main Arduino Uno 328p (Green) LED Blink
+
+static void TaskPrintTime(void *pvParameters); // Timestamp to the serial port, once a second
 /*-----------------------------------------------------------*/
 
 /* Main program loop */
@@ -45,23 +48,44 @@ int main(void)
 
 	avrSerialxPrint_P(&xSerialPort, PSTR("\r\n\n\nHello World!\r\n")); // Ok, so we're alive...
 
-    xTaskCreate(
-		TaskBlinkRedLED
-		,  (const signed portCHAR *)"RedLED" // Main Arduino Mega 2560, Freetronics EtherMega (Red) LED Blink
-		,  256				// Tested 9 free @ 208
+	xTimerHandle xRedLED, xGreenLED;
+
+	DDRB |= _BV(DDB7) | _BV(DDB5);
+
+	// Both LEDs toggle from the timer daemon task, rather than from a task each with its own stack.
+	xRedLED = xTimerCreate(
+		(const signed portCHAR *)"RedLED" // Main Arduino Mega 2560, Freetronics EtherMega (Red) LED Blink
+		,  ( 500 / portTICK_RATE_MS )
+		,  pdTRUE			// auto reload
 		,  NULL
-		,  3
-		,  NULL ); // */
+		,  TimerBlinkRedLED );
+
+	xGreenLED = xTimerCreate(
+		(const signed portCHAR *)"GreenLED" // Main Arduino Uno 328p (Green) LED Blink
+		,  ( 500 / portTICK_RATE_MS )
+		,  pdTRUE			// auto reload
+		,  NULL
+		,  TimerBlinkGreenLED );
+
+	if( xRedLED != NULL )
+	{
+		// Let the red LED run up to 20ms late, so it can share a wake up with the green LED.
+		xTimerChangeSlack( xRedLED, ( 20 / portTICK_RATE_MS ), 0 );
+		xTimerStart( xRedLED, 0 );
+	}
 
+	if( xGreenLED != NULL )
+		xTimerStart( xGreenLED, 0 );
+
+	// The printf needs more stack than the timer daemon task has, so it keeps a task of its own.
     xTaskCreate(
-		TaskBlinkGreenLED
-		,  (const signed portCHAR *)"GreenLED" // Main Arduino Uno 328p (Green) LED Blink
+		TaskPrintTime
+		,  (const signed portCHAR *)"PrintTime"
 		,  256				// Tested 9 free @ 208
 		,  NULL
 		,  3
 		,  NULL ); // */
 
-
 	avrSerialxPrintf_P(&xSerialPort, PSTR("Free Heap Size: %u\r\n"), xPortGetFreeHeapSize() ); // needs heap_1 or heap_2 for this function to succeed.
 
 	vTaskStartScheduler();
@@ -73,72 +97,32 @@ int main(void)
 /*-----------------------------------------------------------*/
 
 
-static void TaskBlinkRedLED(void *pvParameters) // Main Red LED Flash
+static void TimerBlinkRedLED(xTimerHandle xTimer) // Main Red LED Flash
 {
-    (void) pvParameters;;
-    portTickType xLastWakeTime;
-	/* The xLastWakeTime variable needs to be initialised with the current tick
-	count.  Note that this is the only time we access this variable.  From this
-	point on xLastWakeTime is managed automatically by the vTaskDelayUntil()
-	API function. */
-	xLastWakeTime = xTaskGetTickCount();
-
-//	int8_t i;
-//	uint8_t j;
-
-//	lcd_Init();
+    (void) xTimer;
 
-	DDRB |= _BV(DDB7);
-
-    for(;;)
-    {
-
-    	PORTB |=  _BV(PORTB7);       // main (red IO_B7) LED on. EtherMega LED on
-		vTaskDelayUntil( &xLastWakeTime, ( 500 / portTICK_RATE_MS ) );
-
-//		lcd_Locate (0, 0);
-//		lcd_Printf_P(PSTR("HighWater @ %u"), uxTaskGetStackHighWaterMark(NULL));
-//		lcd_Cursor (1);
-
-#if _USE_FUEL
-		lcd_Locate (1, 0);
-		lcd_PutFuel (--i, 0);
-		if (i < 0) i = 6;
-#endif
-
-#if _USE_BAR
-		lcd_Locate (1, 2);
-		lcd_PutBar (j++, 14, 2);
-#endif
-
-		PORTB &= ~_BV(PORTB7);       // main (red IO_B7) LED off. EtherMega LED off
-		vTaskDelayUntil( &xLastWakeTime, ( 500 / portTICK_RATE_MS ) );
+	PORTB ^= _BV(PORTB7);       // main (red IO_B7) LED toggle. EtherMega LED
+}
 
-//		xSerialxPrintf_P(&xSerialPort, PSTR("RedLED HighWater @ %u\r\n"), uxTaskGetStackHighWaterMark(NULL));
-    }
+/*-----------------------------------------------------------*/
+static void TimerBlinkGreenLED(xTimerHandle xTimer) // Main Green LED Flash
+{
+    (void) xTimer;
 
+	PORTB ^= _BV(PORTB5);       // main (red PB5) LED toggle. Arduino LED
 }
 
 /*-----------------------------------------------------------*/
-static void TaskBlinkGreenLED(void *pvParameters) // Main Green LED Flash
+static void TaskPrintTime(void *pvParameters) // Timestamp to the serial port
 {
-    (void) pvParameters;;
+    (void) pvParameters;
     portTickType xLastWakeTime;
-	/* The xLastWakeTime variable needs to be initialised with the current tick
-	count.  Note that this is the only time we access this variable.  From this
-	point on xLastWakeTime is managed automatically by the vTaskDelayUntil()
-	API function. */
-	xLastWakeTime = xTaskGetTickCount();
 
-	DDRB |= _BV(DDB5);
+	xLastWakeTime = xTaskGetTickCount();
 
-    while(1)
+    for(;;)
     {
-    	PORTB |=  _BV(PORTB5);       // main (red PB5) LED on. Arduino LED on
-		vTaskDelayUntil( &xLastWakeTime, ( 500 / portTICK_RATE_MS ) );
-
-		PORTB &= ~_BV(PORTB5);       // main (red PB5) LED off. Arduino LED off
-		vTaskDelayUntil( &xLastWakeTime, ( 500 / portTICK_RATE_MS )  );
+		vTaskDelayUntil( &xLastWakeTime, ( 1000 / portTICK_RATE_MS ) );
 
 		xSerialxPrintf_P(&xSerialPort, PSTR("Current Timestamp: %lu xTaskGetTickCount(): %u\r\n"), time(NULL), xTaskGetTickCount());
     }
@@ -87,7 +87,7 @@ task.h is included from an application file. */
 
 /* Allocate the memory for the heap. */
 
-#if ( defined(portEXT_RAM) && !defined(portEXT_RAMFS) )
+#if ( defined(portEXT_RAM) && !defined(portEXT_RAMFS) && !defined(portEXT_RAM_TASK_BANKS) )
 static unsigned char ucHeap[ configTOTAL_HEAP_SIZE ]  __attribute__((section(".ext_ram_heap"))); // Added this section to get heap to go to the ext memory.
 #else
 static unsigned char ucHeap[ configTOTAL_HEAP_SIZE ];
@@ -68,6 +68,11 @@
  * into a single larger block (and so will fragment memory).  See heap_4.c for
  * an equivalent that does combine adjacent blocks into single larger blocks.
  *
+ * vPortGetHeapStats() reports the lowest the free space has been, the largest
+ * free block and the number of free blocks.  When configUSE_HEAP_TRACE is 1 the
+ * last configHEAP_TRACE_LENGTH calls to pvPortMalloc() and vPortFree(), with
+ * the address they were called from, are kept for xPortGetHeapTraceEvent().
+ *
  * See heap_1.c, heap_3.c and heap_4.c for alternative implementations, and the
  * memory management pages of http://www.FreeRTOS.org for more information.
  */
@@ -86,13 +91,26 @@ task.h is included from an application file. */
 /* A few bytes might be lost to byte aligning the heap start address. */
 #define configADJUSTED_HEAP_SIZE	( configTOTAL_HEAP_SIZE - portBYTE_ALIGNMENT )
 
+/* The number of pvPortMalloc() and vPortFree() calls remembered. */
+#ifndef configHEAP_TRACE_LENGTH
+	#define configHEAP_TRACE_LENGTH	16
+#endif
+
 /* 
  * Initialises the heap structures before their first use.
  */
 static void prvHeapInit( void );
 
+#if ( configUSE_HEAP_TRACE == 1 )
+	/*
+	 * Adds an event to the trace ring buffer, overwriting the oldest.  Called
+	 * with the scheduler suspended.
+	 */
+	static void prvHeapTraceRecord( unsigned char ucEvent, void *pvAddress, size_t xSize, void *pvCaller );
+#endif
+
 /* Allocate the memory for the heap. */
-#if ( defined(portEXT_RAM) && !defined(portEXT_RAMFS) )
+#if ( defined(portEXT_RAM) && !defined(portEXT_RAMFS) && !defined(portEXT_RAM_TASK_BANKS) )
 static unsigned char ucHeap[ configTOTAL_HEAP_SIZE ]  __attribute__((section(".ext_ram_heap"))); // Added this section to get heap to go to the ext memory.
 #else
 static unsigned char ucHeap[ configTOTAL_HEAP_SIZE ];
@@ -117,6 +135,20 @@ static xBlockLink xStart, xEnd;
 fragmentation. */
 static size_t xFreeBytesRemaining = configADJUSTED_HEAP_SIZE;
 
+/* The lowest value xFreeBytesRemaining has had. */
+static size_t xMinimumEverFreeBytesRemaining = configADJUSTED_HEAP_SIZE;
+
+static portBASE_TYPE xHeapHasBeenInitialised = pdFALSE;
+
+#if ( configUSE_HEAP_TRACE == 1 )
+	/* The trace ring buffer.  uxHeapTraceNext is the slot the next event goes
+	in, and usHeapTraceSequence the number of events there have been. */
+	static xHeapTraceEvent xHeapTrace[ configHEAP_TRACE_LENGTH ];
+	static unsigned portBASE_TYPE uxHeapTraceNext = 0;
+	static unsigned short usHeapTraceSequence = 0;
+	static portBASE_TYPE xHeapTraceFull = pdFALSE;
+#endif
+
 /* STATIC FUNCTIONS ARE DEFINED AS MACROS TO MINIMIZE THE FUNCTION CALL DEPTH. */
 
 /*
@@ -148,9 +180,12 @@ size_t xBlockSize;																	\
 void *pvPortMalloc( size_t xWantedSize )
 {
 xBlockLink *pxBlock, *pxPreviousBlock, *pxNewBlockLink;
-static portBASE_TYPE xHeapHasBeenInitialised = pdFALSE;
 void *pvReturn = NULL;
 
+	#if ( configUSE_HEAP_TRACE == 1 )
+		size_t xRequestedSize = xWantedSize;
+	#endif
+
 	vTaskSuspendAll();
 	{
 		/* If this is the first call to malloc then the heap will require
@@ -216,8 +251,19 @@ void *pvReturn = NULL;
 				}
 
 				xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+				if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+				{
+					xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+				}
 			}
 		}
+
+		#if ( configUSE_HEAP_TRACE == 1 )
+		{
+			prvHeapTraceRecord( ( pvReturn != NULL ) ? heapTRACE_MALLOC : heapTRACE_FAILED, pvReturn, xRequestedSize, __builtin_return_address( 0 ) );
+		}
+		#endif
 	}
 	xTaskResumeAll();
 
@@ -255,6 +301,12 @@ xBlockLink *pxLink;
 			/* Add this block to the list of free blocks. */
 			prvInsertBlockIntoFreeList( ( ( xBlockLink * ) pxLink ) );
 			xFreeBytesRemaining += pxLink->xBlockSize;
+
+			#if ( configUSE_HEAP_TRACE == 1 )
+			{
+				prvHeapTraceRecord( heapTRACE_FREE, pv, pxLink->xBlockSize - heapSTRUCT_SIZE, __builtin_return_address( 0 ) );
+			}
+			#endif
 		}
 		xTaskResumeAll();
 	}
@@ -273,6 +325,116 @@ void vPortInitialiseBlocks( void )
 }
 /*-----------------------------------------------------------*/
 
+void vPortGetHeapStats( xHeapStatsType *pxHeapStats )
+{
+xBlockLink *pxBlock;
+size_t xLargest = 0, xBlocks = 0;
+
+	vTaskSuspendAll();
+	{
+		if( xHeapHasBeenInitialised == pdFALSE )
+		{
+			prvHeapInit();
+			xHeapHasBeenInitialised = pdTRUE;
+		}
+
+		/* The list is in size order, so the last block is the largest. */
+		for( pxBlock = xStart.pxNextFreeBlock; pxBlock != &xEnd; pxBlock = pxBlock->pxNextFreeBlock )
+		{
+			xBlocks++;
+			xLargest = pxBlock->xBlockSize;
+		}
+
+		pxHeapStats->xFreeBytes = xFreeBytesRemaining;
+		pxHeapStats->xMinimumEverFreeBytes = xMinimumEverFreeBytesRemaining;
+		pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+	}
+	xTaskResumeAll();
+
+	if( xLargest > heapSTRUCT_SIZE )
+	{
+		pxHeapStats->xLargestFreeBlock = xLargest - heapSTRUCT_SIZE;
+	}
+	else
+	{
+		pxHeapStats->xLargestFreeBlock = 0;
+	}
+
+	if( pxHeapStats->xFreeBytes != 0 )
+	{
+		pxHeapStats->ucFragmentation = ( unsigned char ) ( 100UL - ( ( ( unsigned long ) xLargest * 100UL ) / ( unsigned long ) pxHeapStats->xFreeBytes ) );
+	}
+	else
+	{
+		pxHeapStats->ucFragmentation = 0;
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_HEAP_TRACE == 1 )
+
+	static void prvHeapTraceRecord( unsigned char ucEvent, void *pvAddress, size_t xSize, void *pvCaller )
+	{
+	xHeapTraceEvent *pxEvent = &( xHeapTrace[ uxHeapTraceNext ] );
+
+		pxEvent->pvAddress = pvAddress;
+		pxEvent->pvCaller = pvCaller;
+		pxEvent->xSize = xSize;
+		pxEvent->xTime = xTaskGetTickCount();
+		pxEvent->usSequence = usHeapTraceSequence++;
+		pxEvent->ucEvent = ucEvent;
+
+		if( ++uxHeapTraceNext >= ( unsigned portBASE_TYPE ) configHEAP_TRACE_LENGTH )
+		{
+			uxHeapTraceNext = 0;
+			xHeapTraceFull = pdTRUE;
+		}
+	}
+
+#endif /* configUSE_HEAP_TRACE */
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xPortGetHeapTraceEvent( unsigned portBASE_TYPE uxIndex, xHeapTraceEvent *pxEvent )
+{
+portBASE_TYPE xReturn = pdFAIL;
+
+	#if ( configUSE_HEAP_TRACE == 1 )
+	{
+		vTaskSuspendAll();
+		{
+			/* uxIndex 0 is the oldest event still held. */
+			if( xHeapTraceFull != pdFALSE )
+			{
+				if( uxIndex < ( unsigned portBASE_TYPE ) configHEAP_TRACE_LENGTH )
+				{
+					uxIndex += uxHeapTraceNext;
+					if( uxIndex >= ( unsigned portBASE_TYPE ) configHEAP_TRACE_LENGTH )
+					{
+						uxIndex -= ( unsigned portBASE_TYPE ) configHEAP_TRACE_LENGTH;
+					}
+					*pxEvent = xHeapTrace[ uxIndex ];
+					xReturn = pdPASS;
+				}
+			}
+			else if( uxIndex < uxHeapTraceNext )
+			{
+				*pxEvent = xHeapTrace[ uxIndex ];
+				xReturn = pdPASS;
+			}
+		}
+		xTaskResumeAll();
+	}
+	#else
+	{
+		( void ) uxIndex;
+		( void ) pxEvent;
+	}
+	#endif /* configUSE_HEAP_TRACE */
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
 static void prvHeapInit( void )
 {
 xBlockLink *pxFirstFreeBlock;
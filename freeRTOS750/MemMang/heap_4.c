@@ -67,6 +67,11 @@
  * (coalescences) adjacent memory blocks as they are freed, and in so doing 
  * limits memory fragmentation.
  *
+ * vPortGetHeapStats() reports the lowest the free space has been, the largest
+ * free block and the number of free blocks.  When configUSE_HEAP_TRACE is 1 the
+ * last configHEAP_TRACE_LENGTH calls to pvPortMalloc() and vPortFree(), with
+ * the address they were called from, are kept for xPortGetHeapTraceEvent().
+ *
  * See heap_1.c, heap_2.c and heap_3.c for alternative implementations, and the 
  * memory management pages of http://www.FreeRTOS.org for more information.
  */
@@ -91,8 +96,13 @@ task.h is included from an application file. */
 /* A few bytes might be lost to byte aligning the heap start address. */
 #define heapADJUSTED_HEAP_SIZE	( configTOTAL_HEAP_SIZE - portBYTE_ALIGNMENT )
 
+/* The number of pvPortMalloc() and vPortFree() calls remembered. */
+#ifndef configHEAP_TRACE_LENGTH
+	#define configHEAP_TRACE_LENGTH	16
+#endif
+
 /* Allocate the memory for the heap. */
-#if ( defined(portEXT_RAM) && !defined(portEXT_RAMFS) )
+#if ( defined(portEXT_RAM) && !defined(portEXT_RAMFS) && !defined(portEXT_RAM_TASK_BANKS) )
 static unsigned char ucHeap[ configTOTAL_HEAP_SIZE ]  __attribute__((section(".ext_ram_heap"))); // Added this section to get heap to go to the ext memory.
 #else
 static unsigned char ucHeap[ configTOTAL_HEAP_SIZE ];
@@ -122,6 +132,14 @@ static void prvInsertBlockIntoFreeList( xBlockLink *pxBlockToInsert );
  */
 static void prvHeapInit( void );
 
+#if ( configUSE_HEAP_TRACE == 1 )
+	/*
+	 * Adds an event to the trace ring buffer, overwriting the oldest.  Called
+	 * with the scheduler suspended.
+	 */
+	static void prvHeapTraceRecord( unsigned char ucEvent, void *pvAddress, size_t xSize, void *pvCaller );
+#endif
+
 /*-----------------------------------------------------------*/
 
 /* The size of the structure placed at the beginning of each allocated memory
@@ -138,12 +156,24 @@ static xBlockLink xStart, *pxEnd = NULL;
 fragmentation. */
 static size_t xFreeBytesRemaining = ( ( size_t ) heapADJUSTED_HEAP_SIZE ) & ( ( size_t ) ~portBYTE_ALIGNMENT_MASK );
 
+/* The lowest value xFreeBytesRemaining has had. */
+static size_t xMinimumEverFreeBytesRemaining = ( ( size_t ) heapADJUSTED_HEAP_SIZE ) & ( ( size_t ) ~portBYTE_ALIGNMENT_MASK );
+
 /* Gets set to the top bit of an size_t type.  When this bit in the xBlockSize 
 member of an xBlockLink structure is set then the block belongs to the 
 application.  When the bit is free the block is still part of the free heap
 space. */
 static size_t xBlockAllocatedBit = 0;
 
+#if ( configUSE_HEAP_TRACE == 1 )
+	/* The trace ring buffer.  uxHeapTraceNext is the slot the next event goes
+	in, and usHeapTraceSequence the number of events there have been. */
+	static xHeapTraceEvent xHeapTrace[ configHEAP_TRACE_LENGTH ];
+	static unsigned portBASE_TYPE uxHeapTraceNext = 0;
+	static unsigned short usHeapTraceSequence = 0;
+	static portBASE_TYPE xHeapTraceFull = pdFALSE;
+#endif
+
 /*-----------------------------------------------------------*/
 
 void *pvPortMalloc( size_t xWantedSize )
@@ -151,6 +181,10 @@ void *pvPortMalloc( size_t xWantedSize )
 xBlockLink *pxBlock, *pxPreviousBlock, *pxNewBlockLink;
 void *pvReturn = NULL;
 
+	#if ( configUSE_HEAP_TRACE == 1 )
+		size_t xRequestedSize = xWantedSize;
+	#endif
+
 	vTaskSuspendAll();
 	{
 		/* If this is the first call to malloc then the heap will require
@@ -226,6 +260,11 @@ void *pvReturn = NULL;
 
 					xFreeBytesRemaining -= pxBlock->xBlockSize;
 
+					if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+					{
+						xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+					}
+
 					/* The block is being returned - it is allocated and owned
 					by the application and has no "next" block. */
 					pxBlock->xBlockSize |= xBlockAllocatedBit;
@@ -233,6 +272,12 @@ void *pvReturn = NULL;
 				}
 			}
 		}
+
+		#if ( configUSE_HEAP_TRACE == 1 )
+		{
+			prvHeapTraceRecord( ( pvReturn != NULL ) ? heapTRACE_MALLOC : heapTRACE_FAILED, pvReturn, xRequestedSize, __builtin_return_address( 0 ) );
+		}
+		#endif
 	}
 	xTaskResumeAll();
 
@@ -280,6 +325,13 @@ xBlockLink *pxLink;
 				{
 					/* Add this block to the list of free blocks. */
 					xFreeBytesRemaining += pxLink->xBlockSize;
+
+					#if ( configUSE_HEAP_TRACE == 1 )
+					{
+						prvHeapTraceRecord( heapTRACE_FREE, pv, pxLink->xBlockSize - heapSTRUCT_SIZE, __builtin_return_address( 0 ) );
+					}
+					#endif
+
 					prvInsertBlockIntoFreeList( ( ( xBlockLink * ) pxLink ) );
 				}
 				xTaskResumeAll();
@@ -301,6 +353,117 @@ void vPortInitialiseBlocks( void )
 }
 /*-----------------------------------------------------------*/
 
+void vPortGetHeapStats( xHeapStatsType *pxHeapStats )
+{
+xBlockLink *pxBlock;
+size_t xLargest = 0, xBlocks = 0;
+
+	vTaskSuspendAll();
+	{
+		if( pxEnd == NULL )
+		{
+			prvHeapInit();
+		}
+
+		for( pxBlock = xStart.pxNextFreeBlock; pxBlock != pxEnd; pxBlock = pxBlock->pxNextFreeBlock )
+		{
+			xBlocks++;
+			if( pxBlock->xBlockSize > xLargest )
+			{
+				xLargest = pxBlock->xBlockSize;
+			}
+		}
+
+		pxHeapStats->xFreeBytes = xFreeBytesRemaining;
+		pxHeapStats->xMinimumEverFreeBytes = xMinimumEverFreeBytesRemaining;
+		pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+	}
+	xTaskResumeAll();
+
+	if( xLargest > heapSTRUCT_SIZE )
+	{
+		pxHeapStats->xLargestFreeBlock = xLargest - heapSTRUCT_SIZE;
+	}
+	else
+	{
+		pxHeapStats->xLargestFreeBlock = 0;
+	}
+
+	if( pxHeapStats->xFreeBytes != 0 )
+	{
+		pxHeapStats->ucFragmentation = ( unsigned char ) ( 100UL - ( ( ( unsigned long ) xLargest * 100UL ) / ( unsigned long ) pxHeapStats->xFreeBytes ) );
+	}
+	else
+	{
+		pxHeapStats->ucFragmentation = 0;
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_HEAP_TRACE == 1 )
+
+	static void prvHeapTraceRecord( unsigned char ucEvent, void *pvAddress, size_t xSize, void *pvCaller )
+	{
+	xHeapTraceEvent *pxEvent = &( xHeapTrace[ uxHeapTraceNext ] );
+
+		pxEvent->pvAddress = pvAddress;
+		pxEvent->pvCaller = pvCaller;
+		pxEvent->xSize = xSize;
+		pxEvent->xTime = xTaskGetTickCount();
+		pxEvent->usSequence = usHeapTraceSequence++;
+		pxEvent->ucEvent = ucEvent;
+
+		if( ++uxHeapTraceNext >= ( unsigned portBASE_TYPE ) configHEAP_TRACE_LENGTH )
+		{
+			uxHeapTraceNext = 0;
+			xHeapTraceFull = pdTRUE;
+		}
+	}
+
+#endif /* configUSE_HEAP_TRACE */
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xPortGetHeapTraceEvent( unsigned portBASE_TYPE uxIndex, xHeapTraceEvent *pxEvent )
+{
+portBASE_TYPE xReturn = pdFAIL;
+
+	#if ( configUSE_HEAP_TRACE == 1 )
+	{
+		vTaskSuspendAll();
+		{
+			/* uxIndex 0 is the oldest event still held. */
+			if( xHeapTraceFull != pdFALSE )
+			{
+				if( uxIndex < ( unsigned portBASE_TYPE ) configHEAP_TRACE_LENGTH )
+				{
+					uxIndex += uxHeapTraceNext;
+					if( uxIndex >= ( unsigned portBASE_TYPE ) configHEAP_TRACE_LENGTH )
+					{
+						uxIndex -= ( unsigned portBASE_TYPE ) configHEAP_TRACE_LENGTH;
+					}
+					*pxEvent = xHeapTrace[ uxIndex ];
+					xReturn = pdPASS;
+				}
+			}
+			else if( uxIndex < uxHeapTraceNext )
+			{
+				*pxEvent = xHeapTrace[ uxIndex ];
+				xReturn = pdPASS;
+			}
+		}
+		xTaskResumeAll();
+	}
+	#else
+	{
+		( void ) uxIndex;
+		( void ) pxEvent;
+	}
+	#endif /* configUSE_HEAP_TRACE */
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
 static void prvHeapInit( void )
 {
 xBlockLink *pxFirstFreeBlock;
@@ -331,6 +494,7 @@ unsigned char *pucHeapEnd, *pucAlignedHeap;
 
 	/* The heap now contains pxEnd. */
 	xFreeBytesRemaining -= heapSTRUCT_SIZE;
+	xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
 
 	/* Work out the position of the top bit in a size_t variable. */
 	xBlockAllocatedBit = ( ( size_t ) 1 ) << ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 1 );
@@ -0,0 +1,735 @@
+/*
+    FreeRTOS V7.5.0 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * An implementation of pvPortMalloc() and vPortFree() that keeps a separate
+ * free list for each of a number of small block sizes (size classes), in front
+ * of a heap_4.c style first fit heap that coalesces adjacent free blocks.
+ *
+ * A freed block that is one of the class sizes is pushed onto the free list of
+ * its class rather than merged back into the heap, and the next request that
+ * rounds up to the same class pops it again.  Both take a fixed time, so once
+ * the classes in use have blocks on their lists (from earlier frees, or put
+ * there up front by xPortHeapPrimeClass()) creating a task or a queue always
+ * takes the same time.  Requests larger than the largest class, and requests
+ * for a class with an empty list, are served by the coalescing heap.
+ *
+ * If the coalescing heap cannot meet a request, the blocks on the class free
+ * lists are given back to it and the request is tried again, so memory parked
+ * on a class list is never lost to a larger allocation.
+ *
+ * Class block sizes, which include the block header, are multiples of
+ * configHEAP_CLASS_GRANULE bytes up to configHEAP_CLASS_COUNT granules.
+ *
+ * vPortGetHeapStats() reports the free space and fragmentation, and
+ * uxPortGetHeapClassStats() the use and high-water mark of each class.
+ *
+ * See heap_1.c, heap_2.c, heap_3.c and heap_4.c for alternative
+ * implementations.
+ */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* The size classes.  With the defaults the classes are blocks of 8, 16, 24 ...
+64 bytes, which covers TCBs, queue structures and small queue storage areas. */
+#ifndef configHEAP_CLASS_GRANULE
+	#define configHEAP_CLASS_GRANULE	8
+#endif
+
+#ifndef configHEAP_CLASS_COUNT
+	#define configHEAP_CLASS_COUNT		8
+#endif
+
+#if ( ( configHEAP_CLASS_GRANULE % portBYTE_ALIGNMENT ) != 0 )
+	#error configHEAP_CLASS_GRANULE must be a multiple of portBYTE_ALIGNMENT
+#endif
+
+#define heapLARGEST_CLASS_SIZE	( ( size_t ) ( configHEAP_CLASS_GRANULE * configHEAP_CLASS_COUNT ) )
+
+/* Block sizes must not get too small. */
+#define heapMINIMUM_BLOCK_SIZE	( ( size_t ) ( heapSTRUCT_SIZE * 2 ) )
+
+/* Assumes 8bit bytes! */
+#define heapBITS_PER_BYTE		( ( size_t ) 8 )
+
+/* A few bytes might be lost to byte aligning the heap start address. */
+#define heapADJUSTED_HEAP_SIZE	( configTOTAL_HEAP_SIZE - portBYTE_ALIGNMENT )
+
+/* Allocate the memory for the heap. */
+#if ( defined(portEXT_RAM) && !defined(portEXT_RAMFS) && !defined(portEXT_RAM_TASK_BANKS) )
+static unsigned char ucHeap[ configTOTAL_HEAP_SIZE ]  __attribute__((section(".ext_ram_heap"))); // Added this section to get heap to go to the ext memory.
+#else
+static unsigned char ucHeap[ configTOTAL_HEAP_SIZE ];
+#endif
+
+/* Define the linked list structure.  This is used to link free blocks in order
+of their memory address in the coalescing heap, and free blocks of the same
+size class in last in, first out order. */
+typedef struct A_BLOCK_LINK
+{
+	struct A_BLOCK_LINK *pxNextFreeBlock;	/*<< The next free block in the list. */
+	size_t xBlockSize;						/*<< The size of the free block. */
+} xBlockLink;
+
+/* The free list and usage counts of one size class. */
+typedef struct A_SIZE_CLASS
+{
+	xBlockLink *pxFreeList;					/*<< The free blocks of this class. */
+	unsigned short usInUse;					/*<< The number of blocks of this class allocated to the application. */
+	unsigned short usHighWaterMark;			/*<< The highest value usInUse has had. */
+	unsigned short usFree;					/*<< The number of blocks on pxFreeList. */
+} xSizeClass;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Inserts a block of memory that is being freed into the correct position in
+ * the list of free memory blocks.  The block being freed will be merged with
+ * the block in front it and/or the block behind it if the memory blocks are
+ * adjacent to each other.
+ */
+static void prvInsertBlockIntoFreeList( xBlockLink *pxBlockToInsert );
+
+/*
+ * Takes a block of at least xWantedSize bytes, including the header, from the
+ * coalescing heap, splitting it if it is larger than necessary.  Returns NULL
+ * if there is no block large enough.
+ */
+static xBlockLink *prvAllocateFromHeap( size_t xWantedSize );
+
+/*
+ * Gives every block on the class free lists back to the coalescing heap.
+ * Returns pdTRUE if there were any.
+ */
+static portBASE_TYPE prvReleaseClassBlocks( void );
+
+/*
+ * Returns the class that a block of xBlockSize bytes belongs to, or NULL if
+ * the block is not one of the class sizes.
+ */
+static xSizeClass *prvClassOfBlock( size_t xBlockSize );
+
+/*
+ * Rounds a request up to the block size that will be allocated for it,
+ * including the header and any alignment or class padding.  Returns 0 if the
+ * request is 0 or too large.
+ */
+static size_t prvBlockSizeForRequest( size_t xWantedSize );
+
+/*
+ * Called automatically to setup the required heap structures the first time
+ * pvPortMalloc() is called.
+ */
+static void prvHeapInit( void );
+
+/*-----------------------------------------------------------*/
+
+/* The size of the structure placed at the beginning of each allocated memory
+block must by correctly byte aligned. */
+static const unsigned short heapSTRUCT_SIZE	= ( ( sizeof ( xBlockLink ) + ( portBYTE_ALIGNMENT - 1 ) ) & ~portBYTE_ALIGNMENT_MASK );
+
+/* Ensure the pxEnd pointer will end up on the correct byte alignment. */
+static const size_t xTotalHeapSize = ( ( size_t ) heapADJUSTED_HEAP_SIZE ) & ( ( size_t ) ~portBYTE_ALIGNMENT_MASK );
+
+/* Create a couple of list links to mark the start and end of the list. */
+static xBlockLink xStart, *pxEnd = NULL;
+
+/* The size classes. */
+static xSizeClass xClasses[ configHEAP_CLASS_COUNT ];
+
+/* Keeps track of the number of free bytes remaining, including the blocks on
+the class free lists, but says nothing about fragmentation. */
+static size_t xFreeBytesRemaining = ( ( size_t ) heapADJUSTED_HEAP_SIZE ) & ( ( size_t ) ~portBYTE_ALIGNMENT_MASK );
+
+/* The lowest value xFreeBytesRemaining has had. */
+static size_t xMinimumEverFreeBytesRemaining = ( ( size_t ) heapADJUSTED_HEAP_SIZE ) & ( ( size_t ) ~portBYTE_ALIGNMENT_MASK );
+
+/* Gets set to the top bit of an size_t type.  When this bit in the xBlockSize
+member of an xBlockLink structure is set then the block belongs to the
+application.  When the bit is free the block is still part of the free heap
+space. */
+static size_t xBlockAllocatedBit = 0;
+
+/*-----------------------------------------------------------*/
+
+void *pvPortMalloc( size_t xWantedSize )
+{
+xBlockLink *pxBlock = NULL;
+xSizeClass *pxClass;
+void *pvReturn = NULL;
+
+	vTaskSuspendAll();
+	{
+		/* If this is the first call to malloc then the heap will require
+		initialisation to setup the list of free blocks. */
+		if( pxEnd == NULL )
+		{
+			prvHeapInit();
+		}
+
+		xWantedSize = prvBlockSizeForRequest( xWantedSize );
+
+		if( ( xWantedSize > 0 ) && ( xWantedSize <= xFreeBytesRemaining ) )
+		{
+			/* A class request is met from the free list of its class if
+			possible.  This is the fixed time path. */
+			pxClass = prvClassOfBlock( xWantedSize );
+			if( ( pxClass != NULL ) && ( pxClass->pxFreeList != NULL ) )
+			{
+				pxBlock = pxClass->pxFreeList;
+				pxClass->pxFreeList = pxBlock->pxNextFreeBlock;
+				pxClass->usFree--;
+			}
+			else
+			{
+				pxBlock = prvAllocateFromHeap( xWantedSize );
+
+				if( ( pxBlock == NULL ) && ( prvReleaseClassBlocks() != pdFALSE ) )
+				{
+					/* The class free lists have been coalesced back into the
+					heap, so there may now be a block large enough. */
+					pxBlock = prvAllocateFromHeap( xWantedSize );
+				}
+
+				/* A block that could not be split exactly is not a class
+				block, even if the request was a class request. */
+				if( pxBlock != NULL )
+				{
+					pxClass = prvClassOfBlock( pxBlock->xBlockSize );
+				}
+			}
+
+			if( pxBlock != NULL )
+			{
+				if( pxClass != NULL )
+				{
+					pxClass->usInUse++;
+					if( pxClass->usInUse > pxClass->usHighWaterMark )
+					{
+						pxClass->usHighWaterMark = pxClass->usInUse;
+					}
+				}
+
+				xFreeBytesRemaining -= pxBlock->xBlockSize;
+				if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+				{
+					xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+				}
+
+				/* The block is being returned - it is allocated and owned
+				by the application and has no "next" block. */
+				pxBlock->xBlockSize |= xBlockAllocatedBit;
+				pxBlock->pxNextFreeBlock = NULL;
+
+				/* Return the memory space pointed to - jumping over the
+				xBlockLink structure at its start. */
+				pvReturn = ( void * ) ( ( ( unsigned char * ) pxBlock ) + heapSTRUCT_SIZE );
+			}
+		}
+	}
+	xTaskResumeAll();
+
+	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+	{
+		if( pvReturn == NULL )
+		{
+			extern void vApplicationMallocFailedHook( void );
+			vApplicationMallocFailedHook();
+		}
+	}
+	#endif
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void *pv )
+{
+unsigned char *puc = ( unsigned char * ) pv;
+xBlockLink *pxLink;
+xSizeClass *pxClass;
+
+	if( pv != NULL )
+	{
+		/* The memory being freed will have an xBlockLink structure immediately
+		before it. */
+		puc -= heapSTRUCT_SIZE;
+
+		/* This casting is to keep the compiler from issuing warnings. */
+		pxLink = ( void * ) puc;
+
+		/* Check the block is actually allocated. */
+		configASSERT( ( pxLink->xBlockSize & xBlockAllocatedBit ) != 0 );
+		configASSERT( pxLink->pxNextFreeBlock == NULL );
+
+		if( ( pxLink->xBlockSize & xBlockAllocatedBit ) != 0 )
+		{
+			if( pxLink->pxNextFreeBlock == NULL )
+			{
+				/* The block is being returned to the heap - it is no longer
+				allocated. */
+				pxLink->xBlockSize &= ~xBlockAllocatedBit;
+
+				vTaskSuspendAll();
+				{
+					xFreeBytesRemaining += pxLink->xBlockSize;
+
+					/* A class block goes onto the free list of its class,
+					anything else back into the coalescing heap. */
+					pxClass = prvClassOfBlock( pxLink->xBlockSize );
+					if( pxClass != NULL )
+					{
+						pxLink->pxNextFreeBlock = pxClass->pxFreeList;
+						pxClass->pxFreeList = pxLink;
+						pxClass->usFree++;
+						pxClass->usInUse--;
+					}
+					else
+					{
+						prvInsertBlockIntoFreeList( pxLink );
+					}
+				}
+				xTaskResumeAll();
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+	return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+	/* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortHeapPrimeClass( size_t xWantedSize, size_t xCount )
+{
+xBlockLink *pxBlock;
+xSizeClass *pxClass;
+size_t xPrimed = 0;
+
+	vTaskSuspendAll();
+	{
+		if( pxEnd == NULL )
+		{
+			prvHeapInit();
+		}
+
+		xWantedSize = prvBlockSizeForRequest( xWantedSize );
+		pxClass = prvClassOfBlock( xWantedSize );
+
+		if( pxClass != NULL )
+		{
+			while( xPrimed < xCount )
+			{
+				pxBlock = prvAllocateFromHeap( xWantedSize );
+				if( pxBlock == NULL )
+				{
+					break;
+				}
+
+				if( pxBlock->xBlockSize != xWantedSize )
+				{
+					/* The last free block was too small to split, so the heap
+					is as good as full. */
+					prvInsertBlockIntoFreeList( pxBlock );
+					break;
+				}
+
+				/* The bytes stay free, they just move from the heap to the
+				class free list. */
+				pxBlock->pxNextFreeBlock = pxClass->pxFreeList;
+				pxClass->pxFreeList = pxBlock;
+				pxClass->usFree++;
+				xPrimed++;
+			}
+		}
+	}
+	xTaskResumeAll();
+
+	return xPrimed;
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( xHeapStatsType *pxHeapStats )
+{
+xBlockLink *pxBlock;
+size_t xLargest = 0, xBlocks = 0;
+unsigned portBASE_TYPE uxClass;
+
+	vTaskSuspendAll();
+	{
+		if( pxEnd == NULL )
+		{
+			prvHeapInit();
+		}
+
+		for( pxBlock = xStart.pxNextFreeBlock; pxBlock != pxEnd; pxBlock = pxBlock->pxNextFreeBlock )
+		{
+			xBlocks++;
+			if( pxBlock->xBlockSize > xLargest )
+			{
+				xLargest = pxBlock->xBlockSize;
+			}
+		}
+
+		/* Blocks on the class free lists are free, but are not coalesced. */
+		for( uxClass = 0; uxClass < ( unsigned portBASE_TYPE ) configHEAP_CLASS_COUNT; uxClass++ )
+		{
+			if( xClasses[ uxClass ].usFree != 0 )
+			{
+				xBlocks += xClasses[ uxClass ].usFree;
+				if( ( ( uxClass + 1 ) * configHEAP_CLASS_GRANULE ) > xLargest )
+				{
+					xLargest = ( uxClass + 1 ) * configHEAP_CLASS_GRANULE;
+				}
+			}
+		}
+
+		pxHeapStats->xFreeBytes = xFreeBytesRemaining;
+		pxHeapStats->xMinimumEverFreeBytes = xMinimumEverFreeBytesRemaining;
+		pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+	}
+	xTaskResumeAll();
+
+	if( xLargest > heapSTRUCT_SIZE )
+	{
+		pxHeapStats->xLargestFreeBlock = xLargest - heapSTRUCT_SIZE;
+	}
+	else
+	{
+		pxHeapStats->xLargestFreeBlock = 0;
+	}
+
+	if( pxHeapStats->xFreeBytes != 0 )
+	{
+		pxHeapStats->ucFragmentation = ( unsigned char ) ( 100UL - ( ( ( unsigned long ) xLargest * 100UL ) / ( unsigned long ) pxHeapStats->xFreeBytes ) );
+	}
+	else
+	{
+		pxHeapStats->ucFragmentation = 0;
+	}
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xPortGetHeapTraceEvent( unsigned portBASE_TYPE uxIndex, xHeapTraceEvent *pxEvent )
+{
+	/* Only heap_2.c and heap_4.c keep a trace of calls. */
+	( void ) uxIndex;
+	( void ) pxEvent;
+
+	return pdFAIL;
+}
+/*-----------------------------------------------------------*/
+
+unsigned portBASE_TYPE uxPortGetHeapClassStats( xHeapClassStatsType *pxClassStats, unsigned portBASE_TYPE uxArraySize )
+{
+unsigned portBASE_TYPE uxClass;
+
+	if( uxArraySize > ( unsigned portBASE_TYPE ) configHEAP_CLASS_COUNT )
+	{
+		uxArraySize = ( unsigned portBASE_TYPE ) configHEAP_CLASS_COUNT;
+	}
+
+	vTaskSuspendAll();
+	{
+		for( uxClass = 0; uxClass < uxArraySize; uxClass++ )
+		{
+			/* A class smaller than the header can never be used. */
+			if( ( ( uxClass + 1 ) * configHEAP_CLASS_GRANULE ) > heapSTRUCT_SIZE )
+			{
+				pxClassStats[ uxClass ].xRequestSize = ( ( uxClass + 1 ) * configHEAP_CLASS_GRANULE ) - heapSTRUCT_SIZE;
+			}
+			else
+			{
+				pxClassStats[ uxClass ].xRequestSize = 0;
+			}
+			pxClassStats[ uxClass ].usInUse = xClasses[ uxClass ].usInUse;
+			pxClassStats[ uxClass ].usHighWaterMark = xClasses[ uxClass ].usHighWaterMark;
+			pxClassStats[ uxClass ].usFree = xClasses[ uxClass ].usFree;
+		}
+	}
+	xTaskResumeAll();
+
+	return uxArraySize;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvBlockSizeForRequest( size_t xWantedSize )
+{
+	/* Check the requested block size is not so large that the top bit is
+	set.  The top bit of the block size member of the xBlockLink structure
+	is used to determine who owns the block - the application or the
+	kernel, so it must be free. */
+	if( ( xWantedSize == 0 ) || ( ( xWantedSize & xBlockAllocatedBit ) != 0 ) )
+	{
+		return 0;
+	}
+
+	/* The wanted size is increased so it can contain a xBlockLink
+	structure in addition to the requested amount of bytes. */
+	xWantedSize += heapSTRUCT_SIZE;
+
+	if( xWantedSize <= heapLARGEST_CLASS_SIZE )
+	{
+		/* Round up to the size of the class.  The granule is a multiple of
+		the alignment, so the result is aligned too. */
+		xWantedSize = ( ( xWantedSize + ( configHEAP_CLASS_GRANULE - 1 ) ) / configHEAP_CLASS_GRANULE ) * configHEAP_CLASS_GRANULE;
+	}
+	else if( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) != 0x00 )
+	{
+		/* Byte alignment required. */
+		xWantedSize += ( portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK ) );
+	}
+
+	return xWantedSize;
+}
+/*-----------------------------------------------------------*/
+
+static xSizeClass *prvClassOfBlock( size_t xBlockSize )
+{
+	if( ( xBlockSize <= heapLARGEST_CLASS_SIZE ) && ( ( xBlockSize % configHEAP_CLASS_GRANULE ) == 0 ) )
+	{
+		return &( xClasses[ ( xBlockSize / configHEAP_CLASS_GRANULE ) - 1 ] );
+	}
+
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static xBlockLink *prvAllocateFromHeap( size_t xWantedSize )
+{
+xBlockLink *pxBlock, *pxPreviousBlock, *pxNewBlockLink;
+
+	/* Traverse the list from the start	(lowest address) block until
+	one	of adequate size is found. */
+	pxPreviousBlock = &xStart;
+	pxBlock = xStart.pxNextFreeBlock;
+	while( ( pxBlock->xBlockSize < xWantedSize ) && ( pxBlock->pxNextFreeBlock != NULL ) )
+	{
+		pxPreviousBlock = pxBlock;
+		pxBlock = pxBlock->pxNextFreeBlock;
+	}
+
+	/* If the end marker was reached then a block of adequate size
+	was	not found. */
+	if( pxBlock == pxEnd )
+	{
+		return NULL;
+	}
+
+	/* This block is being returned for use so must be taken out
+	of the list of free blocks. */
+	pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+
+	/* If the block is larger than required it can be split into
+	two. */
+	if( ( pxBlock->xBlockSize - xWantedSize ) > heapMINIMUM_BLOCK_SIZE )
+	{
+		/* This block is to be split into two.  Create a new
+		block following the number of bytes requested. The void
+		cast is used to prevent byte alignment warnings from the
+		compiler. */
+		pxNewBlockLink = ( void * ) ( ( ( unsigned char * ) pxBlock ) + xWantedSize );
+
+		/* Calculate the sizes of two blocks split from the
+		single block. */
+		pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+		pxBlock->xBlockSize = xWantedSize;
+
+		/* Insert the new block into the list of free blocks. */
+		prvInsertBlockIntoFreeList( ( pxNewBlockLink ) );
+	}
+
+	return pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvReleaseClassBlocks( void )
+{
+xBlockLink *pxBlock;
+unsigned portBASE_TYPE uxClass;
+portBASE_TYPE xReleased = pdFALSE;
+
+	for( uxClass = 0; uxClass < ( unsigned portBASE_TYPE ) configHEAP_CLASS_COUNT; uxClass++ )
+	{
+		while( xClasses[ uxClass ].pxFreeList != NULL )
+		{
+			pxBlock = xClasses[ uxClass ].pxFreeList;
+			xClasses[ uxClass ].pxFreeList = pxBlock->pxNextFreeBlock;
+			prvInsertBlockIntoFreeList( pxBlock );
+			xReleased = pdTRUE;
+		}
+
+		xClasses[ uxClass ].usFree = 0;
+	}
+
+	return xReleased;
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapInit( void )
+{
+xBlockLink *pxFirstFreeBlock;
+unsigned char *pucHeapEnd, *pucAlignedHeap;
+
+	/* Ensure the heap starts on a correctly aligned boundary. */
+	pucAlignedHeap = ( unsigned char * ) ( ( ( portPOINTER_SIZE_TYPE ) &ucHeap[ portBYTE_ALIGNMENT ] ) & ( ( portPOINTER_SIZE_TYPE ) ~portBYTE_ALIGNMENT_MASK ) );
+
+	/* xStart is used to hold a pointer to the first item in the list of free
+	blocks.  The void cast is used to prevent compiler warnings. */
+	xStart.pxNextFreeBlock = ( void * ) pucAlignedHeap;
+	xStart.xBlockSize = ( size_t ) 0;
+
+	/* pxEnd is used to mark the end of the list of free blocks and is inserted
+	at the end of the heap space. */
+	pucHeapEnd = pucAlignedHeap + xTotalHeapSize;
+	pucHeapEnd -= heapSTRUCT_SIZE;
+	pxEnd = ( void * ) pucHeapEnd;
+	configASSERT( ( ( ( unsigned long ) pxEnd ) & ( ( unsigned long ) portBYTE_ALIGNMENT_MASK ) ) == 0UL );
+	pxEnd->xBlockSize = 0;
+	pxEnd->pxNextFreeBlock = NULL;
+
+	/* To start with there is a single free block that is sized to take up the
+	entire heap space, minus the space taken by pxEnd. */
+	pxFirstFreeBlock = ( void * ) pucAlignedHeap;
+	pxFirstFreeBlock->xBlockSize = xTotalHeapSize - heapSTRUCT_SIZE;
+	pxFirstFreeBlock->pxNextFreeBlock = pxEnd;
+
+	/* The heap now contains pxEnd. */
+	xFreeBytesRemaining -= heapSTRUCT_SIZE;
+	xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+
+	/* Work out the position of the top bit in a size_t variable. */
+	xBlockAllocatedBit = ( ( size_t ) 1 ) << ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 1 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertBlockIntoFreeList( xBlockLink *pxBlockToInsert )
+{
+xBlockLink *pxIterator;
+unsigned char *puc;
+
+	/* Iterate through the list until a block is found that has a higher address
+	than the block being inserted. */
+	for( pxIterator = &xStart; pxIterator->pxNextFreeBlock < pxBlockToInsert; pxIterator = pxIterator->pxNextFreeBlock )
+	{
+		/* Nothing to do here, just iterate to the right position. */
+	}
+
+	/* Do the block being inserted, and the block it is being inserted after
+	make a contiguous block of memory? */
+	puc = ( unsigned char * ) pxIterator;
+	if( ( puc + pxIterator->xBlockSize ) == ( unsigned char * ) pxBlockToInsert )
+	{
+		pxIterator->xBlockSize += pxBlockToInsert->xBlockSize;
+		pxBlockToInsert = pxIterator;
+	}
+
+	/* Do the block being inserted, and the block it is being inserted before
+	make a contiguous block of memory? */
+	puc = ( unsigned char * ) pxBlockToInsert;
+	if( ( puc + pxBlockToInsert->xBlockSize ) == ( unsigned char * ) pxIterator->pxNextFreeBlock )
+	{
+		if( pxIterator->pxNextFreeBlock != pxEnd )
+		{
+			/* Form one big block from the two blocks. */
+			pxBlockToInsert->xBlockSize += pxIterator->pxNextFreeBlock->xBlockSize;
+			pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock->pxNextFreeBlock;
+		}
+		else
+		{
+			pxBlockToInsert->pxNextFreeBlock = pxEnd;
+		}
+	}
+	else
+	{
+		pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock;
+	}
+
+	/* If the block being inserted plugged a gap, so was merged with the block
+	before and the block after, then it's pxNextFreeBlock pointer will have
+	already been set, and should not be set here as that would make it point
+	to itself. */
+	if( pxIterator != pxBlockToInsert )
+	{
+		pxIterator->pxNextFreeBlock = pxBlockToInsert;
+	}
+}
+
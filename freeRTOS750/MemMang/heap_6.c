@@ -0,0 +1,688 @@
+/*
+    FreeRTOS V7.5.0 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * An implementation of pvPortMalloc() and vPortFree() that spans several
+ * separate regions of memory, such as the internal SRAM and the XRAM of a
+ * Mega fitted with a QuadRAM or MegaRAM.  Each region is a heap_4.c style
+ * first fit heap that coalesces adjacent free blocks.
+ *
+ * Regions are listed fastest first.  A request of up to
+ * configHEAP_REGION_THRESHOLD bytes, such as a TCB, a task stack or a queue,
+ * tries the regions in that order, so it goes in internal SRAM while there is
+ * room.  A larger request tries them in the opposite order, so big buffers go
+ * in XRAM and leave the fast memory for the small, frequently used structures.
+ * Either way a request falls back to the other regions before failing.
+ * pvPortMallocRegion() allocates from one given region only, for memory that
+ * must (or must not) be behind the external memory interface.
+ *
+ * By default the regions are an array of configSRAM_HEAP_SIZE bytes in
+ * internal SRAM, and an array of configTOTAL_HEAP_SIZE bytes in the
+ * .ext_ram_heap section, which the linker places in XRAM (see ext_ram.h).
+ * Without XRAM there is one region of configTOTAL_HEAP_SIZE bytes.  Other
+ * layouts are set up by calling vPortDefineHeapRegions() before the first
+ * pvPortMalloc().
+ *
+ * See heap_1.c, heap_2.c, heap_3.c, heap_4.c and heap_5.c for alternative
+ * implementations.
+ */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* The most regions vPortDefineHeapRegions() can be given. */
+#ifndef configHEAP_MAX_REGIONS
+	#define configHEAP_MAX_REGIONS		2
+#endif
+
+/* Requests up to this size are placed in the fastest region with room, larger
+ones in the slowest. */
+#ifndef configHEAP_REGION_THRESHOLD
+	#define configHEAP_REGION_THRESHOLD	256
+#endif
+
+/* The size of the internal SRAM region, when there is an XRAM region too. */
+#ifndef configSRAM_HEAP_SIZE
+	#define configSRAM_HEAP_SIZE		0x1000
+#endif
+
+/* Block sizes must not get too small. */
+#define heapMINIMUM_BLOCK_SIZE	( ( size_t ) ( heapSTRUCT_SIZE * 2 ) )
+
+/* Assumes 8bit bytes! */
+#define heapBITS_PER_BYTE		( ( size_t ) 8 )
+
+/* Allocate the memory for the default regions. */
+#if ( defined(portEXT_RAM) && !defined(portEXT_RAMFS) && !defined(portEXT_RAM_TASK_BANKS) )
+static unsigned char ucSRAMHeap[ configSRAM_HEAP_SIZE ];
+static unsigned char ucHeap[ configTOTAL_HEAP_SIZE ]  __attribute__((section(".ext_ram_heap"))); // Added this section to get heap to go to the ext memory.
+#else
+static unsigned char ucHeap[ configTOTAL_HEAP_SIZE ];
+#endif
+
+/* Define the linked list structure.  This is used to link free blocks in order
+of their memory address. */
+typedef struct A_BLOCK_LINK
+{
+	struct A_BLOCK_LINK *pxNextFreeBlock;	/*<< The next free block in the list. */
+	size_t xBlockSize;						/*<< The size of the free block. */
+} xBlockLink;
+
+/* The free list and counters of one region. */
+typedef struct A_HEAP_REGION
+{
+	xBlockLink xStart;						/*<< The head of the free list of the region. */
+	xBlockLink *pxEnd;						/*<< The end marker, at the top of the region. */
+	unsigned char *pucAlignedStart;			/*<< The first byte of the region that is used. */
+	size_t xFreeBytesRemaining;				/*<< The number of free bytes in the region. */
+} xRegionState;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Inserts a block of memory that is being freed into the correct position in
+ * the list of free memory blocks of pxRegion.  The block being freed will be
+ * merged with the block in front it and/or the block behind it if the memory
+ * blocks are adjacent to each other.
+ */
+static void prvInsertBlockIntoFreeList( xRegionState *pxRegion, xBlockLink *pxBlockToInsert );
+
+/*
+ * Takes a block of xWantedSize bytes, including the header, from pxRegion.
+ * Returns NULL if the region has no block large enough.
+ */
+static xBlockLink *prvAllocateFromRegion( xRegionState *pxRegion, size_t xWantedSize );
+
+/*
+ * Sets up the free list of one region.
+ */
+static void prvInitialiseRegion( xRegionState *pxRegion, unsigned char *pucStartAddress, size_t xSizeInBytes );
+
+/*
+ * Called automatically to setup the default regions the first time
+ * pvPortMalloc() is called, if vPortDefineHeapRegions() has not been called.
+ */
+static void prvHeapInit( void );
+
+/*
+ * Rounds a request up to the block size that will be allocated for it,
+ * including the header and alignment.  Returns 0 if the request is 0 or too
+ * large.
+ */
+static size_t prvBlockSizeForRequest( size_t xWantedSize );
+
+/*
+ * Records a newly allocated block against the heap totals, marks it as
+ * allocated and returns the address the application can use.
+ */
+static void *prvBlockAllocated( xRegionState *pxRegion, xBlockLink *pxBlock );
+
+/*-----------------------------------------------------------*/
+
+/* The size of the structure placed at the beginning of each allocated memory
+block must by correctly byte aligned. */
+static const unsigned short heapSTRUCT_SIZE	= ( ( sizeof ( xBlockLink ) + ( portBYTE_ALIGNMENT - 1 ) ) & ~portBYTE_ALIGNMENT_MASK );
+
+/* The regions, fastest first. */
+static xRegionState xRegions[ configHEAP_MAX_REGIONS ];
+static unsigned portBASE_TYPE uxRegionCount = 0;
+
+/* Keeps track of the number of free bytes remaining in all the regions, but
+says nothing about fragmentation. */
+static size_t xFreeBytesRemaining = 0;
+
+/* The lowest value xFreeBytesRemaining has had. */
+static size_t xMinimumEverFreeBytesRemaining = 0;
+
+/* Gets set to the top bit of an size_t type.  When this bit in the xBlockSize
+member of an xBlockLink structure is set then the block belongs to the
+application.  When the bit is free the block is still part of the free heap
+space. */
+static size_t xBlockAllocatedBit = 0;
+
+/*-----------------------------------------------------------*/
+
+void *pvPortMalloc( size_t xWantedSize )
+{
+xBlockLink *pxBlock = NULL;
+xRegionState *pxRegion = NULL;
+unsigned portBASE_TYPE uxRegion;
+void *pvReturn = NULL;
+
+	vTaskSuspendAll();
+	{
+		/* If this is the first call to malloc then the heap will require
+		initialisation to setup the list of free blocks. */
+		if( uxRegionCount == 0 )
+		{
+			prvHeapInit();
+		}
+
+		if( xWantedSize <= ( size_t ) configHEAP_REGION_THRESHOLD )
+		{
+			xWantedSize = prvBlockSizeForRequest( xWantedSize );
+
+			/* Small blocks fill the regions from the fastest. */
+			for( uxRegion = 0; ( uxRegion < uxRegionCount ) && ( xWantedSize > 0 ); uxRegion++ )
+			{
+				pxRegion = &( xRegions[ uxRegion ] );
+				pxBlock = prvAllocateFromRegion( pxRegion, xWantedSize );
+				if( pxBlock != NULL )
+				{
+					break;
+				}
+			}
+		}
+		else
+		{
+			xWantedSize = prvBlockSizeForRequest( xWantedSize );
+
+			/* Large blocks fill the regions from the slowest. */
+			for( uxRegion = uxRegionCount; ( uxRegion > 0 ) && ( xWantedSize > 0 ); uxRegion-- )
+			{
+				pxRegion = &( xRegions[ uxRegion - 1 ] );
+				pxBlock = prvAllocateFromRegion( pxRegion, xWantedSize );
+				if( pxBlock != NULL )
+				{
+					break;
+				}
+			}
+		}
+
+		if( pxBlock != NULL )
+		{
+			pvReturn = prvBlockAllocated( pxRegion, pxBlock );
+		}
+	}
+	xTaskResumeAll();
+
+	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+	{
+		if( pvReturn == NULL )
+		{
+			extern void vApplicationMallocFailedHook( void );
+			vApplicationMallocFailedHook();
+		}
+	}
+	#endif
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void *pvPortMallocRegion( size_t xWantedSize, unsigned portBASE_TYPE uxRegion )
+{
+xBlockLink *pxBlock = NULL;
+void *pvReturn = NULL;
+
+	vTaskSuspendAll();
+	{
+		if( uxRegionCount == 0 )
+		{
+			prvHeapInit();
+		}
+
+		xWantedSize = prvBlockSizeForRequest( xWantedSize );
+
+		if( ( uxRegion < uxRegionCount ) && ( xWantedSize > 0 ) )
+		{
+			pxBlock = prvAllocateFromRegion( &( xRegions[ uxRegion ] ), xWantedSize );
+			if( pxBlock != NULL )
+			{
+				pvReturn = prvBlockAllocated( &( xRegions[ uxRegion ] ), pxBlock );
+			}
+		}
+	}
+	xTaskResumeAll();
+
+	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+	{
+		if( pvReturn == NULL )
+		{
+			extern void vApplicationMallocFailedHook( void );
+			vApplicationMallocFailedHook();
+		}
+	}
+	#endif
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void *pv )
+{
+unsigned char *puc = ( unsigned char * ) pv;
+xBlockLink *pxLink;
+unsigned portBASE_TYPE uxRegion;
+
+	if( pv != NULL )
+	{
+		/* The memory being freed will have an xBlockLink structure immediately
+		before it. */
+		puc -= heapSTRUCT_SIZE;
+
+		/* This casting is to keep the compiler from issuing warnings. */
+		pxLink = ( void * ) puc;
+
+		/* Check the block is actually allocated. */
+		configASSERT( ( pxLink->xBlockSize & xBlockAllocatedBit ) != 0 );
+		configASSERT( pxLink->pxNextFreeBlock == NULL );
+
+		if( ( pxLink->xBlockSize & xBlockAllocatedBit ) != 0 )
+		{
+			if( pxLink->pxNextFreeBlock == NULL )
+			{
+				/* The block is being returned to the heap - it is no longer
+				allocated. */
+				pxLink->xBlockSize &= ~xBlockAllocatedBit;
+
+				vTaskSuspendAll();
+				{
+					/* Find the region the block came from. */
+					for( uxRegion = 0; uxRegion < uxRegionCount; uxRegion++ )
+					{
+						if( ( puc >= xRegions[ uxRegion ].pucAlignedStart ) && ( puc < ( unsigned char * ) xRegions[ uxRegion ].pxEnd ) )
+						{
+							xRegions[ uxRegion ].xFreeBytesRemaining += pxLink->xBlockSize;
+							xFreeBytesRemaining += pxLink->xBlockSize;
+							prvInsertBlockIntoFreeList( &( xRegions[ uxRegion ] ), pxLink );
+							break;
+						}
+					}
+
+					configASSERT( uxRegion < uxRegionCount );
+				}
+				xTaskResumeAll();
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+	return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetRegionFreeHeapSize( unsigned portBASE_TYPE uxRegion )
+{
+size_t xReturn = 0;
+
+	if( uxRegion < uxRegionCount )
+	{
+		xReturn = xRegions[ uxRegion ].xFreeBytesRemaining;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+	/* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+void vPortDefineHeapRegions( const xHeapRegion * const pxHeapRegions )
+{
+const xHeapRegion *pxHeapRegion;
+
+	/* Can only be called once, before anything is allocated. */
+	configASSERT( uxRegionCount == 0 );
+
+	/* Work out the position of the top bit in a size_t variable. */
+	xBlockAllocatedBit = ( ( size_t ) 1 ) << ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 1 );
+
+	for( pxHeapRegion = pxHeapRegions; ( pxHeapRegion->xSizeInBytes > 0 ) && ( uxRegionCount < ( unsigned portBASE_TYPE ) configHEAP_MAX_REGIONS ); pxHeapRegion++ )
+	{
+		prvInitialiseRegion( &( xRegions[ uxRegionCount ] ), pxHeapRegion->pucStartAddress, pxHeapRegion->xSizeInBytes );
+		xFreeBytesRemaining += xRegions[ uxRegionCount ].xFreeBytesRemaining;
+		uxRegionCount++;
+	}
+
+	xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+
+	configASSERT( uxRegionCount > 0 );
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( xHeapStatsType *pxHeapStats )
+{
+xBlockLink *pxBlock;
+size_t xLargest = 0, xBlocks = 0;
+unsigned portBASE_TYPE uxRegion;
+
+	vTaskSuspendAll();
+	{
+		if( uxRegionCount == 0 )
+		{
+			prvHeapInit();
+		}
+
+		for( uxRegion = 0; uxRegion < uxRegionCount; uxRegion++ )
+		{
+			for( pxBlock = xRegions[ uxRegion ].xStart.pxNextFreeBlock; pxBlock != xRegions[ uxRegion ].pxEnd; pxBlock = pxBlock->pxNextFreeBlock )
+			{
+				xBlocks++;
+				if( pxBlock->xBlockSize > xLargest )
+				{
+					xLargest = pxBlock->xBlockSize;
+				}
+			}
+		}
+
+		pxHeapStats->xFreeBytes = xFreeBytesRemaining;
+		pxHeapStats->xMinimumEverFreeBytes = xMinimumEverFreeBytesRemaining;
+		pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+	}
+	xTaskResumeAll();
+
+	if( xLargest > heapSTRUCT_SIZE )
+	{
+		pxHeapStats->xLargestFreeBlock = xLargest - heapSTRUCT_SIZE;
+	}
+	else
+	{
+		pxHeapStats->xLargestFreeBlock = 0;
+	}
+
+	/* The regions can never be merged, so a heap with two regions is at least
+	partly fragmented even when it is empty. */
+	if( pxHeapStats->xFreeBytes != 0 )
+	{
+		pxHeapStats->ucFragmentation = ( unsigned char ) ( 100UL - ( ( ( unsigned long ) xLargest * 100UL ) / ( unsigned long ) pxHeapStats->xFreeBytes ) );
+	}
+	else
+	{
+		pxHeapStats->ucFragmentation = 0;
+	}
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xPortGetHeapTraceEvent( unsigned portBASE_TYPE uxIndex, xHeapTraceEvent *pxEvent )
+{
+	/* Only heap_2.c and heap_4.c keep a trace of calls. */
+	( void ) uxIndex;
+	( void ) pxEvent;
+
+	return pdFAIL;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvBlockSizeForRequest( size_t xWantedSize )
+{
+	/* Check the requested block size is not so large that the top bit is
+	set.  The top bit of the block size member of the xBlockLink structure
+	is used to determine who owns the block - the application or the
+	kernel, so it must be free. */
+	if( ( xWantedSize == 0 ) || ( ( xWantedSize & xBlockAllocatedBit ) != 0 ) )
+	{
+		return 0;
+	}
+
+	/* The wanted size is increased so it can contain a xBlockLink
+	structure in addition to the requested amount of bytes. */
+	xWantedSize += heapSTRUCT_SIZE;
+
+	/* Ensure that blocks are always aligned to the required number
+	of bytes. */
+	if( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) != 0x00 )
+	{
+		/* Byte alignment required. */
+		xWantedSize += ( portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK ) );
+	}
+
+	return xWantedSize;
+}
+/*-----------------------------------------------------------*/
+
+static void *prvBlockAllocated( xRegionState *pxRegion, xBlockLink *pxBlock )
+{
+	pxRegion->xFreeBytesRemaining -= pxBlock->xBlockSize;
+	xFreeBytesRemaining -= pxBlock->xBlockSize;
+	if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+	{
+		xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+	}
+
+	/* The block is being returned - it is allocated and owned
+	by the application and has no "next" block. */
+	pxBlock->xBlockSize |= xBlockAllocatedBit;
+	pxBlock->pxNextFreeBlock = NULL;
+
+	/* Return the memory space pointed to - jumping over the
+	xBlockLink structure at its start. */
+	return ( void * ) ( ( ( unsigned char * ) pxBlock ) + heapSTRUCT_SIZE );
+}
+/*-----------------------------------------------------------*/
+
+static xBlockLink *prvAllocateFromRegion( xRegionState *pxRegion, size_t xWantedSize )
+{
+xBlockLink *pxBlock, *pxPreviousBlock, *pxNewBlockLink;
+
+	if( xWantedSize > pxRegion->xFreeBytesRemaining )
+	{
+		return NULL;
+	}
+
+	/* Traverse the list from the start	(lowest address) block until
+	one	of adequate size is found. */
+	pxPreviousBlock = &( pxRegion->xStart );
+	pxBlock = pxRegion->xStart.pxNextFreeBlock;
+	while( ( pxBlock->xBlockSize < xWantedSize ) && ( pxBlock->pxNextFreeBlock != NULL ) )
+	{
+		pxPreviousBlock = pxBlock;
+		pxBlock = pxBlock->pxNextFreeBlock;
+	}
+
+	/* If the end marker was reached then a block of adequate size
+	was	not found. */
+	if( pxBlock == pxRegion->pxEnd )
+	{
+		return NULL;
+	}
+
+	/* This block is being returned for use so must be taken out
+	of the list of free blocks. */
+	pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+
+	/* If the block is larger than required it can be split into
+	two. */
+	if( ( pxBlock->xBlockSize - xWantedSize ) > heapMINIMUM_BLOCK_SIZE )
+	{
+		/* This block is to be split into two.  Create a new
+		block following the number of bytes requested. The void
+		cast is used to prevent byte alignment warnings from the
+		compiler. */
+		pxNewBlockLink = ( void * ) ( ( ( unsigned char * ) pxBlock ) + xWantedSize );
+
+		/* Calculate the sizes of two blocks split from the
+		single block. */
+		pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+		pxBlock->xBlockSize = xWantedSize;
+
+		/* Insert the new block into the list of free blocks. */
+		prvInsertBlockIntoFreeList( pxRegion, pxNewBlockLink );
+	}
+
+	return pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapInit( void )
+{
+#if ( defined(portEXT_RAM) && !defined(portEXT_RAMFS) && !defined(portEXT_RAM_TASK_BANKS) )
+const xHeapRegion xDefaultRegions[] =
+{
+	{ ucSRAMHeap, sizeof( ucSRAMHeap ) },
+	{ ucHeap, sizeof( ucHeap ) },
+	{ NULL, 0 }
+};
+#else
+const xHeapRegion xDefaultRegions[] =
+{
+	{ ucHeap, sizeof( ucHeap ) },
+	{ NULL, 0 }
+};
+#endif
+
+	vPortDefineHeapRegions( xDefaultRegions );
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseRegion( xRegionState *pxRegion, unsigned char *pucStartAddress, size_t xSizeInBytes )
+{
+xBlockLink *pxFirstFreeBlock;
+unsigned char *pucHeapEnd;
+
+	/* Ensure the region starts and ends on a correctly aligned boundary. */
+	pxRegion->pucAlignedStart = ( unsigned char * ) ( ( ( portPOINTER_SIZE_TYPE ) ( pucStartAddress + portBYTE_ALIGNMENT_MASK ) ) & ( ( portPOINTER_SIZE_TYPE ) ~portBYTE_ALIGNMENT_MASK ) );
+	xSizeInBytes -= ( size_t ) ( pxRegion->pucAlignedStart - pucStartAddress );
+	xSizeInBytes &= ( size_t ) ~portBYTE_ALIGNMENT_MASK;
+
+	/* xStart is used to hold a pointer to the first item in the list of free
+	blocks.  The void cast is used to prevent compiler warnings. */
+	pxRegion->xStart.pxNextFreeBlock = ( void * ) pxRegion->pucAlignedStart;
+	pxRegion->xStart.xBlockSize = ( size_t ) 0;
+
+	/* pxEnd is used to mark the end of the list of free blocks and is inserted
+	at the end of the region. */
+	pucHeapEnd = pxRegion->pucAlignedStart + xSizeInBytes;
+	pucHeapEnd -= heapSTRUCT_SIZE;
+	pxRegion->pxEnd = ( void * ) pucHeapEnd;
+	configASSERT( ( ( ( unsigned long ) pxRegion->pxEnd ) & ( ( unsigned long ) portBYTE_ALIGNMENT_MASK ) ) == 0UL );
+	pxRegion->pxEnd->xBlockSize = 0;
+	pxRegion->pxEnd->pxNextFreeBlock = NULL;
+
+	/* To start with there is a single free block that is sized to take up the
+	entire region, minus the space taken by pxEnd. */
+	pxFirstFreeBlock = ( void * ) pxRegion->pucAlignedStart;
+	pxFirstFreeBlock->xBlockSize = xSizeInBytes - heapSTRUCT_SIZE;
+	pxFirstFreeBlock->pxNextFreeBlock = pxRegion->pxEnd;
+
+	pxRegion->xFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertBlockIntoFreeList( xRegionState *pxRegion, xBlockLink *pxBlockToInsert )
+{
+xBlockLink *pxIterator;
+unsigned char *puc;
+
+	/* Iterate through the list until a block is found that has a higher address
+	than the block being inserted. */
+	for( pxIterator = &( pxRegion->xStart ); pxIterator->pxNextFreeBlock < pxBlockToInsert; pxIterator = pxIterator->pxNextFreeBlock )
+	{
+		/* Nothing to do here, just iterate to the right position. */
+	}
+
+	/* Do the block being inserted, and the block it is being inserted after
+	make a contiguous block of memory? */
+	puc = ( unsigned char * ) pxIterator;
+	if( ( puc + pxIterator->xBlockSize ) == ( unsigned char * ) pxBlockToInsert )
+	{
+		pxIterator->xBlockSize += pxBlockToInsert->xBlockSize;
+		pxBlockToInsert = pxIterator;
+	}
+
+	/* Do the block being inserted, and the block it is being inserted before
+	make a contiguous block of memory? */
+	puc = ( unsigned char * ) pxBlockToInsert;
+	if( ( puc + pxBlockToInsert->xBlockSize ) == ( unsigned char * ) pxIterator->pxNextFreeBlock )
+	{
+		if( pxIterator->pxNextFreeBlock != pxRegion->pxEnd )
+		{
+			/* Form one big block from the two blocks. */
+			pxBlockToInsert->xBlockSize += pxIterator->pxNextFreeBlock->xBlockSize;
+			pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock->pxNextFreeBlock;
+		}
+		else
+		{
+			pxBlockToInsert->pxNextFreeBlock = pxRegion->pxEnd;
+		}
+	}
+	else
+	{
+		pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock;
+	}
+
+	/* If the block being inserted plugged a gap, so was merged with the block
+	before and the block after, then it's pxNextFreeBlock pointer will have
+	already been set, and should not be set here as that would make it point
+	to itself. */
+	if( pxIterator != pxBlockToInsert )
+	{
+		pxIterator->pxNextFreeBlock = pxBlockToInsert;
+	}
+}
+
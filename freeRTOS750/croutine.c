@@ -311,6 +311,13 @@ corCRCB *pxCRCB;
 
 void vCoRoutineSchedule( void )
 {
+	/* The lists are set up by the first xCoRoutineCreate(), and the idle task
+	calls this whether or not any co-routine has been created yet. */
+	if( pxCurrentCoRoutine == NULL )
+	{
+		return;
+	}
+
 	/* See if any co-routines readied by events need moving to the ready lists. */
 	prvCheckPendingReadyList();
 
@@ -0,0 +1,372 @@
+/*
+    FreeRTOS V7.5.0 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+*/
+
+
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "event_groups.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+to include event groups.  This #if is closed at the very bottom of this file. */
+#if ( configUSE_EVENT_GROUPS == 1 )
+
+/* The top byte of the event list item value of a waiting task holds how it is
+waiting, or that it was unblocked by bits being set.  Its top bit is used by the
+kernel, see tasks.c. */
+#if configUSE_16_BIT_TICKS == 1
+	#define eventCLEAR_EVENTS_ON_EXIT_BIT	0x0100U
+	#define eventUNBLOCKED_DUE_TO_BIT_SET	0x0200U
+	#define eventWAIT_FOR_ALL_BITS			0x0400U
+	#define eventEVENT_BITS_CONTROL_BYTES	0xff00U
+#else
+	#define eventCLEAR_EVENTS_ON_EXIT_BIT	0x01000000UL
+	#define eventUNBLOCKED_DUE_TO_BIT_SET	0x02000000UL
+	#define eventWAIT_FOR_ALL_BITS			0x04000000UL
+	#define eventEVENT_BITS_CONTROL_BYTES	0xff000000UL
+#endif
+
+/*
+ * Definition of an event group.
+ */
+typedef struct EventBitsDefinition
+{
+	xEventBits uxEventBits;					/*< The event bits.  Changed in a critical section, as xEventGroupClearBitsFromISR() can change them at any time. */
+	xList xTasksWaitingForBits;				/*< Tasks waiting for bits to be set, in no particular order.  Each one's event list item value holds the bits it is waiting for. */
+
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		unsigned char ucStaticallyAllocated;/*< Set to pdTRUE if the structure was supplied by xEventGroupCreateStatic(), so must not be freed. */
+	#endif
+} xEVENT_GROUP;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * pdTRUE if uxCurrentEventBits meet the wait condition, either any or all of
+ * uxBitsToWaitFor being set.
+ */
+static portBASE_TYPE prvTestWaitCondition( xEventBits uxCurrentEventBits, xEventBits uxBitsToWaitFor, portBASE_TYPE xWaitForAllBits ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+xEventGroupHandle xEventGroupCreate( void )
+{
+xEVENT_GROUP *pxEventBits;
+
+	pxEventBits = ( xEVENT_GROUP * ) pvPortMalloc( sizeof( xEVENT_GROUP ) );
+
+	if( pxEventBits != NULL )
+	{
+		pxEventBits->uxEventBits = 0;
+		vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+
+		#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		{
+			pxEventBits->ucStaticallyAllocated = pdFALSE;
+		}
+		#endif
+	}
+
+	return ( xEventGroupHandle ) pxEventBits;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	xEventGroupHandle xEventGroupCreateStatic( xStaticEventGroup *pxEventGroupBuffer )
+	{
+	xEVENT_GROUP *pxEventBits;
+
+		configASSERT( pxEventGroupBuffer );
+		configASSERT( sizeof( xStaticEventGroup ) == sizeof( xEVENT_GROUP ) );
+
+		pxEventBits = ( xEVENT_GROUP * ) pxEventGroupBuffer;
+		pxEventBits->uxEventBits = 0;
+		vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+		pxEventBits->ucStaticallyAllocated = pdTRUE;
+
+		return ( xEventGroupHandle ) pxEventBits;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+xEventBits xEventGroupWaitBits( xEventGroupHandle xEventGroup, xEventBits uxBitsToWaitFor, portBASE_TYPE xClearOnExit, portBASE_TYPE xWaitForAllBits, portTickType xTicksToWait )
+{
+xEVENT_GROUP *pxEventBits = ( xEVENT_GROUP * ) xEventGroup;
+xEventBits uxReturn, uxControlBits = 0;
+portBASE_TYPE xAlreadyYielded;
+
+	configASSERT( pxEventBits );
+	configASSERT( ( uxBitsToWaitFor & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
+	configASSERT( uxBitsToWaitFor != 0 );
+
+	/* The scheduler is suspended, rather than interrupts disabled, while the
+	task is placed on the list, as only tasks look at the list. */
+	vTaskSuspendAll();
+	{
+		taskENTER_CRITICAL();
+		{
+			uxReturn = pxEventBits->uxEventBits;
+
+			if( prvTestWaitCondition( uxReturn, uxBitsToWaitFor, xWaitForAllBits ) != pdFALSE )
+			{
+				/* Already met, so there is no need to block. */
+				if( xClearOnExit != pdFALSE )
+				{
+					pxEventBits->uxEventBits &= ~uxBitsToWaitFor;
+				}
+
+				xTicksToWait = ( portTickType ) 0;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( xTicksToWait != ( portTickType ) 0 )
+		{
+			if( xClearOnExit != pdFALSE )
+			{
+				uxControlBits |= eventCLEAR_EVENTS_ON_EXIT_BIT;
+			}
+
+			if( xWaitForAllBits != pdFALSE )
+			{
+				uxControlBits |= eventWAIT_FOR_ALL_BITS;
+			}
+
+			/* The bits are cleared, if need be, by the task that sets them,
+			so no other task can see them before this one does. */
+			vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+		}
+	}
+	xAlreadyYielded = xTaskResumeAll();
+
+	if( xTicksToWait != ( portTickType ) 0 )
+	{
+		if( xAlreadyYielded == pdFALSE )
+		{
+			portYIELD_WITHIN_API();
+		}
+
+		/* The task is running again.  If it was unblocked by bits being set,
+		its event list item holds the bits at that time. */
+		uxReturn = uxTaskResetEventItemValue();
+
+		if( ( uxReturn & eventUNBLOCKED_DUE_TO_BIT_SET ) == 0 )
+		{
+			/* The block time expired.  The bits may have been set since. */
+			taskENTER_CRITICAL();
+			{
+				uxReturn = pxEventBits->uxEventBits;
+
+				if( ( prvTestWaitCondition( uxReturn, uxBitsToWaitFor, xWaitForAllBits ) != pdFALSE ) && ( xClearOnExit != pdFALSE ) )
+				{
+					pxEventBits->uxEventBits &= ~uxBitsToWaitFor;
+				}
+			}
+			taskEXIT_CRITICAL();
+		}
+
+		uxReturn &= ~eventEVENT_BITS_CONTROL_BYTES;
+	}
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+xEventBits xEventGroupSetBits( xEventGroupHandle xEventGroup, xEventBits uxBitsToSet )
+{
+xEVENT_GROUP *pxEventBits = ( xEVENT_GROUP * ) xEventGroup;
+xListItem *pxItem, *pxNextItem;
+const xListItem * const pxEnd = ( const xListItem * ) &( pxEventBits->xTasksWaitingForBits.xListEnd );
+xEventBits uxEventBits, uxBitsWaitedFor, uxControlBits, uxBitsToClear = 0;
+xEventBits uxReturn;
+portBASE_TYPE xMatchFound;
+
+	configASSERT( pxEventBits );
+	configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
+
+	vTaskSuspendAll();
+	{
+		taskENTER_CRITICAL();
+		{
+			pxEventBits->uxEventBits |= uxBitsToSet;
+			uxEventBits = pxEventBits->uxEventBits;
+		}
+		taskEXIT_CRITICAL();
+
+		/* Unblock every waiting task whose condition is now met.  Each one is
+		given the bits as they were set, before any are cleared. */
+		for( pxItem = pxEventBits->xTasksWaitingForBits.xListEnd.pxNext; pxItem != pxEnd; pxItem = pxNextItem )
+		{
+			pxNextItem = pxItem->pxNext;
+			uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxItem );
+			uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
+			uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
+
+			xMatchFound = prvTestWaitCondition( uxEventBits, uxBitsWaitedFor, ( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) != 0 ) );
+
+			if( xMatchFound != pdFALSE )
+			{
+				if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != 0 )
+				{
+					uxBitsToClear |= uxBitsWaitedFor;
+				}
+
+				( void ) xTaskRemoveFromUnorderedEventList( pxItem, uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
+			}
+		}
+
+		taskENTER_CRITICAL();
+		{
+			pxEventBits->uxEventBits &= ~uxBitsToClear;
+			uxReturn = pxEventBits->uxEventBits;
+		}
+		taskEXIT_CRITICAL();
+	}
+	( void ) xTaskResumeAll();
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+xEventBits xEventGroupClearBits( xEventGroupHandle xEventGroup, xEventBits uxBitsToClear )
+{
+xEVENT_GROUP *pxEventBits = ( xEVENT_GROUP * ) xEventGroup;
+xEventBits uxReturn;
+
+	configASSERT( pxEventBits );
+	configASSERT( ( uxBitsToClear & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
+
+	taskENTER_CRITICAL();
+	{
+		uxReturn = pxEventBits->uxEventBits;
+		pxEventBits->uxEventBits &= ~uxBitsToClear;
+	}
+	taskEXIT_CRITICAL();
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+xEventBits xEventGroupClearBitsFromISR( xEventGroupHandle xEventGroup, xEventBits uxBitsToClear )
+{
+xEVENT_GROUP *pxEventBits = ( xEVENT_GROUP * ) xEventGroup;
+xEventBits uxReturn;
+unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+	configASSERT( ( uxBitsToClear & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
+
+	/* AVR interrupts do not nest, so this is only needed by other ports. */
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		uxReturn = pxEventBits->uxEventBits;
+		pxEventBits->uxEventBits &= ~uxBitsToClear;
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+xEventBits xEventGroupGetBitsFromISR( xEventGroupHandle xEventGroup )
+{
+xEVENT_GROUP *pxEventBits = ( xEVENT_GROUP * ) xEventGroup;
+xEventBits uxReturn;
+unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		uxReturn = pxEventBits->uxEventBits;
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vEventGroupDelete( xEventGroupHandle xEventGroup )
+{
+xEVENT_GROUP *pxEventBits = ( xEVENT_GROUP * ) xEventGroup;
+
+	configASSERT( pxEventBits );
+
+	vTaskSuspendAll();
+	{
+		/* Unblock the waiting tasks with no bits set. */
+		while( listLIST_IS_EMPTY( &( pxEventBits->xTasksWaitingForBits ) ) == pdFALSE )
+		{
+			( void ) xTaskRemoveFromUnorderedEventList( pxEventBits->xTasksWaitingForBits.xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+		}
+
+		#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		{
+			if( pxEventBits->ucStaticallyAllocated == pdFALSE )
+			{
+				vPortFree( pxEventBits );
+			}
+		}
+		#else
+		{
+			vPortFree( pxEventBits );
+		}
+		#endif
+	}
+	( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+void vEventGroupSetBitsCallback( void *pvEventGroup, xEventBits uxBitsToSet )
+{
+	( void ) xEventGroupSetBits( ( xEventGroupHandle ) pvEventGroup, uxBitsToSet );
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvTestWaitCondition( xEventBits uxCurrentEventBits, xEventBits uxBitsToWaitFor, portBASE_TYPE xWaitForAllBits )
+{
+portBASE_TYPE xWaitConditionMet;
+
+	if( xWaitForAllBits == pdFALSE )
+	{
+		xWaitConditionMet = ( ( uxCurrentEventBits & uxBitsToWaitFor ) != 0 );
+	}
+	else
+	{
+		xWaitConditionMet = ( ( uxCurrentEventBits & uxBitsToWaitFor ) == uxBitsToWaitFor );
+	}
+
+	return xWaitConditionMet;
+}
+
+/* This entire source file will be skipped if the application is not configured
+to include event groups.  If you want to include event groups then ensure
+configUSE_EVENT_GROUPS is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_EVENT_GROUPS */
@@ -241,6 +241,18 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 
 #endif /* configUSE_TIMERS */
 
+#ifndef configTIMER_DEFAULT_SLACK
+	#define configTIMER_DEFAULT_SLACK 0
+#endif
+
+#ifndef configUSE_TIMER_STATS
+	#define configUSE_TIMER_STATS 0
+#endif
+
+#if ( configUSE_TIMER_STATS == 1 ) && ( configGENERATE_RUN_TIME_STATS == 0 )
+	#error configUSE_TIMER_STATS times the timer callbacks with the run time counter, so configGENERATE_RUN_TIME_STATS must also be set to 1.
+#endif
+
 #ifndef INCLUDE_xTaskGetSchedulerState
 	#define INCLUDE_xTaskGetSchedulerState 0
 #endif
@@ -357,6 +369,30 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 	#define configCHECK_FOR_STACK_OVERFLOW 0
 #endif
 
+#ifndef configUSE_STACK_REPORT
+	#define configUSE_STACK_REPORT 0
+#endif
+
+#if ( configUSE_STACK_REPORT == 1 ) && ( configUSE_TRACE_FACILITY != 1 )
+	#error configUSE_STACK_REPORT lists the tasks with uxTaskGetSystemState(), so configUSE_TRACE_FACILITY must also be set to 1.
+#endif
+
+#ifndef configUSE_CRITICAL_PROFILER
+	#define configUSE_CRITICAL_PROFILER 0
+#endif
+
+#if ( configUSE_CRITICAL_PROFILER == 1 ) && ( configGENERATE_RUN_TIME_STATS == 0 )
+	#error configUSE_CRITICAL_PROFILER times critical sections with the run time counter, so configGENERATE_RUN_TIME_STATS must also be set to 1.
+#endif
+
+#ifndef configCO_ROUTINE_STACK_DEPTH
+	#define configCO_ROUTINE_STACK_DEPTH configMINIMAL_STACK_SIZE
+#endif
+
+#if ( configUSE_CO_ROUTINES == 1 ) && ( configUSE_TICKLESS_IDLE != 0 )
+	#error The idle task runs the co-routines, and does not know when a delayed co-routine must wake, so configUSE_TICKLESS_IDLE must be 0 when configUSE_CO_ROUTINES is 1.
+#endif
+
 /* The following event macros are embedded in the kernel API calls. */
 
 #ifndef traceMOVED_TASK_TO_READY_STATE
@@ -581,6 +617,58 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 	#define configUSE_QUEUE_SETS 0
 #endif
 
+#ifndef configUSE_QUEUE_ZERO_COPY
+	#define configUSE_QUEUE_ZERO_COPY 0
+#endif
+
+#ifndef configUSE_TASK_NOTIFICATIONS
+	#define configUSE_TASK_NOTIFICATIONS 0
+#endif
+
+#ifndef configUSE_EVENT_GROUPS
+	#define configUSE_EVENT_GROUPS 0
+#endif
+
+#ifndef configSUPPORT_STATIC_ALLOCATION
+	#define configSUPPORT_STATIC_ALLOCATION 0
+#endif
+
+#ifndef configUSE_TRACE_RECORDER
+	#define configUSE_TRACE_RECORDER 0
+#endif
+
+#ifndef configUSE_HEAP_STATS
+	#define configUSE_HEAP_STATS 0
+#endif
+
+#ifndef configUSE_HEAP_TRACE
+	#define configUSE_HEAP_TRACE 0
+#endif
+
+#ifndef configUSE_TASK_MEMORY_BANKS
+	#define configUSE_TASK_MEMORY_BANKS 0
+#endif
+
+#if ( configUSE_TASK_MEMORY_BANKS == 1 )
+	#ifndef portSWITCH_MEMORY_BANK
+		#error configUSE_TASK_MEMORY_BANKS is set to 1 but the port does not define portSWITCH_MEMORY_BANK()
+	#endif
+#endif
+
+#ifndef configUSE_TIMING_WHEEL
+	#define configUSE_TIMING_WHEEL 0
+#endif
+
+#ifndef configTIMING_WHEEL_SLOTS
+	#define configTIMING_WHEEL_SLOTS 8
+#endif
+
+#if ( configUSE_TIMING_WHEEL == 1 )
+	#if ( ( configTIMING_WHEEL_SLOTS & ( configTIMING_WHEEL_SLOTS - 1 ) ) != 0 )
+		#error configTIMING_WHEEL_SLOTS must be a power of 2
+	#endif
+#endif
+
 #ifndef portTASK_USES_FLOATING_POINT
 	#define portTASK_USES_FLOATING_POINT()
 #endif
@@ -69,35 +69,116 @@
 
 // And on to the things the same no matter the AVR type...
 #define configUSE_PREEMPTION		    1
+#ifndef configUSE_IDLE_HOOK
 #define configUSE_IDLE_HOOK		        0
+#endif
 #define configUSE_TICK_HOOK		        0
-#define configMAX_PRIORITIES		    ( ( unsigned portBASE_TYPE ) 4 )
+#ifndef configMAX_PRIORITIES
+#define configMAX_PRIORITIES		    ( 4 )	// Up to 8 with the port optimised task selection.
+#endif
+#ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION	1	// Ready priority bitmap, see portmacro.h.
+#endif
 #define configMINIMAL_STACK_SIZE	    ( ( uint16_t ) 85 )
 #define configMAX_TASK_NAME_LEN		    ( 16 )
-#define configUSE_TRACE_FACILITY	    0
 #define configUSE_16_BIT_TICKS		    1
 #define configIDLE_SHOULD_YIELD		    1
 #define configUSE_MUTEXES               1
 #define configUSE_RECURSIVE_MUTEXES     0
 #define configUSE_COUNTING_SEMAPHORES   0
 #define configUSE_QUEUE_SETS			0
+// The optional features below are off unless a project defines them, in its own and the freeRTOS750 library build.
+#ifndef configUSE_QUEUE_ZERO_COPY
+#define configUSE_QUEUE_ZERO_COPY		0	// pvQueueReserve()/xQueueCommit() and pvQueuePeekInPlace()/xQueueRelease().
+#endif
+#ifndef configUSE_TASK_NOTIFICATIONS
+#define configUSE_TASK_NOTIFICATIONS	0	// xTaskNotify()/ulTaskNotifyTake(), five bytes per TCB.
+#endif
+#ifndef configSUPPORT_STATIC_ALLOCATION
+#define configSUPPORT_STATIC_ALLOCATION	0	// xTaskCreateStatic(), xQueueCreateStatic(), xSemaphoreCreateBinaryStatic().
+#endif
+#ifndef configUSE_EVENT_GROUPS
+#define configUSE_EVENT_GROUPS			0	// xEventGroupWaitBits()/xEventGroupSetBits(), 8 event bits per group.
+#endif
+#ifndef configUSE_HEAP_STATS
+#define configUSE_HEAP_STATS			0	// xSerialxPrintHeapStats(), needs heap_2, heap_4, heap_5 or heap_6 for vPortGetHeapStats().
+#endif
+#ifndef configUSE_HEAP_TRACE
+#define configUSE_HEAP_TRACE			0	// Recent pvPortMalloc()/vPortFree() calls kept by heap_2 and heap_4, 11 bytes each.
+#endif
+#if defined(portEXT_RAM_TASK_BANKS)
+#define configUSE_TASK_MEMORY_BANKS		1	// vTaskSetMemoryBank(), the XRAM bank is switched with each task.
+#endif
+#ifndef configUSE_TIMING_WHEEL
+#define configUSE_TIMING_WHEEL			0	// Delayed tasks hashed by wake tick into unsorted lists: no sorted insert in vTaskDelay(), 9 bytes per slot.
+#endif
+#ifndef configTIMING_WHEEL_SLOTS
+#define configTIMING_WHEEL_SLOTS		8	// Power of 2. Each tick looks through the tasks in one slot.
+#endif
 #define configUSE_ALTERNATIVE_API       0
+#ifndef configUSE_TICKLESS_IDLE
 #define configUSE_TICKLESS_IDLE			0
+#endif
 #define configQUEUE_REGISTRY_SIZE	    0
 #define configCHECK_FOR_STACK_OVERFLOW  1
-
-/* Timer definitions. */
-#define configUSE_TIMERS				0
-#define configTIMER_TASK_PRIORITY       ( ( unsigned portBASE_TYPE ) 7 )
-#define configTIMER_QUEUE_LENGTH        ( ( unsigned portBASE_TYPE ) 10 )
-#define configTIMER_TASK_STACK_DEPTH    configMINIMAL_STACK_SIZE
-
-/* Co-routine definitions. */
+#ifndef configUSE_STACK_REPORT
+#define configUSE_STACK_REPORT			0	// Task stack sizes and the system stack high water mark, see xSerialxPrintStackReport(). 2 bytes per task.
+#endif
+
+/* Timer definitions. Periodic jobs can share the timer service task, rather than each needing a task and stack. */
+#ifndef configUSE_TIMERS
+#define configUSE_TIMERS				0	// The timer service task, with a stack of configTIMER_TASK_STACK_DEPTH. UnoBlink turns it on.
+#endif
+#define configTIMER_TASK_PRIORITY       ( ( unsigned portBASE_TYPE ) ( configMAX_PRIORITIES - 1 ) )
+#ifndef configTIMER_QUEUE_LENGTH
+#define configTIMER_QUEUE_LENGTH        ( ( unsigned portBASE_TYPE ) 4 )	// 5 bytes per command.
+#endif
+#ifndef configTIMER_TASK_STACK_DEPTH
+#define configTIMER_TASK_STACK_DEPTH    ( ( uint16_t ) 192 )	// All the timer callbacks run on this stack.
+#endif
+#ifndef configTIMER_DEFAULT_SLACK
+#define configTIMER_DEFAULT_SLACK		0	// Ticks a callback may run late to share a wake up, see xTimerChangeSlack().
+#endif
+
+/* Run time stats, counted by the spare 16 bit Timer chosen in freeRTOSBoardDefs.h (if there is one). */
+#if defined(portUSE_TIMER3_STATS) || defined(portUSE_TIMER4_STATS) || defined(portUSE_TIMER5_STATS)
+#define configGENERATE_RUN_TIME_STATS	1
+#define configUSE_TRACE_FACILITY	    1	// Needed for uxTaskGetSystemState(), used by the serial task report.
+#define configUSE_TIMER_STATS			configUSE_TIMERS	// Timer callback run times, see vTimerGetStats().
+#else
+#define configGENERATE_RUN_TIME_STATS	0
+#define configUSE_TRACE_FACILITY	    configUSE_STACK_REPORT	// Only needed for the stack report.
+#define configUSE_TIMER_STATS			0
+#endif
+
+/* Time the longest critical section (interrupts off) and where it was, see xSerialxPrintCriticalStats(). Needs the run time stats timer. */
+#ifndef configUSE_CRITICAL_PROFILER
+#define configUSE_CRITICAL_PROFILER		0
+#endif
+
+/* Kernel event trace recorder, see traceRecorder.h. Uses the run time stats timer for its time stamps, if there is one. */
+#ifndef configUSE_TRACE_RECORDER
+#define configUSE_TRACE_RECORDER		0
+#endif
+#if ( configUSE_TRACE_RECORDER == 1 )
+#include <traceHooks.h>
+#endif
+
+/* Co-routine definitions. Co-routines are run by the idle task, sharing its stack, see CO_ROUTINES.md. */
+#ifndef configUSE_CO_ROUTINES
 #define configUSE_CO_ROUTINES 		    0
+#endif
+#ifndef configMAX_CO_ROUTINE_PRIORITIES
 #define configMAX_CO_ROUTINE_PRIORITIES ( 2 )
+#endif
+#ifndef configCO_ROUTINE_STACK_DEPTH
+#define configCO_ROUTINE_STACK_DEPTH	( ( uint16_t ) 160 )	// The idle task stack, when it runs the co-routines.
+#endif
 
 /* Set the stack pointer type to be uint16_t, otherwise it defaults to unsigned long */
+#ifndef portPOINTER_SIZE_TYPE
 #define portPOINTER_SIZE_TYPE			uint16_t
+#endif
 
 /* Set the following definitions to 1 to include the API function, or zero
 to exclude the API function. */
@@ -331,6 +331,66 @@ void vCoRoutineSchedule( void );
 	}																					\
 	crSET_STATE0( ( xHandle ) );
 
+/**
+ * croutine. h
+ *<pre>
+ crDELAY_UNTIL( xCoRoutineHandle xHandle, portTickType *pxPreviousWakeTime, portTickType xTimeIncrement );</pre>
+ *
+ * Delay a co-routine until xTimeIncrement ticks after *pxPreviousWakeTime,
+ * then move *pxPreviousWakeTime on by xTimeIncrement.  This is the co-routine
+ * form of vTaskDelayUntil(), for co-routines that must run at a fixed
+ * frequency.  If the wake time has already passed the co-routine does not
+ * delay, but still yields to other co-routines of the same priority.
+ *
+ * As with crDELAY, crDELAY_UNTIL can only be called from the co-routine
+ * function itself, and *pxPreviousWakeTime must be a static variable.
+ *
+ * @param xHandle The handle of the co-routine to delay.  This is the xHandle
+ * parameter of the co-routine function.
+ *
+ * @param pxPreviousWakeTime The tick the co-routine last woke at.  Set it to
+ * xTaskGetTickCount() before the first call.
+ *
+ * @param xTimeIncrement The period of the co-routine, in ticks.
+ *
+ * Example usage:
+   <pre>
+ // Co-routine to be created.
+ void vSensorCoRoutine( xCoRoutineHandle xHandle, unsigned portBASE_TYPE uxIndex )
+ {
+ static portTickType xLastWakeTime;
+
+     crSTART( xHandle );
+
+     xLastWakeTime = xTaskGetTickCount();
+
+     for( ;; )
+     {
+        // Read the sensor every 100ms, without drift.
+        crDELAY_UNTIL( xHandle, &xLastWakeTime, 100 / portTICK_RATE_MS );
+
+        vReadSensor();
+     }
+
+     crEND();
+ }</pre>
+ * \defgroup crDELAY_UNTIL crDELAY_UNTIL
+ * \ingroup Tasks
+ */
+#define crDELAY_UNTIL( xHandle, pxPreviousWakeTime, xTimeIncrement )					\
+	{																					\
+	portTickType xCrTicksToWake;														\
+																						\
+		*( pxPreviousWakeTime ) += ( xTimeIncrement );									\
+		xCrTicksToWake = *( pxPreviousWakeTime ) - xTaskGetTickCount();					\
+		/* A wake time already passed gives more ticks than the period. */				\
+		if( ( xCrTicksToWake > 0 ) && ( xCrTicksToWake <= ( xTimeIncrement ) ) )		\
+		{																				\
+			vCoRoutineAddToDelayedList( xCrTicksToWake, NULL );							\
+		}																				\
+	}																					\
+	crSET_STATE0( ( xHandle ) );
+
 /**
  * <pre>
  crQUEUE_SEND(
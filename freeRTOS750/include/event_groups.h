@@ -0,0 +1,193 @@
+/*
+    FreeRTOS V7.5.0 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+*/
+
+
+/*
+ * Event groups.
+ *
+ * An event group is a set of event bits, each one meaning something has
+ * happened or is true: a link is up, an IP address is leased, a card is
+ * mounted.  Any number of tasks can wait for any one, or for all, of a chosen
+ * combination of bits to be set, with a timeout, so a task can block on
+ * several conditions at once without polling flags or being suspended and
+ * resumed by another task.
+ *
+ * Bits are set and cleared by tasks, or by interrupts.  Setting bits looks at
+ * every task waiting on the group, which an interrupt should not do with
+ * interrupts disabled for an unknown time, so xEventGroupSetBitsFromISR()
+ * hands the bits to the timer service task, which sets them.
+ *
+ * The bits are held in a portTickType, whose top byte is used by the kernel.
+ * With configUSE_16_BIT_TICKS set to 1, as on the AVR, a group therefore has
+ * 8 event bits (0x01 to 0x80), otherwise it has 24.
+ */
+
+#ifndef EVENT_GROUPS_H
+#define EVENT_GROUPS_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include event_groups.h"
+#endif
+
+#include "timers.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Type by which event groups are referenced.  For example, a call to
+ * xEventGroupCreate() returns an xEventGroupHandle variable that can then be
+ * used as a parameter to xEventGroupWaitBits(), xEventGroupSetBits(), etc.
+ */
+typedef void * xEventGroupHandle;
+
+/**
+ * The type of a set of event bits.
+ */
+typedef portTickType xEventBits;
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	/*
+	 * Storage for an event group created with xEventGroupCreateStatic().  The
+	 * members are not for use by the application; the structure only has the
+	 * same size and alignment as the xEVENT_GROUP structure in event_groups.c.
+	 */
+	typedef struct xSTATIC_EVENT_GROUP
+	{
+		portTickType xDummy1;
+		xList xDummy2;
+		unsigned char ucDummy3;
+	} xStaticEventGroup;
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+/*
+ * Creates an event group, with all its bits clear.
+ *
+ * @return The handle of the event group, or NULL if there was not enough
+ * heap for it.
+ */
+xEventGroupHandle xEventGroupCreate( void ) PRIVILEGED_FUNCTION;
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	/*
+	 * Creates an event group in pxEventGroupBuffer, rather than on the heap.
+	 *
+	 * @return The handle of the event group.
+	 */
+	xEventGroupHandle xEventGroupCreateStatic( xStaticEventGroup *pxEventGroupBuffer ) PRIVILEGED_FUNCTION;
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+/*
+ * Waits for bits in an event group to be set.
+ *
+ * @param uxBitsToWaitFor The bits to wait for.  Must not be 0.
+ *
+ * @param xClearOnExit If pdTRUE, the bits in uxBitsToWaitFor are cleared
+ * before the call returns, if it returns because the wait condition was met.
+ * They are cleared in the same critical step that finds them set, so no other
+ * task waiting for the same bits can miss them or see them twice.
+ *
+ * @param xWaitForAllBits If pdTRUE, the call waits for all of the bits in
+ * uxBitsToWaitFor to be set.  If pdFALSE, it waits for any one of them.
+ *
+ * @param xTicksToWait The longest time to wait, in ticks.  0 does not block,
+ * and portMAX_DELAY blocks without a timeout if INCLUDE_vTaskSuspend is 1.
+ *
+ * @return The event bits when the wait condition was met, or when the block
+ * time expired, before any were cleared by xClearOnExit.  Test the returned
+ * value to tell which happened.
+ *
+ * Example usage:
+ * <pre>
+ #define mainLINK_UP_BIT	( 1 << 0 )
+ #define mainIP_LEASED_BIT	( 1 << 1 )
+ #define mainSD_MOUNTED_BIT	( 1 << 2 )
+
+ xEventBits uxBits;
+
+	// Block until the network and the card are both ready.
+	uxBits = xEventGroupWaitBits( xEvents, mainLINK_UP_BIT | mainIP_LEASED_BIT | mainSD_MOUNTED_BIT, pdFALSE, pdTRUE, portMAX_DELAY );
+ </pre>
+ */
+xEventBits xEventGroupWaitBits( xEventGroupHandle xEventGroup, xEventBits uxBitsToWaitFor, portBASE_TYPE xClearOnExit, portBASE_TYPE xWaitForAllBits, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Sets bits in an event group, unblocking each waiting task whose wait
+ * condition is then met.  Must not be called from an interrupt.
+ *
+ * @return The event bits when the call returns.  A task that was unblocked
+ * with xClearOnExit set may already have cleared the bits that were set.
+ */
+xEventBits xEventGroupSetBits( xEventGroupHandle xEventGroup, xEventBits uxBitsToSet ) PRIVILEGED_FUNCTION;
+
+/*
+ * Clears bits in an event group.  Can be called from a task or an interrupt,
+ * as clearing bits never unblocks a task.
+ *
+ * @return The event bits before the bits were cleared.
+ */
+xEventBits xEventGroupClearBits( xEventGroupHandle xEventGroup, xEventBits uxBitsToClear ) PRIVILEGED_FUNCTION;
+xEventBits xEventGroupClearBitsFromISR( xEventGroupHandle xEventGroup, xEventBits uxBitsToClear ) PRIVILEGED_FUNCTION;
+
+/*
+ * The current event bits.
+ */
+#define xEventGroupGetBits( xEventGroup )	xEventGroupClearBits( ( xEventGroup ), 0 )
+xEventBits xEventGroupGetBitsFromISR( xEventGroupHandle xEventGroup ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_TIMERS == 1 )
+
+	/*
+	 * Sets bits in an event group from an interrupt.  The bits are sent to
+	 * the timer service task on its command queue, and are set when it runs,
+	 * so they are not yet set when the call returns.
+	 *
+	 * @param pxHigherPriorityTaskWoken Set to pdTRUE if the timer service task
+	 * has a higher priority than the interrupted task, in which case a context
+	 * switch should be requested before the interrupt exits, so the bits are
+	 * set as soon as the interrupt returns.
+	 *
+	 * @return pdPASS, or pdFAIL if the timer command queue was full.
+	 */
+	#define xEventGroupSetBitsFromISR( xEventGroup, uxBitsToSet, pxHigherPriorityTaskWoken ) xTimerGenericCommand( ( xTimerHandle ) ( xEventGroup ), tmrCOMMAND_SET_EVENT_BITS, ( uxBitsToSet ), ( pxHigherPriorityTaskWoken ), 0U )
+
+#endif /* configUSE_TIMERS */
+
+/*
+ * Deletes an event group.  Any tasks waiting on it are unblocked, and see 0
+ * returned by xEventGroupWaitBits().
+ */
+void vEventGroupDelete( xEventGroupHandle xEventGroup ) PRIVILEGED_FUNCTION;
+
+/* Not public API functions.  Called by the timer service task. */
+void vEventGroupSetBitsCallback( void *pvEventGroup, xEventBits uxBitsToSet ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVENT_GROUPS_H */
@@ -124,6 +124,8 @@ void extRAMInitHeap(bool heapInXmem_);  // use heapInXmem_ false to ignore the h
 
 void setMemoryBank(uint8_t bank_, bool switchHeap_);  // use switchHeap_ false to ignore the heap state for portEXT_RAMFS usage.
 
+uint8_t getMemoryBank(void);  // the bank last selected by setMemoryBank().
+
 extRAMSelfTestResults extRAMSelfTest(void);
 
 
@@ -8,6 +8,8 @@
  *
  * And also Pololu SVP with ATmega1284p
  *
+ * And the POSIX (Linux host) simulator, for benchmarking the kernel.
+ *
  */
 
 #ifndef freeRTOSBoardDefs_h
@@ -17,7 +19,11 @@
 extern "C" {
 #endif
 
+#if defined(GCC_POSIX)
+#include <stdint.h>
+#else
 #include <avr/io.h>
+#endif
 
 /*-----------------------------------------------------------
  * MCU and application specific definitions.
@@ -47,19 +53,24 @@ extern "C" {
 //	#define portEXT_RAM_16_BANK										// XRAM Memory is available as 16 banks of 32kByte, for heap. - OR -
 //	#define portEXT_RAMFS											// XRAM Memory is available as 16 banks of 32kByte for 16 Arduino clients (i.e. NOT used for heap).
 
+//	XRAM bank option, valid with either RAM device. Can be combined with portEXT_RAM_16_BANK.
+//	#define portEXT_RAM_TASK_BANKS									// Each bank is a private malloc() region for the tasks bound to it by vTaskSetMemoryBank(), and is switched
+																	// with each task. The FreeRTOS heap stays in internal SRAM. Call extRAMInitHeap(true) before starting the scheduler.
+
 
 #if defined (portQUAD_RAM) || defined (portMEGA_RAM)
 	#define portEXT_RAM
 #endif
 
-#if defined (portMEGA_RAM) || (defined (portQUAD_RAM) && !defined (portEXT_RAMFS))
+#if ( defined (portMEGA_RAM) || (defined (portQUAD_RAM) && !defined (portEXT_RAMFS)) ) && !defined (portEXT_RAM_TASK_BANKS)
 	// XRAM banks enabled. We have to set the linker to move the heap to XRAM. -> DON'T FORGET TO ADD THESE LINK OPTIONS
 	#define configTOTAL_HEAP_SIZE	( (size_t ) ((uint8_t *)(XRAMEND - 0x8000)) ) // Should be 0xffff - 0x8000 = 32767 for (non malloc) heap in XRAM.
-																	// Used for heap_1.c, heap2.c, and heap4.c only, and maximum Array size possible for Heap is 32767.
+																	// Used for heap_1.c, heap2.c, heap4.c, heap_5.c, and heap_6.c only, and maximum Array size possible for Heap is 32767.
+	#define configSRAM_HEAP_SIZE	( (size_t ) 0x1000 )			// heap_6.c only. Internal SRAM region for TCBs, stacks and queues, used before the XRAM region above.
 #else
 	// There is no XRAM available for the heap.
-	#define configTOTAL_HEAP_SIZE	( (size_t ) 0x1800 )			// 0x1800 = 6144 used for heap_1.c, heap2.c, and heap4.c only, where heap is NOT in XRAM.
-																	// Used for heap_1.c, heap2.c, and heap4.c only, and maximum Array size possible for Heap is 32767.
+	#define configTOTAL_HEAP_SIZE	( (size_t ) 0x1800 )			// 0x1800 = 6144 used for heap_1.c, heap2.c, heap4.c, heap_5.c, and heap_6.c only, where heap is NOT in XRAM.
+																	// Used for heap_1.c, heap2.c, heap4.c, heap_5.c, and heap_6.c only, and maximum Array size possible for Heap is 32767.
 #endif
 
 //	#define portW5200						// or we assume W5100 Ethernet
@@ -74,6 +85,9 @@ extern "C" {
 
     #define portUSE_TIMER1_PWM				// Define which Timer to use as the PWM Timer (not the tick timer).
 
+//	#define portUSE_TIMER5_STATS			// Define which spare 16 bit Timer counts the per task run time stats (not the tick or PWM timer).
+											// Uncomment to turn the run time stats on. Timer5 is then no longer free for PWM or input capture.
+
 
 #elif (defined(__AVR_ATmega1284P__) || defined(__AVR_ATmega1284PA__)) // Goldilocks with 1284p
 
@@ -87,8 +101,11 @@ extern "C" {
     #define configTICK_RATE_HZ		( ( portTickType ) 256 )		// Use 500Hz for TIMER3. MINIMUM of 128Hz for TIMER2.
                                                                     // Use 1000Hz to get mSec timing using TIMER3.
 
+//	#define configUSE_TICKLESS_IDLE	1								// Suppress the TIMER2 tick when idle, and sleep in power-save. For battery loggers.
+																	// TIMER2 only, with tick rates 128, 256, 512, 1024 or 4096Hz. Serial input can't wake power-save.
+
 	#define configCPU_CLOCK_HZ		( ( uint32_t ) F_CPU )			// This F_CPU variable set by Eclipse environment
-    #define configTOTAL_HEAP_SIZE	( (size_t )  12000  )			// used for heap_1.c and heap2.c, and heap_4.c only
+    #define configTOTAL_HEAP_SIZE	( (size_t )  12000  )			// used for heap_1.c and heap2.c, heap_4.c, heap_5.c, and heap_6.c only
 
 	#define portW5200						// or we assume W5100 Ethernet
 
@@ -103,6 +120,10 @@ extern "C" {
     #define portUSE_TIMER1_PWM				// Define which Timer to use as the PWM Timer (not the tick timer).
 											// though it is better to use Pololu functions, as they support 8x multiplexed servos.
 
+//	#define portUSE_TIMER3_STATS			// Define which spare 16 bit Timer counts the per task run time stats (not the tick or PWM timer).
+											// Uncomment to turn the run time stats on, unless portUSE_TIMER3 is used for the tick.
+											// Timer3 is then no longer free for PWM or input capture.
+
 #elif defined(__AVR_ATmega32U2__) || defined(__AVR_ATmega16U2__) || defined(__AVR_ATmega8U2__)
 // Arduino Serial I/O MCU Compatible notation.
 #ifndef _U2DUINO_
@@ -122,7 +143,7 @@ extern "C" {
 	// Greater than 100% memory usage. Subtle fail.
 	// Less than 96%. Typically every byte counts for 328p.
 	// Watch for the stack overflowing, if you use interrupts. Use configCHECK_FOR_STACK_OVERFLOW
-    #define configTOTAL_HEAP_SIZE	( (size_t ) 830 )				// used for heap_1.c, heap_2.c, and heap_4.c only
+    #define configTOTAL_HEAP_SIZE	( (size_t ) 830 )				// used for heap_1.c, heap_2.c, heap_4.c, heap_5.c, and heap_6.c only
 
 	#define	portSERIAL_BUFFER_RX	16		// Define the size of the serial receive buffer.
 	#define	portSERIAL_BUFFER_TX	128		// Define the size of the serial transmit buffer, only as long as the longest line of text.
@@ -156,7 +177,7 @@ extern "C" {
 	// Greater than 100% memory usage. Subtle fail.
 	// Less than 96%. Typically every byte counts for 328p.
 	// Watch for the stack overflowing, if you use interrupts. Use configCHECK_FOR_STACK_OVERFLOW
-    #define configTOTAL_HEAP_SIZE	( (size_t ) 1630 )				// used for heap_1.c, heap_2.c, and heap_4.c only
+    #define configTOTAL_HEAP_SIZE	( (size_t ) 1630 )				// used for heap_1.c, heap_2.c, heap_4.c, heap_5.c, and heap_6.c only
 
 	#define portEXT_RAMFS					// XRAM Memory is available by a 2560 as 16 banks of 32kByte for 16x 328p ArduSat (Uno) clients.
 
@@ -178,6 +199,22 @@ extern "C" {
 	#error Missing definition: The PWM Timer is not defined.
 #endif
 
+// The 328p has only the one 16 bit Timer (Timer1), already taken for the tick or PWM, so there are no run time stats.
+
+#elif defined(GCC_POSIX) // POSIX (Linux host) simulator
+
+#ifndef _POSIX_HOST_
+	#define _POSIX_HOST_
+#endif
+
+    #define configTICK_RATE_HZ		( ( portTickType ) 1000 )		// Simulated tick, so use 1000Hz to get mSec timing.
+
+	#define configCPU_CLOCK_HZ		( ( uint32_t ) 16000000 )		// Nominal only. Nothing on the host is clocked from it.
+    #define configTOTAL_HEAP_SIZE	( (size_t ) 0x10000 )			// used for heap_1.c, heap_2.c, heap_4.c, heap_5.c, and heap_6.c only. Pointers are 8 bytes here.
+
+	#define configUSE_IDLE_HOOK		1		// The idle hook drives the simulated tick. See portable/POSIX/port.c
+	#define portPOINTER_SIZE_TYPE	uintptr_t
+
 #else
 	#error Missing definition: The MCU type is not defined.
 #endif
@@ -218,6 +255,15 @@ extern "C" {
 #define SPI_PORT_PIN_SS_SD	PING
 #define SPI_BIT_SS_SD		_BV(PG5)	// added for SD Card support with SS on PG5 (Pin 10)
 
+// USART as SPI master (MSPIM) clock pins, for spiBindBus(). TXDn is MOSI, RXDn is MISO.
+// None of the XCK pins are brought out on the Arduino Mega headers, so they need a wire to the chip.
+#define SPI_USART1_PORT_DIR_XCK	DDRD
+#define SPI_USART1_BIT_XCK		_BV(PD5)	// XCK1, with TXD1 on PD3 (Pin 18) and RXD1 on PD2 (Pin 19)
+#define SPI_USART2_PORT_DIR_XCK	DDRH
+#define SPI_USART2_BIT_XCK		_BV(PH2)	// XCK2, with TXD2 on PH1 (Pin 16) and RXD2 on PH0 (Pin 17)
+#define SPI_USART3_PORT_DIR_XCK	DDRJ
+#define SPI_USART3_BIT_XCK		_BV(PJ2)	// XCK3, with TXD3 on PJ1 (Pin 14) and RXD3 on PJ0 (Pin 15)
+
 // port A pins
 #define IO_A0				0
 #define IO_A1				1
@@ -358,6 +404,11 @@ extern "C" {
 #define SPI_PORT_PIN_SS_SD	PIND
 #define SPI_BIT_SS_SD		_BV(PD4)	// added for SD Card support with SS on PD4 (Pin 4) for Standard Arduino SD cages.
 
+// USART as SPI master (MSPIM) clock pin, for spiBindBus(). TXD1 is MOSI, RXD1 is MISO.
+// XCK1 is the same pin as the SD card SS above, so the SD card can't use it as well.
+#define SPI_USART1_PORT_DIR_XCK	DDRD
+#define SPI_USART1_BIT_XCK		_BV(PD4)	// XCK1 on PD4 (Pin 4), with TXD1 on PD3 (Pin 3) and RXD1 on PD2 (Pin 2)
+
 // port D pins
 #define IO_D0				0
 #define IO_D1				1
@@ -497,6 +548,9 @@ extern "C" {
 #define IO_C5				19
 //#define IO_C6				// only used if RESET pin is changed to be a digital I/O
 
+#elif defined(_POSIX_HOST_)
+// There are no pins on the host. Only the hardware independent libraries can be used.
+
 #else
 	#error Missing definition: The Board is not defined.
 #endif
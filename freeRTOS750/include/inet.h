@@ -41,7 +41,7 @@ extern uint8_t src_mac_addr[];						// Local MAC address, defined in main progra
 
 /* General Definitions for the Packet Buffer in the MCU */
 
-#if ( defined(portEXT_RAM) && !defined(portEXT_RAMFS) )
+#if ( defined(portEXT_RAM) && !defined(portEXT_RAMFS) && !defined(portEXT_RAM_TASK_BANKS) )
 #define FILE_BUFFER_SIZE 		2048	// size of file working buffer (on heap) with extended RAM (set to less than MTP, best efficiency).
 										// On the wire 54 bytes added to this size.
 #elif defined(_GOLDILOCKS_)
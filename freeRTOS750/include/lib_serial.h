@@ -64,6 +64,14 @@ extern "C" {
 #include "queue.h"
 #include "portable.h"
 
+#if ( configUSE_TIMER_STATS == 1 )
+#include "timers.h"
+#endif
+
+#if ( SPI_STATS == 1 )
+#include "spi.h"
+#endif
+
 #include "ringBuffer.h"
 
 typedef enum
@@ -160,6 +168,72 @@ void xSerialxPrintf_P(xComPortHandlePtr pxPort, PGM_P format, ...);
 void xSerialxPrint(xComPortHandlePtr pxPort, uint8_t * str);
 void xSerialxPrint_P(xComPortHandlePtr pxPort, PGM_P str);
 
+#if ( configUSE_HEAP_STATS == 1 )
+/**
+ * Print the heap free space, minimum ever free space, largest free block and
+ * fragmentation, then the recent pvPortMalloc()/vPortFree() calls if the heap
+ * keeps them (configUSE_HEAP_TRACE). Needs heap_2, heap_4, heap_5 or heap_6.
+ * tools/heap_decode.py turns a captured report into caller names.
+ * @param pxPort serial port to print to.
+ */
+void xSerialxPrintHeapStats( xComPortHandlePtr pxPort );
+#endif
+
+#if ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_TRACE_FACILITY == 1 )
+/**
+ * Print a top style table of the tasks: state, priority, stack high water mark,
+ * and the share of the CPU each task has used since the previous call.
+ * @param pxPort serial port to print to.
+ */
+void xSerialxPrintTaskStats( xComPortHandlePtr pxPort );
+#endif
+
+#if ( configUSE_TIMER_STATS == 1 )
+/**
+ * Print a software timer's callback count, average and longest callback run
+ * time (in run time counter counts, as the task report), and the most ticks a
+ * callback has been run late.
+ * @param pxPort serial port to print to.
+ * @param xTimer timer to report on.
+ */
+void xSerialxPrintTimerStats( xComPortHandlePtr pxPort, xTimerHandle xTimer );
+#endif
+
+#if ( configUSE_STACK_REPORT == 1 )
+/**
+ * Print each task's stack size, the most of it ever used and the least ever
+ * free, then the same for the system stack that main() ran on. Interrupts run
+ * on the stack of the task they interrupt, so are counted in the task figures.
+ * tools/stack_usage.py sets a captured report beside the static worst case.
+ * @param pxPort serial port to print to.
+ */
+void xSerialxPrintStackReport( xComPortHandlePtr pxPort );
+#endif
+
+#if ( configUSE_CRITICAL_PROFILER == 1 )
+/**
+ * Print the longest time interrupts were off in a critical section, with the
+ * code addresses it was entered and left at (avr-addr2line -f -e the elf),
+ * then how many critical sections there were and their share of the time.
+ * @param pxPort serial port to print to.
+ * @param xReset pdTRUE to start the figures again, so the next report covers
+ * only the time since this one.
+ */
+void xSerialxPrintCriticalStats( xComPortHandlePtr pxPort, portBASE_TYPE xReset );
+#endif
+
+#if ( SPI_STATS == 1 )
+/**
+ * Print, for each SPI device, the times it held its bus and the bytes it
+ * moved, the total and longest hold, and its share of the time, then the
+ * total and longest wait for the bus and the waits that timed out.
+ * @param pxPort serial port to print to.
+ * @param xReset pdTRUE to start the figures again, so the next report covers
+ * only the time since this one.
+ */
+void xSerialxPrintSPIStats( xComPortHandlePtr pxPort, portBASE_TYPE xReset );
+#endif
+
 /**
  * Interrupt driven routines to interface to ISR serial port IO.
  */
@@ -76,6 +76,10 @@
 	#include "../portable/portmacro.h"
 #endif
 
+#ifdef GCC_POSIX
+	#include "../portable/POSIX/portmacro.h"
+#endif
+
 #include "projdefs.h"
 
 
@@ -139,6 +143,72 @@ void vPortFree( void *pv ) PRIVILEGED_FUNCTION;
 void vPortInitialiseBlocks( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Used with vPortGetHeapStats() to return the state of the heap.  Only the
+ * heap implementations that keep these figures provide vPortGetHeapStats().
+ */
+typedef struct xHEAP_STATS
+{
+	size_t xFreeBytes;					/* The number of bytes not allocated to the application, as returned by xPortGetFreeHeapSize(). */
+	size_t xMinimumEverFreeBytes;		/* The lowest value xFreeBytes has had since the heap was initialised. */
+	size_t xLargestFreeBlock;			/* The largest single request that can be met. */
+	size_t xNumberOfFreeBlocks;			/* The number of separate free blocks that make up xFreeBytes. */
+	unsigned char ucFragmentation;		/* The percentage of xFreeBytes that is not in the largest free block. */
+} xHeapStatsType;
+
+void vPortGetHeapStats( xHeapStatsType *pxHeapStats ) PRIVILEGED_FUNCTION;
+
+/*
+ * Used with xPortGetHeapTraceEvent() to return the recent pvPortMalloc() and
+ * vPortFree() calls recorded by heap_2.c and heap_4.c when configUSE_HEAP_TRACE
+ * is 1.
+ */
+#define heapTRACE_MALLOC		( ( unsigned char ) 'M' )	/* pvPortMalloc() returned pvAddress. */
+#define heapTRACE_FREE			( ( unsigned char ) 'F' )	/* vPortFree() was passed pvAddress. */
+#define heapTRACE_FAILED		( ( unsigned char ) 'X' )	/* pvPortMalloc() returned NULL. */
+
+typedef struct xHEAP_TRACE_EVENT
+{
+	void *pvAddress;					/* The block allocated or freed, NULL for a failed allocation. */
+	void *pvCaller;						/* The return address of the pvPortMalloc() or vPortFree() call.  On the AVR this is a word address. */
+	size_t xSize;						/* The bytes requested, or for a free the bytes the block could hold. */
+	portTickType xTime;					/* The tick count when the call was made. */
+	unsigned short usSequence;			/* Counts every event, so gaps show events that have been overwritten. */
+	unsigned char ucEvent;				/* heapTRACE_MALLOC, heapTRACE_FREE or heapTRACE_FAILED. */
+} xHeapTraceEvent;
+
+portBASE_TYPE xPortGetHeapTraceEvent( unsigned portBASE_TYPE uxIndex, xHeapTraceEvent *pxEvent ) PRIVILEGED_FUNCTION;
+
+/*
+ * Used with uxPortGetHeapClassStats() to return the state of each size class
+ * of heap_5.c.
+ */
+typedef struct xHEAP_CLASS_STATS
+{
+	size_t xRequestSize;				/* The largest request served from this class, in bytes. */
+	unsigned short usInUse;				/* The number of blocks of this class allocated to the application. */
+	unsigned short usHighWaterMark;		/* The highest value usInUse has had. */
+	unsigned short usFree;				/* The number of blocks on the free list of this class. */
+} xHeapClassStatsType;
+
+unsigned portBASE_TYPE uxPortGetHeapClassStats( xHeapClassStatsType *pxClassStats, unsigned portBASE_TYPE uxArraySize ) PRIVILEGED_FUNCTION;
+size_t xPortHeapPrimeClass( size_t xWantedSize, size_t xCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Used with vPortDefineHeapRegions() to describe the memory regions used by
+ * heap_6.c.  The array is listed fastest memory first, and ends with an entry
+ * that has an xSizeInBytes of 0.
+ */
+typedef struct xHEAP_REGION
+{
+	unsigned char *pucStartAddress;		/* The first byte of the region. */
+	size_t xSizeInBytes;				/* The size of the region. */
+} xHeapRegion;
+
+void vPortDefineHeapRegions( const xHeapRegion * const pxHeapRegions ) PRIVILEGED_FUNCTION;
+void *pvPortMallocRegion( size_t xSize, unsigned portBASE_TYPE uxRegion ) PRIVILEGED_FUNCTION;
+size_t xPortGetRegionFreeHeapSize( unsigned portBASE_TYPE uxRegion ) PRIVILEGED_FUNCTION;
+
 /*
  * Setup the hardware ready for the scheduler to take control.  This generally
  * sets up a tick interrupt and sets timers for the correct tick frequency.
@@ -109,6 +109,42 @@ typedef void * xQueueSetMemberHandle;
 #define queueQUEUE_TYPE_BINARY_SEMAPHORE	( ( unsigned char ) 3U )
 #define queueQUEUE_TYPE_RECURSIVE_MUTEX		( ( unsigned char ) 4U )
 
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	#include "list.h"
+
+	/*
+	 * Storage for a queue, semaphore or mutex created with one of the Static
+	 * creation functions.  The members are not for use by the application; the
+	 * structure only has the same size and alignment as the xQUEUE structure in
+	 * queue.c, so a queue can be allocated at link time without exposing its
+	 * definition.
+	 */
+	typedef struct xSTATIC_QUEUE
+	{
+		void *pvDummy1[ 3 ];
+		union
+		{
+			void *pvDummy2;
+			unsigned portBASE_TYPE uxDummy2;
+		} u;
+		xList xDummy3[ 2 ];
+		unsigned portBASE_TYPE uxDummy4[ 3 ];
+		signed portBASE_TYPE xDummy5[ 2 ];
+		#if ( configUSE_TRACE_FACILITY == 1 )
+			unsigned char ucDummy6[ 2 ];
+		#endif
+		#if ( configUSE_QUEUE_SETS == 1 )
+			void *pvDummy7;
+		#endif
+		#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+			unsigned char ucDummy8;
+		#endif
+		unsigned char ucDummy9;
+	} xStaticQueue;
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+
 /**
  * queue. h
  * <pre>
@@ -167,6 +203,58 @@ typedef void * xQueueSetMemberHandle;
  */
 #define xQueueCreate( uxQueueLength, uxItemSize ) xQueueGenericCreate( uxQueueLength, uxItemSize, queueQUEUE_TYPE_BASE )
 
+/**
+ * queue. h
+ * <pre>
+ xQueueHandle xQueueCreateStatic(
+							  unsigned portBASE_TYPE uxQueueLength,
+							  unsigned portBASE_TYPE uxItemSize,
+							  unsigned char *pucQueueStorage,
+							  xStaticQueue *pxQueueBuffer
+						  );
+ * </pre>
+ *
+ * Creates a new queue instance using memory supplied by the caller, rather
+ * than allocated from the FreeRTOS heap.
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * this macro to be available.
+ *
+ * @param uxQueueLength The maximum number of items that the queue can contain.
+ *
+ * @param uxItemSize The number of bytes each item in the queue will require.
+ *
+ * @param pucQueueStorage An array of at least uxQueueLength * uxItemSize
+ * bytes, into which items are copied.  Unlike xQueueCreate(), no extra byte
+ * is needed.
+ *
+ * @param pxQueueBuffer A variable of type xStaticQueue, which holds the queue
+ * structure.
+ *
+ * Both buffers must exist for as long as the queue does.  vQueueDelete() does
+ * not free them.
+ *
+ * @return The handle of the created queue, or NULL if pxQueueBuffer was NULL.
+ *
+ * Example usage:
+   <pre>
+ #define QUEUE_LENGTH 10
+
+ static unsigned char ucQueueStorage[ QUEUE_LENGTH * sizeof( unsigned long ) ];
+ static xStaticQueue xQueueBuffer;
+
+ void vATask( void *pvParameters )
+ {
+ xQueueHandle xQueue;
+
+	xQueue = xQueueCreateStatic( QUEUE_LENGTH, sizeof( unsigned long ), ucQueueStorage, &xQueueBuffer );
+ }
+ </pre>
+ * \defgroup xQueueCreateStatic xQueueCreateStatic
+ * \ingroup QueueManagement
+ */
+#define xQueueCreateStatic( uxQueueLength, uxItemSize, pucQueueStorage, pxQueueBuffer ) xQueueGenericCreateStatic( ( uxQueueLength ), ( uxItemSize ), ( pucQueueStorage ), ( pxQueueBuffer ), queueQUEUE_TYPE_BASE )
+
 /**
  * queue. h
  * <pre>
@@ -443,7 +531,9 @@ typedef void * xQueueSetMemberHandle;
  * @return xQueueOverwrite() is a macro that calls xQueueGenericSend(), and
  * therefore has the same return values as xQueueSendToFront().  However, pdPASS
  * is the only value that can be returned because xQueueOverwrite() will write
- * to the queue even when the queue is already full.
+ * to the queue even when the queue is already full, unless the item in the
+ * queue is held by pvQueuePeekInPlace() or a slot is reserved by
+ * pvQueueReserve().
  *
  * Example usage:
    <pre>
@@ -1517,6 +1607,14 @@ portBASE_TYPE xQueueGiveMutexRecursive( xQueueHandle pxMutex ) PRIVILEGED_FUNCTI
  */
 xQueueHandle xQueueGenericCreate( unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, unsigned char ucQueueType ) PRIVILEGED_FUNCTION;
 
+/*
+ * Generic version of the static queue creation function, which is in turn
+ * called by xQueueCreateStatic() and xSemaphoreCreateBinaryStatic().
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	xQueueHandle xQueueGenericCreateStatic( unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, unsigned char *pucQueueStorage, xStaticQueue *pxStaticQueue, unsigned char ucQueueType ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Queue sets provide a mechanism to allow a task to block (pend) on a read
  * operation from multiple queues or semaphores simultaneously.
@@ -1651,6 +1749,86 @@ xQueueSetMemberHandle xQueueSelectFromSet( xQueueSetHandle xQueueSet, portTickTy
  */
 xQueueSetMemberHandle xQueueSelectFromSetFromISR( xQueueSetHandle xQueueSet ) PRIVILEGED_FUNCTION;
 
+/*
+ * Zero copy queue access, for queues of large items.  Available when
+ * configUSE_QUEUE_ZERO_COPY is set to 1 in FreeRTOSConfig.h.
+ *
+ * pvQueueReserve() blocks, as xQueueSend() would, until there is space in the
+ * queue, then returns a pointer to the next free slot in the queue storage
+ * area.  The item is built directly in that slot and then made available to
+ * receivers with xQueueCommit().  Until the commit the queue is full to every
+ * other sender, so only one slot can be reserved at a time, and
+ * xQueueOverwrite() and xQueueOverwriteFromISR() return errQUEUE_FULL.
+ *
+ * pvQueuePeekInPlace() blocks, as xQueuePeek() would, until the queue holds an
+ * item, then returns a pointer to the item at the head of the queue without
+ * removing it.  The item is read in place and then removed with
+ * xQueueRelease().  It stays in the queue until it is released, so it cannot
+ * be overwritten while it is being read.  There must be only one task (or
+ * interrupt) reading the queue in place.  While an item is held,
+ * xQueueSendToFront() blocks until it is released, as it would write where
+ * the item is, and xQueueOverwrite() and the FromISR() versions of both
+ * return errQUEUE_FULL.
+ *
+ * Items queued with pvQueueReserve() can be received with xQueueReceive(), and
+ * items sent with xQueueSend() can be read with pvQueuePeekInPlace().
+ *
+ * @param xQueue The handle of the queue.  Semaphores and mutexes have no item
+ * storage, so cannot be used.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block waiting
+ * for space (reserve) or for an item (peek).
+ *
+ * @return pvQueueReserve() and pvQueuePeekInPlace() return a pointer into the
+ * queue storage area, or NULL if the block time expired.  xQueueCommit() and
+ * xQueueRelease() return pdPASS, or pdFAIL if there was no reserved slot or
+ * no item to release.
+ *
+ * Example usage:
+   <pre>
+ struct AMessage
+ {
+	portCHAR ucMessageID;
+	portCHAR ucData[ 32 ];
+ };
+
+ void vProducer( void *pvParameters )
+ {
+ struct AMessage *pxMessage;
+
+	pxMessage = ( struct AMessage * ) pvQueueReserve( xQueue, portMAX_DELAY );
+	pxMessage->ucMessageID = 1;
+	vFillData( pxMessage->ucData );
+	xQueueCommit( xQueue );
+ }
+
+ void vConsumer( void *pvParameters )
+ {
+ struct AMessage *pxMessage;
+
+	pxMessage = ( struct AMessage * ) pvQueuePeekInPlace( xQueue, portMAX_DELAY );
+	vUseData( pxMessage->ucData );
+	xQueueRelease( xQueue );
+ }
+ </pre>
+ */
+void *pvQueueReserve( xQueueHandle xQueue, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+signed portBASE_TYPE xQueueCommit( xQueueHandle xQueue ) PRIVILEGED_FUNCTION;
+void *pvQueuePeekInPlace( xQueueHandle xQueue, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+signed portBASE_TYPE xQueueRelease( xQueueHandle xQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Versions of the zero copy functions that can be used from an ISR.  The
+ * reserve and peek functions do not block, and return NULL if there is no
+ * space or no item.  The commit and release functions set
+ * *pxHigherPriorityTaskWoken to pdTRUE if a task with a higher priority than
+ * the interrupted task was unblocked, as xQueueSendFromISR() does.
+ */
+void *pvQueueReserveFromISR( xQueueHandle xQueue ) PRIVILEGED_FUNCTION;
+signed portBASE_TYPE xQueueCommitFromISR( xQueueHandle xQueue, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+void *pvQueuePeekInPlaceFromISR( xQueueHandle xQueue ) PRIVILEGED_FUNCTION;
+signed portBASE_TYPE xQueueReleaseFromISR( xQueueHandle xQueue, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /* Not public API functions. */
 void vQueueWaitForMessageRestricted( xQueueHandle xQueue, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
 portBASE_TYPE xQueueGenericReset( xQueueHandle xQueue, portBASE_TYPE xNewQueue ) PRIVILEGED_FUNCTION;
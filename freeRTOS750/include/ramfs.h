@@ -71,6 +71,9 @@ extern "C" {
 											// Measured maximum value with no other tasks competing is 31us.
 											// Also delay period before signalling, holding SS high. Needed to ensure the Client, requesting
 											// repeat service immediately, waits long enough for the Supervisor interrupt to be properly set.
+#define RAMFS_TRACE_CLIENT_CALL		0x01	// vTraceUserEvent() code recorded by the SS pin change interrupts, when configUSE_TRACE_RECORDER is 1.
+											// The value is the SS lines seen low. A Client pulse interrupts twice, so a 0 without a non zero value
+											// before it is a pulse that had ended before the interrupt ran. tools/trace_decode.py counts these.
 
 #define WAIT_FOR_SPIF				!(SPSR & _BV(SPIF))			// Wait for SPIF, and
 #define CHECK_FOR_MY_SS				(SPI_PORT_PIN & SPI_BIT_SS)	// check we still have SS low (we're selected). Use this everywhere for SPI wait loop.
@@ -73,6 +73,10 @@
 
 typedef xQueueHandle xSemaphoreHandle;
 
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	typedef xStaticQueue xStaticSemaphore;
+#endif
+
 #define semBINARY_SEMAPHORE_QUEUE_LENGTH	( ( unsigned char ) 1U )
 #define semSEMAPHORE_QUEUE_ITEM_LENGTH		( ( unsigned char ) 0U )
 #define semGIVE_BLOCK_TIME					( ( portTickType ) 0U )
@@ -125,6 +129,44 @@ typedef xQueueHandle xSemaphoreHandle;
 		}																																		\
 	}
 
+/**
+ * semphr. h
+ * <pre>xSemaphoreHandle xSemaphoreCreateBinaryStatic( xStaticSemaphore *pxSemaphoreBuffer )</pre>
+ *
+ * Creates a binary semaphore in memory supplied by the caller, rather than
+ * allocated from the FreeRTOS heap.  A semaphore has no storage area, so the
+ * xStaticSemaphore variable is the only memory it uses.
+ *
+ * Unlike vSemaphoreCreateBinary(), the semaphore is created empty, so it must
+ * be given before it can be taken.  This suits the common case of an
+ * interrupt giving the semaphore to unblock a task.
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * this macro to be available.
+ *
+ * @param pxSemaphoreBuffer A variable of type xStaticSemaphore, which must
+ * exist for as long as the semaphore does.  vSemaphoreDelete() does not free
+ * it.
+ *
+ * @return The handle of the semaphore, or NULL if pxSemaphoreBuffer was NULL.
+ *
+ * Example usage:
+ <pre>
+ static xStaticSemaphore xSemaphoreBuffer;
+
+ void vATask( void * pvParameters )
+ {
+ xSemaphoreHandle xSemaphore;
+
+    xSemaphore = xSemaphoreCreateBinaryStatic( &xSemaphoreBuffer );
+    xSemaphoreGive( xSemaphore );
+ }
+ </pre>
+ * \defgroup xSemaphoreCreateBinaryStatic xSemaphoreCreateBinaryStatic
+ * \ingroup Semaphores
+ */
+#define xSemaphoreCreateBinaryStatic( pxSemaphoreBuffer ) xQueueGenericCreateStatic( ( unsigned portBASE_TYPE ) 1, semSEMAPHORE_QUEUE_ITEM_LENGTH, NULL, ( pxSemaphoreBuffer ), queueQUEUE_TYPE_BINARY_SEMAPHORE )
+
 /**
  * semphr. h
  * <pre>xSemaphoreTake( 
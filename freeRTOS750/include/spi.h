@@ -20,6 +20,57 @@ extern "C" {
 
 #define SPI_TIMEOUT 1000		// Timeout to get access to SPI bus in mS
 
+/*
+ * Interrupt driven transfers.
+ *
+ * With SPI_ASYNC set to 1 a long transfer is moved one byte per SPI_STC
+ * interrupt, while the calling task blocks, so lower priority tasks run
+ * during the transfer. Each byte costs an interrupt of about 60 CPU cycles,
+ * so this only frees the CPU when a byte takes much longer than that.
+ * spiMultiByteTx(), spiMultiByteRx() and spiMultiByteTransfer() look at the
+ * current SPI clock, and use the interrupt path only if a byte takes at least
+ * SPI_ASYNC_MIN_BYTE_CYCLES, and the whole transfer at least
+ * SPI_ASYNC_MIN_CYCLES (enough to pay for blocking and waking the task).
+ * Shorter or faster transfers, including SPI_CLOCK_DIV2 to DIV8, stay polled.
+ * lib_spi then owns ISR(SPI_STC_vect), and spiAttachInterrupt() is used by
+ * the transfers, so it is off by default. Set it to 1 in the project's
+ * defines where no other code handles the SPI interrupt (such as SPI slave
+ * mode) and a slow device is on the bus.
+ */
+#ifndef SPI_ASYNC
+#define SPI_ASYNC 0
+#endif
+#define SPI_ASYNC_MIN_BYTE_CYCLES	128		// SPI_CLOCK_DIV16 or slower.
+#define SPI_ASYNC_MIN_CYCLES		4000	// 250us at 16MHz, 32 bytes at SPI_CLOCK_DIV16.
+
+/*
+ * Assembler transfers at SPI_CLOCK_DIV2.
+ *
+ * With SPI_ASM_DIV2 set to 1, spiMultiByteTx(), spiMultiByteRx(),
+ * spiMultiByteTransfer(), spiMultiByteTxCRC16() and spiTransaction() use
+ * cycle counted loops when the SPI module is at SPI_CLOCK_DIV2, sending a
+ * byte every 18 CPU cycles (1.125us at 16MHz) rather than polling SPIF, or
+ * every 19 cycles when receiving.
+ */
+#ifndef SPI_ASM_DIV2
+#define SPI_ASM_DIV2 1
+#endif
+
+/*
+ * Bus statistics.
+ *
+ * With SPI_STATS set to 1 each device (SPI_SLAVE_SELECT) keeps count of the
+ * time its tasks wait in spiSelect(), spiTakeBus() or spiTransaction() for
+ * the bus, the waits that end in SPI_TIMEOUT, and the times it holds the bus
+ * and the bytes it moves while it does, so the share each device takes of a
+ * bus can be weighed against its clock divider. See spiGetStats(), and
+ * xSerialxPrintSPIStats() in lib_serial. Times are counted by the run time
+ * stats timer, so configGENERATE_RUN_TIME_STATS must be 1.
+ */
+#ifndef SPI_STATS
+#define SPI_STATS 0
+#endif
+
 #define SPI_CLOCK_DIV4   0x00
 #define SPI_CLOCK_DIV16  0x01
 #define SPI_CLOCK_DIV64  0x02
@@ -46,8 +97,57 @@ typedef enum {
 	SDCard,			/* SD Card */
 	Default			/* Default for the Board */
 					/* Add additional SS lines as necessary, and to spi.c */
+					/* and to the names in xSerialxPrintSPIStats() */
 } SPI_SLAVE_SELECT;
 
+/*
+ * Second and further SPI buses, on a USART in Master SPI Mode (MSPIM).
+ *
+ * With SPI_USART_BUS set to 1, spiBindBus() moves a device off the SPI module
+ * onto USART1, 2 or 3, each bus with its own semaphore, so a task using that
+ * device doesn't wait on tasks using the devices left on the SPI module.
+ * TXD is MOSI, RXD is MISO and XCK is SCK (see freeRTOSBoardDefs.h), and the
+ * device keeps its own SS line. lib_serial can't use a USART bound here.
+ *
+ * spiSelect(), spiDeselect() and spiTransaction() use the bus the device is
+ * bound to. The calls that don't name a device, spiSetClockDivider() through
+ * spiMultiByteTransfer(), go to the bus the calling task took most recently,
+ * or to the SPI module if it holds none. Drivers that write SPDR themselves,
+ * as the Wiznet drivers do, must stay on the SPI module. Transfers on a USART
+ * bus are always polled; the transmitter's double buffer keeps it busy.
+ */
+#ifndef SPI_USART_BUS
+#define SPI_USART_BUS 0
+#endif
+
+#if (SPI_USART_BUS == 1)
+
+typedef enum {
+	SPI_BUS_SPI,		/* The SPI module, where every device starts */
+#if defined(UBRR1)
+	SPI_BUS_USART1,
+#endif
+#if defined(UBRR2)
+	SPI_BUS_USART2,
+#endif
+#if defined(UBRR3)
+	SPI_BUS_USART3,
+#endif
+	SPI_BUSES
+} SPI_BUS;
+
+#if !defined(UBRR1)
+#error SPI_USART_BUS needs a USART other than USART0, which is the serial console.
+#endif
+
+/*
+ * Binds a device to a bus. Call it before spiBegin() for the device, which
+ * then sets up the USART as well as the SPI module.
+ */
+void spiBindBus(SPI_SLAVE_SELECT SS_pin, SPI_BUS bus);
+
+#endif
+
 void spiSetClockDivider(uint8_t rate);
 void spiSetBitOrder(uint8_t bitOrder);
 void spiSetDataMode(uint8_t mode);
@@ -58,6 +158,15 @@ void spiDetachInterrupt();
 uint8_t spiSelect (SPI_SLAVE_SELECT SS_pin);
 void spiDeselect (SPI_SLAVE_SELECT SS_pin);
 
+/*
+ * Take and give the bus the device is on, without changing its SS line, for
+ * transfers made with the device deselected (such as the SD card's power up
+ * clocks). spiSelect() and spiDeselect() do this too.
+ * spiTakeBus() returns 1 if the bus was taken, 0 on timeout.
+ */
+uint8_t spiTakeBus (SPI_SLAVE_SELECT SS_pin);
+void spiGiveBus (SPI_SLAVE_SELECT SS_pin);
+
 void spiBegin(SPI_SLAVE_SELECT SS_pin);
 
 void spiEnd();
@@ -82,6 +191,106 @@ uint8_t spiMultiByteRx(uint8_t *data, const uint16_t length);
 
 uint8_t spiMultiByteTransfer(uint8_t *data, const uint16_t length);
 
+/*
+ * As spiMultiByteTx(), and updates *crc with the CRC16-CCITT (polynomial
+ * 0x1021, as SD card data blocks and crc16_ccitt() use) of the bytes sent,
+ * worked out while each byte goes. Start *crc at 0 for a new block.
+ * SPI module only; returns 0 on a USART bus.
+ */
+uint8_t spiMultiByteTxCRC16(const uint8_t *data, const uint16_t length, uint16_t *crc);
+
+/*
+ * One part of a transaction: the device is selected with its own mode and
+ * clock divider, length bytes are exchanged, and the device is deselected.
+ * If txData is NULL 0xFF is sent, and if rxData is NULL the received bytes
+ * are discarded. txData and rxData may point to the same buffer.
+ */
+typedef struct
+{
+	SPI_SLAVE_SELECT SS_pin;
+	uint8_t mode;			// SPI_MODE0 to SPI_MODE3
+	uint8_t divider;		// SPI_CLOCK_DIV2 to SPI_CLOCK_DIV128
+	const uint8_t *txData;
+	uint8_t *rxData;
+	uint16_t length;
+} SPI_SEGMENT;
+
+/*
+ * Runs count segments, in order, holding the SPI bus for all of them, so the
+ * bus semaphore is taken and given once rather than once per segment. SPCR
+ * and SPSR are only written when a segment needs a different mode or clock
+ * from the one before. Suits register polling, where each access is a few
+ * bytes and the select and semaphore overhead is most of the cost.
+ * Returns 1 if every segment completed, 0 on a bus timeout, or if the SPI
+ * module is not enabled as master, when the rest of the segments are skipped.
+ * With SPI_USART_BUS every segment must be on the bus of the first one, and
+ * a segment on another bus fails.
+ */
+uint8_t spiTransaction(const SPI_SEGMENT *segments, const uint8_t count);
+
+#if (SPI_STATS == 1)
+
+/*
+ * A device's bus statistics, since they were last reset. Times are in run
+ * time counter counts (portRUN_TIME_COUNTER_HZ, 16us at 16MHz), so a single
+ * short hold may count as 0 or 1, but the totals over many even out.
+ * Only the bytes moved through lib_spi calls while the device holds its bus
+ * are counted, not those a driver writes to SPDR itself. In spiTransaction()
+ * each segment counts as one hold by its own device, and the wait is counted
+ * against the device of the first segment.
+ */
+typedef struct
+{
+	uint32_t bytes;				// bytes exchanged while holding the bus
+	uint32_t transactions;		// times the bus was held
+	uint32_t holdTime;			// total time holding the bus
+	uint32_t maxHoldTime;
+	uint32_t waitTime;			// total time waiting for the bus, timeouts included
+	uint32_t maxWaitTime;
+	uint16_t timeouts;			// waits that gave up after SPI_TIMEOUT
+	uint32_t since;				// run time counter when the figures were last reset
+} SPI_STATISTICS;
+
+/*
+ * Copies a device's statistics into *stats, and if reset is 1 starts them
+ * again, so the next call covers only the time since this one.
+ */
+void spiGetStats(SPI_SLAVE_SELECT SS_pin, SPI_STATISTICS *stats, uint8_t reset);
+
+#endif
+
+#if (SPI_ASYNC == 1)
+
+/*
+ * A transfer for the interrupt driven engine. If txData is NULL 0xFF is
+ * sent, and if rxData is NULL the received bytes are discarded. txData and
+ * rxData may point to the same buffer.
+ */
+typedef struct
+{
+	const uint8_t *txData;
+	uint8_t *rxData;
+	uint16_t length;
+} SPI_TRANSFER;
+
+/*
+ * Starts a transfer, on the interrupt path whatever the SPI clock, and
+ * returns without waiting for it. The device must already be selected, and
+ * the transfer must not be changed until spiAsyncWait() returns.
+ * Returns 1 if the transfer was started, 0 if the SPI module is not enabled
+ * as master, or the length is 0.
+ */
+uint8_t spiAsyncStart(const SPI_TRANSFER *transfer);
+
+/*
+ * Blocks the calling task until the transfer started by spiAsyncStart()
+ * completes, for up to SPI_TIMEOUT.
+ * Returns 1 if it completed, 0 on timeout, when the transfer is abandoned.
+ */
+uint8_t spiAsyncWait(void);
+
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,180 @@
+/*
+    FreeRTOS V7.5.0 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Stream and message buffers.
+ *
+ * A stream buffer carries a stream of bytes from exactly one sender (a task
+ * or an interrupt) to exactly one receiver (a task or an interrupt).  A
+ * message buffer is a stream buffer that carries variable length messages
+ * instead, each one written and read as a whole.
+ *
+ * The sender only ever moves the head index and the receiver only ever moves
+ * the tail index, so no lock is needed around the data.  An interrupt can
+ * write or read without a critical section.  On the AVR an index is 16 bits,
+ * so a task takes a two instruction critical section to load or store one
+ * that an interrupt may be using.
+ *
+ * A task can block on either end.  A receiving task is unblocked when the
+ * number of bytes in a stream buffer reaches its trigger level, or when a
+ * whole message is in a message buffer, so an interrupt fed buffer wakes the
+ * task once per frame rather than once per byte.
+ *
+ * There must only be one sender and one receiver.  If more than one task
+ * writes to (or reads from) the same buffer, the calls must be serialised, for
+ * example with a mutex.
+ */
+
+#ifndef STREAM_BUFFER_H
+#define STREAM_BUFFER_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include stream_buffer.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Type by which stream buffers are referenced.  For example, a call to
+ * xStreamBufferCreate() returns an xStreamBufferHandle variable that can then
+ * be used as a parameter to xStreamBufferSend(), xStreamBufferReceive(), etc.
+ */
+typedef void * xStreamBufferHandle;
+
+/**
+ * Message buffers are stream buffers, so share the same handle type and
+ * functions.
+ */
+typedef xStreamBufferHandle xMessageBufferHandle;
+
+/*
+ * Creates a stream buffer.
+ *
+ * @param xBufferSizeBytes The size of the storage area, in bytes.  One byte
+ * is kept free to tell a full buffer from an empty one, so the buffer holds
+ * up to xBufferSizeBytes - 1 bytes.
+ *
+ * @param xTriggerLevelBytes The number of bytes that must be in the buffer
+ * before a task blocked waiting for data is unblocked.  A value of 0 is
+ * treated as 1.
+ *
+ * @return The handle of the stream buffer, or NULL if there was not enough
+ * heap for it.
+ */
+#define xStreamBufferCreate( xBufferSizeBytes, xTriggerLevelBytes )	xStreamBufferGenericCreate( ( xBufferSizeBytes ), ( xTriggerLevelBytes ), pdFALSE )
+
+/*
+ * Creates a message buffer.  Each message is stored with a sizeof( size_t )
+ * length in front of it, so a message buffer needs xBufferSizeBytes larger
+ * than the largest message by at least sizeof( size_t ) + 1.
+ *
+ * @return The handle of the message buffer, or NULL if there was not enough
+ * heap for it.
+ */
+#define xMessageBufferCreate( xBufferSizeBytes )					xStreamBufferGenericCreate( ( xBufferSizeBytes ), ( size_t ) 1, pdTRUE )
+
+/*
+ * Sends bytes to a stream buffer, or one message to a message buffer.
+ *
+ * A stream buffer send copies as many bytes as there is space for, then
+ * blocks for up to xTicksToWait for space for the rest.  A message buffer
+ * send blocks for up to xTicksToWait for space for the whole message, and
+ * writes either all of it or none of it.
+ *
+ * @return The number of bytes written.
+ */
+size_t xStreamBufferSend( xStreamBufferHandle xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * A version of xStreamBufferSend() that can be used from an ISR.  It does not
+ * block, and does not enter a critical section.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if the send unblocked a task
+ * with a higher priority than the interrupted task, in which case a context
+ * switch should be requested before the interrupt exits.
+ *
+ * @return The number of bytes written.
+ */
+size_t xStreamBufferSendFromISR( xStreamBufferHandle xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Receives bytes from a stream buffer, or one message from a message buffer.
+ *
+ * If the buffer is empty the task blocks for up to xTicksToWait, until the
+ * trigger level (stream buffer) or a whole message (message buffer) is
+ * available.  A stream buffer receive returns whatever is in the buffer, up
+ * to xBufferLengthBytes.  A message buffer receive returns one message, and
+ * leaves a message that is larger than xBufferLengthBytes in the buffer.
+ *
+ * @return The number of bytes read, which is 0 if the block time expired.
+ */
+size_t xStreamBufferReceive( xStreamBufferHandle xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * A version of xStreamBufferReceive() that can be used from an ISR.  It does
+ * not block, and does not enter a critical section.
+ */
+size_t xStreamBufferReceiveFromISR( xStreamBufferHandle xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * The number of bytes in the buffer, and the space left.  For a message
+ * buffer these include the length stored with each message.
+ */
+size_t xStreamBufferBytesAvailable( xStreamBufferHandle xStreamBuffer ) PRIVILEGED_FUNCTION;
+size_t xStreamBufferSpacesAvailable( xStreamBufferHandle xStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Changes the trigger level of a stream buffer.
+ *
+ * @return pdPASS, or pdFAIL if the trigger level is larger than the buffer
+ * can hold.
+ */
+portBASE_TYPE xStreamBufferSetTriggerLevel( xStreamBufferHandle xStreamBuffer, size_t xTriggerLevelBytes ) PRIVILEGED_FUNCTION;
+
+/*
+ * Empties the buffer.  It must not be called while a task is blocked on it.
+ */
+void vStreamBufferReset( xStreamBufferHandle xStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Deletes the buffer, and frees its memory.
+ */
+void vStreamBufferDelete( xStreamBufferHandle xStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/* The message buffer API is the stream buffer API. */
+#define xMessageBufferSend( xMessageBuffer, pvTxData, xDataLengthBytes, xTicksToWait )	xStreamBufferSend( ( xMessageBuffer ), ( pvTxData ), ( xDataLengthBytes ), ( xTicksToWait ) )
+#define xMessageBufferSendFromISR( xMessageBuffer, pvTxData, xDataLengthBytes, pxHigherPriorityTaskWoken )	xStreamBufferSendFromISR( ( xMessageBuffer ), ( pvTxData ), ( xDataLengthBytes ), ( pxHigherPriorityTaskWoken ) )
+#define xMessageBufferReceive( xMessageBuffer, pvRxData, xBufferLengthBytes, xTicksToWait )	xStreamBufferReceive( ( xMessageBuffer ), ( pvRxData ), ( xBufferLengthBytes ), ( xTicksToWait ) )
+#define xMessageBufferReceiveFromISR( xMessageBuffer, pvRxData, xBufferLengthBytes, pxHigherPriorityTaskWoken )	xStreamBufferReceiveFromISR( ( xMessageBuffer ), ( pvRxData ), ( xBufferLengthBytes ), ( pxHigherPriorityTaskWoken ) )
+#define vMessageBufferReset( xMessageBuffer )		vStreamBufferReset( xMessageBuffer )
+#define vMessageBufferDelete( xMessageBuffer )		vStreamBufferDelete( xMessageBuffer )
+
+/* Not public API functions. */
+xStreamBufferHandle xStreamBufferGenericCreate( size_t xBufferSizeBytes, size_t xTriggerLevelBytes, portBASE_TYPE xIsMessageBuffer ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STREAM_BUFFER_H */
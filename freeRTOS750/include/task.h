@@ -149,6 +149,7 @@ typedef struct xTASK_STATUS
 	unsigned portBASE_TYPE uxBasePriority;		/* The priority to which the task will return if the task's current priority has been inherited to avoid unbounded priority inversion when obtaining a mutex.  Only valid if configUSE_MUTEXES is defined as 1 in FreeRTOSConfig.h. */
 	unsigned long ulRunTimeCounter;				/* The total run time allocated to the task so far, as defined by the run time stats clock.  See http://www.freertos.org/rtos-run-time-stats.html.  Only valid when configGENERATE_RUN_TIME_STATS is defined as 1 in FreeRTOSConfig.h. */
 	unsigned short usStackHighWaterMark;		/* The minimum amount of stack space that has remained for the task since the task was created.  The closer this value is to zero the closer the task has come to overflowing its stack. */
+	unsigned short usStackDepth;				/* The size of the task's stack, in words, as passed to xTaskCreate().  Only valid if configUSE_STACK_REPORT is defined as 1 in FreeRTOSConfig.h, otherwise 0. */
 } xTaskStatusType;
 
 /* Possible return values for eTaskConfirmSleepModeStatus(). */
@@ -159,6 +160,57 @@ typedef enum
 	eNoTasksWaitingTimeout	/* No tasks are waiting for a timeout so it is safe to enter a sleep mode that can only be exited by an external interrupt. */
 } eSleepModeStatus;
 
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	/*
+	 * Storage for the TCB of a task created with xTaskCreateStatic().  The
+	 * members are not for use by the application; the structure only has the
+	 * same size and alignment as the TCB in tasks.c, so the TCB can be
+	 * allocated at link time without exposing its definition.
+	 */
+	typedef struct xSTATIC_TCB
+	{
+		void *pvDummy1;
+		#if ( portUSING_MPU_WRAPPERS == 1 )
+			xMPU_SETTINGS xDummy2;
+		#endif
+		xListItem xDummy3[ 2 ];
+		unsigned portBASE_TYPE uxDummy4;
+		void *pvDummy5;
+		signed char ucDummy6[ configMAX_TASK_NAME_LEN ];
+		#if ( ( portSTACK_GROWTH > 0 ) || ( configUSE_STACK_REPORT == 1 ) )
+			void *pvDummy7;
+		#endif
+		#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+			unsigned portBASE_TYPE uxDummy8;
+		#endif
+		#if ( configUSE_TRACE_FACILITY == 1 )
+			unsigned portBASE_TYPE uxDummy9[ 2 ];
+		#endif
+		#if ( configUSE_MUTEXES == 1 )
+			unsigned portBASE_TYPE uxDummy10;
+		#endif
+		#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+			pdTASK_HOOK_CODE pxDummy11;
+		#endif
+		#if ( configGENERATE_RUN_TIME_STATS == 1 )
+			unsigned long ulDummy12;
+		#endif
+		#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+			unsigned long ulDummy13;
+			unsigned char ucDummy14;
+		#endif
+		#if ( configUSE_TASK_MEMORY_BANKS == 1 )
+			unsigned char ucDummy15;
+		#endif
+		unsigned char ucDummy16;
+		#if ( configUSE_NEWLIB_REENTRANT == 1 )
+			struct _reent xDummy17;
+		#endif
+	} xStaticTask;
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+
 
 /*
  * Defines the priority used by the idle task.  This must not be modified.
@@ -312,6 +364,58 @@ typedef enum
  */
 #define xTaskCreate( pvTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask ) xTaskGenericCreate( ( pvTaskCode ), ( pcName ), ( usStackDepth ), ( pvParameters ), ( uxPriority ), ( pxCreatedTask ), ( NULL ), ( NULL ) )
 
+/**
+ * task. h
+ *<pre>
+ xTaskHandle xTaskCreateStatic(
+							  pdTASK_CODE pvTaskCode,
+							  const signed char * const pcName,
+							  unsigned short usStackDepth,
+							  void *pvParameters,
+							  unsigned portBASE_TYPE uxPriority,
+							  portSTACK_TYPE *puxStackBuffer,
+							  xStaticTask *pxTaskBuffer
+						  );</pre>
+ *
+ * Create a new task using a TCB and stack supplied by the caller, rather
+ * than allocated from the FreeRTOS heap.  Both buffers are normally static
+ * variables, so the memory used by the task is fixed at link time.
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * @param puxStackBuffer An array of at least usStackDepth portSTACK_TYPE
+ * variables, which is used as the stack of the task.
+ *
+ * @param pxTaskBuffer A variable of type xStaticTask, which holds the TCB
+ * of the task.
+ *
+ * The other parameters are as for xTaskCreate().  Both buffers must exist
+ * for as long as the task does.  vTaskDelete() does not free them.
+ *
+ * @return The handle of the created task, or NULL if either buffer was NULL.
+ *
+ * Example usage:
+   <pre>
+ #define STACK_SIZE 85
+
+ static portSTACK_TYPE xStack[ STACK_SIZE ];
+ static xStaticTask xTaskBuffer;
+
+ void vAFunction( void )
+ {
+ xTaskHandle xHandle;
+
+	 xHandle = xTaskCreateStatic( vTaskCode, "NAME", STACK_SIZE, NULL, tskIDLE_PRIORITY, xStack, &xTaskBuffer );
+ }
+   </pre>
+ * \defgroup xTaskCreateStatic xTaskCreateStatic
+ * \ingroup Tasks
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	xTaskHandle xTaskCreateStatic( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, portSTACK_TYPE *puxStackBuffer, xStaticTask *pxTaskBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  *<pre>
@@ -1122,6 +1226,36 @@ constant. */
 	#endif /* configUSE_APPLICATION_TASK_TAG ==1 */
 #endif /* ifdef configUSE_APPLICATION_TASK_TAG */
 
+#if ( configUSE_TASK_MEMORY_BANKS == 1 )
+	/**
+	 * task.h
+	 * <pre>void vTaskSetMemoryBank( xTaskHandle xTask, unsigned char ucBank );</pre>
+	 *
+	 * Binds the task xTask to external memory bank ucBank.  The bank is
+	 * selected, along with the malloc() state kept for it, whenever the task
+	 * is switched in, so each task with a bank of its own has a private XRAM
+	 * data region for the buffers it allocates with malloc().  Passing xTask
+	 * as NULL sets the bank of the calling task, which switches to it at once.
+	 *
+	 * Tasks start in bank 0, which is shared.  Anything another task or the
+	 * kernel reads, such as TCBs, stacks and queues, must not be put in a
+	 * private bank.
+	 *
+	 * configUSE_TASK_MEMORY_BANKS must be set to 1 in FreeRTOSConfig.h for
+	 * this function to be available.
+	 */
+	void vTaskSetMemoryBank( xTaskHandle xTask, unsigned char ucBank ) PRIVILEGED_FUNCTION;
+
+	/**
+	 * task.h
+	 * <pre>unsigned char ucTaskGetMemoryBank( xTaskHandle xTask );</pre>
+	 *
+	 * Returns the external memory bank of the task xTask.  Passing xTask as
+	 * NULL returns the bank of the calling task.
+	 */
+	unsigned char ucTaskGetMemoryBank( xTaskHandle xTask ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task.h
  * <pre>portBASE_TYPE xTaskCallApplicationTaskHook( xTaskHandle xTask, pdTASK_HOOK_CODE pxHookFunction );</pre>
@@ -1343,6 +1477,94 @@ void vTaskList( signed char *pcWriteBuffer ) PRIVILEGED_FUNCTION;
  */
 void vTaskGetRunTimeStats( signed char *pcWriteBuffer ) PRIVILEGED_FUNCTION;
 
+/*-----------------------------------------------------------
+ * TASK NOTIFICATIONS
+ *----------------------------------------------------------*/
+
+/*
+ * Each task has a 32 bit notification value, which other tasks and interrupts
+ * can update and the task can block on.  A notification unblocks the task
+ * directly, without the queue control block and xQueueGenericSend() path of a
+ * semaphore, so it is a lighter replacement for a binary or counting semaphore
+ * (or event bits) that is only ever taken by one known task.
+ *
+ * configUSE_TASK_NOTIFICATIONS must be set to 1 in FreeRTOSConfig.h for these
+ * functions to be available.  Each TCB grows by five bytes.
+ */
+
+/* Actions that can be performed when a task is notified. */
+typedef enum
+{
+	eNoAction = 0,				/* Notify the task without updating its notify value. */
+	eSetBits,					/* Set bits in the task's notification value. */
+	eIncrement,					/* Increment the task's notification value. */
+	eSetValueWithOverwrite,		/* Set the task's notification value to a specific value even if the previous value has not yet been read by the task. */
+	eSetValueWithoutOverwrite	/* Set the task's notification value if the previous value has been read by the task. */
+} eNotifyAction;
+
+/*
+ * Send a notification to xTaskToNotify, updating its notification value as
+ * eAction says, and unblocking it if it is waiting for a notification.
+ *
+ * @param pulPreviousNotificationValue If not NULL, is set to the notification
+ * value before it was updated.
+ *
+ * @return pdFAIL if eAction is eSetValueWithoutOverwrite and the task had a
+ * notification pending, otherwise pdPASS.
+ */
+portBASE_TYPE xTaskGenericNotify( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction, unsigned long *pulPreviousNotificationValue ) PRIVILEGED_FUNCTION;
+#define xTaskNotify( xTaskToNotify, ulValue, eAction )	xTaskGenericNotify( ( xTaskToNotify ), ( ulValue ), ( eAction ), NULL )
+#define xTaskNotifyAndQuery( xTaskToNotify, ulValue, eAction, pulPreviousNotifyValue )	xTaskGenericNotify( ( xTaskToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotifyValue ) )
+
+/*
+ * Notify a task from an interrupt.  *pxHigherPriorityTaskWoken is set to
+ * pdTRUE if the notified task has a higher priority than the interrupted
+ * task, in which case a context switch should be requested before the
+ * interrupt exits.
+ */
+portBASE_TYPE xTaskGenericNotifyFromISR( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction, unsigned long *pulPreviousNotificationValue, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#define xTaskNotifyFromISR( xTaskToNotify, ulValue, eAction, pxHigherPriorityTaskWoken )	xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( ulValue ), ( eAction ), NULL, ( pxHigherPriorityTaskWoken ) )
+#define xTaskNotifyAndQueryFromISR( xTaskToNotify, ulValue, eAction, pulPreviousNotificationValue, pxHigherPriorityTaskWoken )	xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotificationValue ), ( pxHigherPriorityTaskWoken ) )
+
+/*
+ * Give a notification as if it were a counting semaphore, to be taken by
+ * ulTaskNotifyTake().
+ */
+#define xTaskNotifyGive( xTaskToNotify )	xTaskGenericNotify( ( xTaskToNotify ), 0UL, eIncrement, NULL )
+#define vTaskNotifyGiveFromISR( xTaskToNotify, pxHigherPriorityTaskWoken )	( void ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), 0UL, eIncrement, NULL, ( pxHigherPriorityTaskWoken ) )
+
+/*
+ * Wait for a notification, as a binary semaphore (xClearCountOnExit pdTRUE)
+ * or counting semaphore (xClearCountOnExit pdFALSE) take.  Blocks for up to
+ * xTicksToWait if the notification value is zero.
+ *
+ * @return The notification value before it was cleared or decremented, which
+ * is 0 if the block time expired.
+ */
+unsigned long ulTaskNotifyTake( portBASE_TYPE xClearCountOnExit, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Wait for a notification, as event bits or a mailbox.  The bits in
+ * ulBitsToClearOnEntry are cleared from the notification value before
+ * blocking (if no notification is pending), and those in ulBitsToClearOnExit
+ * are cleared after a notification is received.
+ *
+ * @param pulNotificationValue If not NULL, is set to the notification value
+ * before ulBitsToClearOnExit was applied.
+ *
+ * @return pdTRUE if a notification was received, or pdFALSE if the block time
+ * expired.
+ */
+portBASE_TYPE xTaskNotifyWait( unsigned long ulBitsToClearOnEntry, unsigned long ulBitsToClearOnExit, unsigned long *pulNotificationValue, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Clear a pending notification of xTask (NULL for the calling task) without
+ * changing its notification value.
+ *
+ * @return pdPASS if a notification was pending, otherwise pdFAIL.
+ */
+portBASE_TYPE xTaskNotifyStateClear( xTaskHandle xTask ) PRIVILEGED_FUNCTION;
+
 /*-----------------------------------------------------------
  * SCHEDULER INTERNALS AVAILABLE FOR PORTING PURPOSES
  *----------------------------------------------------------*/
@@ -1419,6 +1641,25 @@ void vTaskPlaceOnEventListRestricted( xList * const pxEventList, portTickType xT
  */
 signed portBASE_TYPE xTaskRemoveFromEventList( const xList * const pxEventList ) PRIVILEGED_FUNCTION;
 
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * THESE FUNCTIONS MUST BE CALLED WITH THE SCHEDULER SUSPENDED.
+ *
+ * Used by the event groups.  The calling task is placed at the end of an
+ * event list that is not in priority order, with xItemValue (the bits it is
+ * waiting for, and how) stored in its event list item in place of its
+ * priority.  xTaskRemoveFromUnorderedEventList() unblocks the task owning a
+ * given item of such a list, storing xItemValue (the bits that unblocked it)
+ * in the item, and returns pdTRUE if that task has a higher priority than the
+ * calling task.  uxTaskResetEventItemValue() returns the value stored in the
+ * calling task's event list item, and puts its priority back.
+ */
+void vTaskPlaceOnUnorderedEventList( xList * pxEventList, portTickType xItemValue, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+signed portBASE_TYPE xTaskRemoveFromUnorderedEventList( xListItem * pxEventListItem, portTickType xItemValue ) PRIVILEGED_FUNCTION;
+portTickType uxTaskResetEventItemValue( void ) PRIVILEGED_FUNCTION;
+
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY
  * INTENDED FOR USE WHEN IMPLEMENTING A PORT OF THE SCHEDULER AND IS
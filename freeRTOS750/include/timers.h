@@ -86,6 +86,8 @@ as defined below. */
 #define tmrCOMMAND_STOP						( ( portBASE_TYPE ) 1 )
 #define tmrCOMMAND_CHANGE_PERIOD			( ( portBASE_TYPE ) 2 )
 #define tmrCOMMAND_DELETE					( ( portBASE_TYPE ) 3 )
+#define tmrCOMMAND_CHANGE_SLACK				( ( portBASE_TYPE ) 4 )
+#define tmrCOMMAND_SET_EVENT_BITS			( ( portBASE_TYPE ) 5 )	/* The handle is an event group, see xEventGroupSetBitsFromISR(). */
 
 /*-----------------------------------------------------------
  * MACROS AND DEFINITIONS
@@ -102,6 +104,16 @@ typedef void * xTimerHandle;
 /* Define the prototype to which timer callback functions must conform. */
 typedef void (*tmrTIMER_CALLBACK)( xTimerHandle xTimer );
 
+/* Callback statistics kept for each timer when configUSE_TIMER_STATS is 1, see
+vTimerGetStats(). */
+typedef struct xTIMER_STATS
+{
+	unsigned long ulCallbacks;		/* The number of times the callback has been run. */
+	unsigned long ulTotalRunTime;	/* Run time counter counts spent in the callback, in total... */
+	unsigned long ulMaxRunTime;		/* ...and in the longest call. */
+	portTickType xMaxLateness;		/* The most ticks after its expiry time the callback has been run. */
+} xTimerStatsType;
+
 /**
  * xTimerHandle xTimerCreate( 	const signed char *pcTimerName,
  * 								portTickType xTimerPeriodInTicks,
@@ -254,6 +266,17 @@ xTimerHandle xTimerCreate( const signed char * const pcTimerName, portTickType x
  */
 void *pvTimerGetTimerID( xTimerHandle xTimer ) PRIVILEGED_FUNCTION;
 
+/**
+ * const signed char *pcTimerGetTimerName( xTimerHandle xTimer );
+ *
+ * Returns the name given to the timer by xTimerCreate().
+ *
+ * @param xTimer The timer being queried.
+ *
+ * @return The name of the timer being queried.
+ */
+const signed char *pcTimerGetTimerName( xTimerHandle xTimer ) PRIVILEGED_FUNCTION;
+
 /**
  * portBASE_TYPE xTimerIsTimerActive( xTimerHandle xTimer );
  *
@@ -943,6 +966,50 @@ xTaskHandle xTimerGetTimerDaemonTaskHandle( void );
  */
 #define xTimerResetFromISR( xTimer, pxHigherPriorityTaskWoken ) xTimerGenericCommand( ( xTimer ), tmrCOMMAND_START, ( xTaskGetTickCountFromISR() ), ( pxHigherPriorityTaskWoken ), 0U )
 
+/**
+ * portBASE_TYPE xTimerChangeSlack( xTimerHandle xTimer,
+ *                                  portTickType xNewSlack,
+ *                                  portTickType xBlockTime );
+ *
+ * Sets how many ticks after its expiry time a timer's callback may be run.
+ * The timer service task wakes at the earliest expiry time plus slack of the
+ * active timers, and then runs the callback of every timer that has expired,
+ * so timers whose expiry times fall within each other's slack share one wake
+ * up.  Callbacks are never run early, and an auto reload timer keeps its
+ * period however late its callback is run.
+ *
+ * A timer's slack starts as configTIMER_DEFAULT_SLACK (0 unless set in
+ * FreeRTOSConfig.h).  The slack of an auto reload timer should be less than
+ * its period.  Changing the slack does not start or stop the timer.
+ *
+ * xTimerChangeSlack() sends a command to the timer service task in the same
+ * way as xTimerChangePeriod(), and the parameters and return value have the
+ * same meaning.
+ *
+ * Example usage:
+ * @verbatim
+ * // Two LEDs blink at 500 and 1000 ticks.  Let each callback run up to 20
+ * // ticks late, so the timer service task need not wake twice when their
+ * // expiry times are a few ticks apart.
+ * xTimerChangeSlack( xRedTimer, 20, 0 );
+ * xTimerChangeSlack( xGreenTimer, 20, 0 );
+ * @endverbatim
+ */
+#define xTimerChangeSlack( xTimer, xNewSlack, xBlockTime ) xTimerGenericCommand( ( xTimer ), tmrCOMMAND_CHANGE_SLACK, ( xNewSlack ), NULL, ( xBlockTime ) )
+
+/**
+ * void vTimerGetStats( xTimerHandle xTimer, xTimerStatsType *pxStats );
+ *
+ * Copies the callback statistics of a timer into *pxStats: how many times the
+ * callback has been run, the total and longest run time of the callback in
+ * run time counter counts (see configGENERATE_RUN_TIME_STATS), and the most
+ * ticks the callback has been run after its expiry time.  The run time
+ * includes any time the timer service task was preempted.
+ *
+ * configUSE_TIMER_STATS must be set to 1 for vTimerGetStats() to be available.
+ */
+void vTimerGetStats( xTimerHandle xTimer, xTimerStatsType *pxStats ) PRIVILEGED_FUNCTION;
+
 /*
  * Functions beyond this part are not part of the public API and are intended
  * for use by the kernel only.
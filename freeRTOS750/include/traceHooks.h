@@ -0,0 +1,135 @@
+/*
+    FreeRTOS V7.5.0 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+*/
+
+
+/*
+ * Kernel hooks for the trace recorder in lib_trace/traceRecorder.c.
+ *
+ * FreeRTOSConfig.h includes this file when configUSE_TRACE_RECORDER is 1.  It
+ * defines the trace macros that FreeRTOS.h would otherwise leave empty, so
+ * that each one writes an eight byte event into the recorder's ring buffer.
+ * The macros are expanded inside tasks.c, queue.c and timers.c, and use
+ * the names of the variables in scope there.
+ *
+ * The application API (start, stop, user events and flushing the buffer to
+ * an SD card file or a serial port) is in traceRecorder.h.
+ */
+
+#ifndef TRACE_HOOKS_H
+#define TRACE_HOOKS_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Record a tick event on every tick interrupt.  That is 8 bytes per tick, so
+it is only worth doing with the buffer in XRAM. */
+#ifndef configTRACE_TICKS
+	#define configTRACE_TICKS	0
+#endif
+
+/* The event codes.  tools/trace_decode.py has the same list. */
+#define traceEVENT_TASK_SWITCHED_IN			0x01	/* ucParam priority, usObject task. */
+#define traceEVENT_TASK_READY				0x02	/* ucParam priority, usObject task. */
+#define traceEVENT_TASK_CREATE				0x03	/* ucParam priority, usObject task. */
+#define traceEVENT_TASK_DELETE				0x04	/* usObject task. */
+#define traceEVENT_TASK_DELAY				0x05	/* usObject ticks to delay. */
+#define traceEVENT_TASK_DELAY_UNTIL			0x06	/* usObject tick to wake. */
+#define traceEVENT_TASK_SUSPEND				0x07	/* usObject task. */
+#define traceEVENT_TASK_RESUME				0x08	/* usObject task. */
+#define traceEVENT_TASK_RESUME_FROM_ISR		0x09	/* usObject task. */
+#define traceEVENT_TASK_PRIORITY_SET		0x0a	/* ucParam new priority, usObject task. */
+#define traceEVENT_TASK_PRIORITY_INHERIT	0x0b	/* ucParam new priority, usObject mutex holder. */
+#define traceEVENT_TASK_PRIORITY_DISINHERIT	0x0c	/* ucParam new priority, usObject mutex holder. */
+
+#define traceEVENT_QUEUE_CREATE				0x10	/* ucParam queue type, usObject queue. */
+#define traceEVENT_QUEUE_DELETE				0x11	/* usObject queue. */
+#define traceEVENT_QUEUE_SEND				0x12	/* ucParam items now waiting, usObject queue. */
+#define traceEVENT_QUEUE_SEND_FAILED		0x13
+#define traceEVENT_QUEUE_RECEIVE			0x14
+#define traceEVENT_QUEUE_RECEIVE_FAILED		0x15
+#define traceEVENT_QUEUE_PEEK				0x16
+#define traceEVENT_QUEUE_SEND_FROM_ISR		0x17
+#define traceEVENT_QUEUE_SEND_FROM_ISR_FAILED	0x18
+#define traceEVENT_QUEUE_RECEIVE_FROM_ISR	0x19
+#define traceEVENT_QUEUE_RECEIVE_FROM_ISR_FAILED	0x1a
+#define traceEVENT_BLOCKING_ON_QUEUE_SEND	0x1b
+#define traceEVENT_BLOCKING_ON_QUEUE_RECEIVE	0x1c
+
+#define traceEVENT_TICK						0x20	/* usObject tick count. */
+#define traceEVENT_LOW_POWER_IDLE_BEGIN		0x21
+#define traceEVENT_LOW_POWER_IDLE_END		0x22
+#define traceEVENT_TIMER_EXPIRED			0x23	/* usObject timer. */
+
+#define traceEVENT_USER						0x30	/* ucParam user code, usObject user value. */
+
+/* AVR pointers are 16 bits, so a handle fits in an event. */
+#define traceHANDLE( pxObject )				( ( uint16_t ) ( portPOINTER_SIZE_TYPE ) ( pxObject ) )
+
+/* The number of items in a queue, as an event parameter. */
+#define traceQUEUE_LEVEL( pxQueue )			( ( uint8_t ) ( pxQueue )->uxMessagesWaiting )
+
+void vTraceRecord( uint8_t ucEvent, uint8_t ucParam, uint16_t usObject );
+void vTraceTaskCreate( uint16_t usTask, uint8_t ucPriority, const char *pcName );
+
+#define traceTASK_SWITCHED_IN()							vTraceRecord( traceEVENT_TASK_SWITCHED_IN, ( uint8_t ) pxCurrentTCB->uxPriority, traceHANDLE( pxCurrentTCB ) )
+#define traceMOVED_TASK_TO_READY_STATE( pxTCB )			vTraceRecord( traceEVENT_TASK_READY, ( uint8_t ) ( pxTCB )->uxPriority, traceHANDLE( pxTCB ) );
+#define traceTASK_CREATE( pxNewTCB )					vTraceTaskCreate( traceHANDLE( pxNewTCB ), ( uint8_t ) ( pxNewTCB )->uxPriority, ( const char * ) ( pxNewTCB )->pcTaskName )
+#define traceTASK_DELETE( pxTCB )						vTraceRecord( traceEVENT_TASK_DELETE, 0, traceHANDLE( pxTCB ) )
+#define traceTASK_DELAY()								vTraceRecord( traceEVENT_TASK_DELAY, 0, ( uint16_t ) xTicksToDelay )
+#define traceTASK_DELAY_UNTIL()							vTraceRecord( traceEVENT_TASK_DELAY_UNTIL, 0, ( uint16_t ) xTimeToWake )
+#define traceTASK_SUSPEND( pxTCB )						vTraceRecord( traceEVENT_TASK_SUSPEND, 0, traceHANDLE( pxTCB ) )
+#define traceTASK_RESUME( pxTCB )						vTraceRecord( traceEVENT_TASK_RESUME, 0, traceHANDLE( pxTCB ) )
+#define traceTASK_RESUME_FROM_ISR( pxTCB )				vTraceRecord( traceEVENT_TASK_RESUME_FROM_ISR, 0, traceHANDLE( pxTCB ) )
+#define traceTASK_PRIORITY_SET( pxTCB, uxNewPriority )	vTraceRecord( traceEVENT_TASK_PRIORITY_SET, ( uint8_t ) ( uxNewPriority ), traceHANDLE( pxTCB ) )
+#define traceTASK_PRIORITY_INHERIT( pxTCB, uxPriority )	vTraceRecord( traceEVENT_TASK_PRIORITY_INHERIT, ( uint8_t ) ( uxPriority ), traceHANDLE( pxTCB ) )
+#define traceTASK_PRIORITY_DISINHERIT( pxTCB, uxPriority )	vTraceRecord( traceEVENT_TASK_PRIORITY_DISINHERIT, ( uint8_t ) ( uxPriority ), traceHANDLE( pxTCB ) )
+
+#define traceQUEUE_CREATE( pxNewQueue )					vTraceRecord( traceEVENT_QUEUE_CREATE, ( uint8_t ) ucQueueType, traceHANDLE( pxNewQueue ) )
+#define traceCREATE_MUTEX( pxNewQueue )					vTraceRecord( traceEVENT_QUEUE_CREATE, ( uint8_t ) ucQueueType, traceHANDLE( pxNewQueue ) )
+#define traceQUEUE_DELETE( pxQueue )					vTraceRecord( traceEVENT_QUEUE_DELETE, 0, traceHANDLE( pxQueue ) )
+#define traceQUEUE_SEND( pxQueue )						vTraceRecord( traceEVENT_QUEUE_SEND, traceQUEUE_LEVEL( pxQueue ), traceHANDLE( pxQueue ) )
+#define traceQUEUE_SEND_FAILED( pxQueue )				vTraceRecord( traceEVENT_QUEUE_SEND_FAILED, traceQUEUE_LEVEL( pxQueue ), traceHANDLE( pxQueue ) )
+#define traceQUEUE_RECEIVE( pxQueue )					vTraceRecord( traceEVENT_QUEUE_RECEIVE, traceQUEUE_LEVEL( pxQueue ), traceHANDLE( pxQueue ) )
+#define traceQUEUE_RECEIVE_FAILED( pxQueue )			vTraceRecord( traceEVENT_QUEUE_RECEIVE_FAILED, traceQUEUE_LEVEL( pxQueue ), traceHANDLE( pxQueue ) )
+#define traceQUEUE_PEEK( pxQueue )						vTraceRecord( traceEVENT_QUEUE_PEEK, traceQUEUE_LEVEL( pxQueue ), traceHANDLE( pxQueue ) )
+#define traceQUEUE_SEND_FROM_ISR( pxQueue )				vTraceRecord( traceEVENT_QUEUE_SEND_FROM_ISR, traceQUEUE_LEVEL( pxQueue ), traceHANDLE( pxQueue ) )
+#define traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue )		vTraceRecord( traceEVENT_QUEUE_SEND_FROM_ISR_FAILED, traceQUEUE_LEVEL( pxQueue ), traceHANDLE( pxQueue ) )
+#define traceQUEUE_RECEIVE_FROM_ISR( pxQueue )			vTraceRecord( traceEVENT_QUEUE_RECEIVE_FROM_ISR, traceQUEUE_LEVEL( pxQueue ), traceHANDLE( pxQueue ) )
+#define traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue )	vTraceRecord( traceEVENT_QUEUE_RECEIVE_FROM_ISR_FAILED, traceQUEUE_LEVEL( pxQueue ), traceHANDLE( pxQueue ) )
+#define traceBLOCKING_ON_QUEUE_SEND( pxQueue )			vTraceRecord( traceEVENT_BLOCKING_ON_QUEUE_SEND, traceQUEUE_LEVEL( pxQueue ), traceHANDLE( pxQueue ) )
+#define traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue )		vTraceRecord( traceEVENT_BLOCKING_ON_QUEUE_RECEIVE, traceQUEUE_LEVEL( pxQueue ), traceHANDLE( pxQueue ) )
+
+#if ( configTRACE_TICKS == 1 )
+	#define traceTASK_INCREMENT_TICK( xTickCount )		vTraceRecord( traceEVENT_TICK, 0, ( uint16_t ) ( xTickCount ) )
+#endif
+#define traceLOW_POWER_IDLE_BEGIN()						vTraceRecord( traceEVENT_LOW_POWER_IDLE_BEGIN, 0, 0 )
+#define traceLOW_POWER_IDLE_END()						vTraceRecord( traceEVENT_LOW_POWER_IDLE_END, 0, 0 )
+#define traceTIMER_EXPIRED( pxTimer )					vTraceRecord( traceEVENT_TIMER_EXPIRED, 0, traceHANDLE( pxTimer ) )
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TRACE_HOOKS_H */
@@ -0,0 +1,131 @@
+/*
+    FreeRTOS V7.5.0 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+*/
+
+
+/*
+ * Kernel event trace recorder.
+ *
+ * With configUSE_TRACE_RECORDER set to 1 the kernel trace macros (see
+ * traceHooks.h) write an eight byte event for each context switch, each task
+ * made ready, each queue and semaphore operation, and so on, into a ring
+ * buffer.  Each event is stamped with the run time stats counter, so
+ * configGENERATE_RUN_TIME_STATS should also be 1 (16us resolution at 16MHz).
+ * Without it events are stamped with the tick count.
+ *
+ * The buffer is in internal SRAM, unless the board has XRAM:
+ * - If the kernel heap is in XRAM, the buffer follows it in .ext_ram_heap.
+ * - If the kernel heap is in SRAM (portEXT_RAMFS or portEXT_RAM_TASK_BANKS),
+ *   the buffer fills XRAM bank configTRACE_XRAM_BANK, which is switched in
+ *   for each event and switched back.  That bank must not be given to a task
+ *   or a RAMFS client.
+ *
+ * When the buffer is full the oldest events are overwritten.  The buffer is
+ * emptied by writing it to an open FatFs file or to a serial port, in the
+ * format read by tools/trace_decode.py.  A flush writes only the events that
+ * were in the buffer when it started, so it can be called periodically from
+ * a low priority task to stream the trace without chasing its own events.
+ */
+
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include traceRecorder.h"
+#endif
+
+#include <lib_serial.h>
+#include <ff.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * One event as it is stored, and as it is written by a flush (little endian,
+ * as the AVR stores it).
+ */
+typedef struct xTRACE_EVENT
+{
+	uint32_t ulTimeStamp;		/* Run time counter (or tick count) when the event was recorded. */
+	uint16_t usObject;			/* The task, queue or timer handle, or a value, depending on ucEvent. */
+	uint8_t ucEvent;			/* One of the traceEVENT_ codes in traceHooks.h. */
+	uint8_t ucParam;			/* A priority, a queue fill level or a user code, depending on ucEvent. */
+} xTraceEvent;
+
+/*
+ * Each flush writes this header, then ucTaskCount task names, each a 16 bit
+ * handle and ucNameLength characters, then usEventCount events, oldest first.
+ */
+typedef struct xTRACE_HEADER
+{
+	uint8_t ucMagic[ 4 ];		/* "FRTR" */
+	uint8_t ucVersion;			/* traceFORMAT_VERSION */
+	uint8_t ucTaskCount;
+	uint8_t ucNameLength;
+	uint8_t ucEventSize;		/* sizeof( xTraceEvent ) */
+	uint32_t ulTimeStampHz;		/* Units of ulTimeStamp. */
+	uint32_t ulTickHz;			/* configTICK_RATE_HZ, the units of delays. */
+	uint32_t ulLost;			/* Events overwritten before they could be flushed, since the previous flush. */
+	uint16_t usEventCount;
+	uint16_t usBufferEvents;	/* The size of the ring buffer. */
+} xTraceHeader;
+
+#define traceFORMAT_VERSION		1
+
+/*
+ * Recording starts when the program starts.  vTraceStop() stops adding
+ * events (task names are still kept), vTraceStart() carries on, and
+ * vTraceClear() throws away the events in the buffer.
+ */
+void vTraceStart( void );
+void vTraceStop( void );
+void vTraceClear( void );
+
+/*
+ * Records an application event, for example the entry to an interrupt
+ * handler.  Can be called from an interrupt.  The decoder lists user events
+ * by code, and times from each one to the next switch to a task.
+ */
+#define vTraceUserEvent( ucCode, usValue )	vTraceRecord( traceEVENT_USER, ( uint8_t ) ( ucCode ), ( uint16_t ) ( usValue ) )
+
+/*
+ * Writes the buffered events to an open file, at the file's read/write
+ * pointer.  The events written are removed from the buffer.
+ *
+ * @return FR_OK, or the error from f_write().
+ */
+FRESULT xTraceFlushToFile( FIL *pxFile );
+
+/*
+ * Writes the buffered events to a serial port, as binary.  The events written
+ * are removed from the buffer.  Waits for space in the transmit buffer rather
+ * than drop bytes, so should be called from a task.
+ *
+ * @return The number of events written.
+ */
+uint16_t usTraceFlushToSerial( xComPortHandlePtr pxPort );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TRACE_RECORDER_H */
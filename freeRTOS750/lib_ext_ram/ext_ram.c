@@ -226,6 +226,12 @@ void setMemoryBank(uint8_t bank_, bool switchHeap_) // use switchHeap_ false to
 	portEXIT_CRITICAL();
 }
 
+/* Get the currently selected memory bank */
+uint8_t getMemoryBank(void)
+{
+	return currentBank;
+}
+
 
 /* --------------------------------------------- */
 
@@ -33,6 +33,10 @@
 /* serial interface include file. */
 #include <lib_serial.h>		// temporary while debugging
 
+#if ( configUSE_TRACE_RECORDER == 1 )
+#include <traceRecorder.h>	// user events for the Client calls
+#endif
+
 #include <ramfs.h>			// access to XRAM related functions
 #include <diskio.h>			// emulate the diskio.c functions here, when portEXT_RAMFS is enabled.
 
@@ -990,6 +994,10 @@ ISR (PCINT1_vect)
 
     changedbits = (uint16_t)(( PINJ<<1 | (PINE & 0x01) ) ^ HIGH_BITS);	// Check if any of the SS lines from Clients have been pulled low.
 
+#if ( configUSE_TRACE_RECORDER == 1 )
+	vTraceUserEvent( RAMFS_TRACE_CLIENT_CALL, changedbits );
+#endif
+
     if (changedbits != 0x0000)
 		// Push changedbits onto the queue for later processing.
 		// Don't wait if queue full.
@@ -1008,6 +1016,10 @@ ISR (PCINT2_vect)
 	// calculate which bit changed since last time
     changedbits = ((uint16_t)(PINK ^ HIGH_BITS)) << 8;	// Check if any of the SS lines from Clients have been pulled low.
 
+#if ( configUSE_TRACE_RECORDER == 1 )
+	vTraceUserEvent( RAMFS_TRACE_CLIENT_CALL, changedbits );
+#endif
+
     if (changedbits != 0x0000)
 		// Push changedbits onto the queue for later processing.
 		// Don't wait if queue full.
@@ -13,6 +13,9 @@
 #include <FreeRTOS.h>
 #include <task.h>
 #include <spi.h>
+#if (SPI_USART_BUS == 1)
+#include <lib_crc.h>
+#endif
 
 #if defined( portSD_CARD) || defined(portEXT_RAMFS)
 
@@ -148,6 +151,7 @@ static uint8_t xmit_datablock (
 )
 {
 	uint8_t resp;
+	uint16_t crc;
 
 	resp = 0;
 	while ((spiTransfer(0xFF) == 0x00) && (--resp != 0)) 	// Long wait while SD busy (0x00 signal).
@@ -156,10 +160,18 @@ static uint8_t xmit_datablock (
 	spiTransfer(token);					/* Xmit data token */
 	if (token != 0xFD) {				/* Is data token */
 
-		if (!spiMultiByteTx( buff, 512 )) return 0; /* Xmit the 512 byte data block to MMC */
+		crc = 0;
+		if (!spiMultiByteTxCRC16( buff, 512, &crc )) {	/* Xmit the 512 byte data block to MMC, working out its CRC */
+#if (SPI_USART_BUS == 1)
+			if (!spiMultiByteTx( buff, 512 )) return 0;	/* A USART bus has no CRC on the fly */
+			crc = crc16_ccitt( buff, 512 );
+#else
+			return 0;
+#endif
+		}
 
-		spiTransfer(0xDE);				/* CRC (Dummy) 16 bit*/
-		spiTransfer(0xAD);
+		spiTransfer((uint8_t)(crc >> 8));	/* CRC 16 bit, checked by the card only after CMD59 */
+		spiTransfer((uint8_t)crc);
 
 		resp = spiTransfer(0xFF);		/* Receive data response */
 		if ((resp & 0x1F) != 0x05)		/* If not accepted (xxx00101), return with error */
@@ -257,10 +269,14 @@ DSTATUS disk_initialize (
 
 	power_on();							// Force socket power on
 
+	if (!spiTakeBus(SDCard)) return STA_NOINIT;	// hold the SD card's SPI bus, without selecting it.
+
 	spiSetClockDivider(SPI_CLOCK_DIV64); // slow clock down to between 100kHz and 400kHz (125kHz @ 16MHz)
 
 	for (uint8_t i = 10; i; --i) spiTransfer(0xFF);	// 80 dummy clocks; without SD card selected.
 
+	spiGiveBus(SDCard);
+
 	type = 0;							// Set invalid SD card type.
 
 	if (!spiSelect(SDCard)) return STA_NOINIT;
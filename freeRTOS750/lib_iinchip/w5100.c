@@ -77,6 +77,11 @@ static uint8_t SUBN_VAR[4]; // off-chip subnet mask address - solve Errata 2 & 3
 uint16_t IINCHIP_read_buf( uint16_t addr, uint8_t *buf, uint16_t len);
 uint16_t IINCHIP_write_buf(uint16_t addr, uint8_t *buf, uint16_t len);
 
+#define IINCHIP_READ_REGS_MAX 4 // most register reads batched into one SPI transaction
+
+static uint8_t IINCHIP_read_regs(const uint16_t *addr, uint8_t *data, uint8_t count);
+static uint16_t IINCHIP_read_word(uint16_t addr_hi, uint16_t addr_lo);
+
 uint8_t IINCHIP_getISR(uint8_t s)
 {
 	return I_STATUS[s];
@@ -224,6 +229,71 @@ uint8_t IINCHIP_read(uint16_t addr)
 }
 
 
+/**
+@brief	This function reads up to IINCHIP_READ_REGS_MAX W5100 registers in one SPI transaction.
+
+Each register is still its own 4 byte frame, with CS raised between frames as the W5100 needs,
+but the bus semaphore, mode and clock are set once for the lot. Returns 1 on success, or 0
+with data zeroed if the SPI bus could not be had.
+*/
+static uint8_t IINCHIP_read_regs(const uint16_t *addr, uint8_t *data, uint8_t count)
+{
+	uint8_t frame[IINCHIP_READ_REGS_MAX][4];
+	SPI_SEGMENT segment[IINCHIP_READ_REGS_MAX];
+	uint8_t i, result;
+
+	for (i = 0; i < count; ++i)
+	{
+		frame[i][0] = 0x0F;							// Read Op Code
+		frame[i][1] = (uint8_t)((addr[i] & 0xFF00) >> 8);
+		frame[i][2] = (uint8_t)(addr[i] & 0x00FF);
+		frame[i][3] = 0xFF;							// dummy byte, to clock the data out
+
+		segment[i].SS_pin  = Wiznet;
+		segment[i].mode    = SPI_MODE0;
+		segment[i].divider = IINCHIP_SPI_DIVIDER;
+		segment[i].txData  = frame[i];
+		segment[i].rxData  = frame[i];				// read back over the frame
+		segment[i].length  = 4;
+	}
+
+	IINCHIP_ISR_DISABLE();
+
+	result = spiTransaction(segment, count);
+
+	IINCHIP_ISR_ENABLE();
+
+	for (i = 0; i < count; ++i)
+		data[i] = result ? frame[i][3] : 0;
+
+	return result;
+}
+
+
+/**
+@brief	This function reads a 16 bit W5100 register that the W5100 may be changing.
+
+The pair is read twice in one transaction, until both reads agree.
+*/
+static uint16_t IINCHIP_read_word(uint16_t addr_hi, uint16_t addr_lo)
+{
+	uint16_t addr[4];
+	uint8_t data[4];
+
+	addr[0] = addr_hi;
+	addr[1] = addr_lo;
+	addr[2] = addr_hi;
+	addr[3] = addr_lo;
+
+	do
+	{
+		if ( !IINCHIP_read_regs(addr, data, 4) ) return 0;
+	} while (data[0] != data[2] || data[1] != data[3]);
+
+	return ((uint16_t)data[0] << 8) + data[1];
+}
+
+
 /**
 @brief	This function writes into W5100 memory (Buffer)
 */
@@ -878,19 +948,7 @@ User should check this value first and control the size of transmitted data.
 */
 uint16_t getSn_TX_FSR(SOCKET s)
 {
-	uint16_t val  = 0;
-	uint16_t val1 = 0;
-	do
-	{
-		val1 = IINCHIP_read(Sn_TX_FSR0(s));
-		val1 = ((val1 & 0x00ff) << 8) + IINCHIP_read(Sn_TX_FSR1(s));
-		if (val1 != 0)
-		{
-			val = IINCHIP_read(Sn_TX_FSR0(s));
-			val = ((val & 0x00ff) << 8) + IINCHIP_read(Sn_TX_FSR1(s));
-		}
-	} while (val != val1);
-	return val;
+	return IINCHIP_read_word(Sn_TX_FSR0(s), Sn_TX_FSR1(s));
 }
 
 
@@ -901,19 +959,7 @@ This gives size of received data in receive buffer.
 */
 uint16_t getSn_RX_RSR(SOCKET s)
 {
-	uint16_t val  = 0;
-	uint16_t val1 = 0;
-	do
-	{
-		val1 = IINCHIP_read(Sn_RX_RSR0(s));
-		val1 = ((val1 & 0x00ff) << 8) + IINCHIP_read(Sn_RX_RSR1(s));
-		if(val1 != 0)
-		{
-			val = IINCHIP_read(Sn_RX_RSR0(s));
-			val = ((val & 0x00ff) << 8) + IINCHIP_read(Sn_RX_RSR1(s));
-		}
-	} while (val != val1);
-	return val;
+	return IINCHIP_read_word(Sn_RX_RSR0(s), Sn_RX_RSR1(s));
 }
 
 
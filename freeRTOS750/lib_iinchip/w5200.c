@@ -54,6 +54,8 @@ uint8_t rxsize[MAX_SOCK_NUM] = {4,2,2,2,2,2,1,1};
 uint16_t IINCHIP_read_buf( uint16_t addr, uint8_t *buf, uint16_t len);
 uint16_t IINCHIP_write_buf(uint16_t addr, uint8_t *buf, uint16_t len);
 
+static uint16_t IINCHIP_read_word(uint16_t addr);
+
 
 uint8_t incr_windowfull_retry_cnt(uint8_t s)
 {
@@ -225,12 +227,55 @@ uint8_t IINCHIP_read(uint16_t addr)
 }
 
 
+/**
+@brief	This function reads a 16 bit W5200 register that the W5200 may be changing.
+
+The pair is read twice, each a 2 byte burst, in one SPI transaction, until both reads agree.
+*/
+static uint16_t IINCHIP_read_word(uint16_t addr)
+{
+	uint8_t frame[2][6];
+	SPI_SEGMENT segment[2];
+	uint8_t i, result;
+
+	do
+	{
+		for (i = 0; i < 2; ++i)
+		{
+			frame[i][0] = (uint8_t)((addr & 0xFF00) >> 8);	// upper address
+			frame[i][1] = (uint8_t)(addr & 0x00FF);			// lower address
+			frame[i][2] = 0x00;								// Data Read command and Read data length 14-8
+			frame[i][3] = 0x02;								// Read data length 7-0
+			frame[i][4] = 0x00;								// dummy bytes, to clock the data out
+			frame[i][5] = 0x00;
+
+			segment[i].SS_pin  = Wiznet;
+			segment[i].mode    = SPI_MODE0;
+			segment[i].divider = IINCHIP_SPI_DIVIDER;
+			segment[i].txData  = frame[i];
+			segment[i].rxData  = frame[i];					// read back over the frame
+			segment[i].length  = 6;
+		}
+
+		IINCHIP_ISR_DISABLE();
+
+		result = spiTransaction(segment, 2);
+
+		IINCHIP_ISR_ENABLE();
+
+		if ( !result ) return 0;
+
+	} while (frame[0][4] != frame[1][4] || frame[0][5] != frame[1][5]);
+
+	return ((uint16_t)frame[0][4] << 8) + frame[0][5];
+}
+
+
 /**
 @brief	This function writes into W5200 memory(Buffer)
 */
 uint16_t IINCHIP_write_buf(uint16_t addr, uint8_t * buf, uint16_t len)
 {
-	uint16_t idx;
 	uint8_t Byte;
 
 	IINCHIP_ISR_DISABLE();
@@ -270,16 +315,11 @@ uint16_t IINCHIP_write_buf(uint16_t addr, uint8_t * buf, uint16_t len)
 	while ( !(SPSR & _BV(SPIF)) );
 
 	SPDR = Byte;								// load the Write data length 7-0
-
-	idx = 0;
-	while(idx < len)							// Write data in loop
-	{
-		Byte = buf[ idx++ ];					// pre-load the byte to be transmitted
-		while ( !(SPSR & _BV(SPIF)) );
-		SPDR = Byte;							// load the byte to be transmitted
-	}
 	while ( !(SPSR & _BV(SPIF)) );
 
+	if (len != 0)
+		spiMultiByteTx(buf, len);				// Write data, at SPI_CLOCK_DIV2 with the assembler loop
+
 	portEXIT_CRITICAL();
 
 	spiDeselect(Wiznet);						// CS=1, SPI end, give semaphore
@@ -295,7 +335,6 @@ uint16_t IINCHIP_write_buf(uint16_t addr, uint8_t * buf, uint16_t len)
 */
 uint16_t IINCHIP_read_buf(uint16_t addr, uint8_t * buf,uint16_t len)
 {
-	uint16_t idx;
 	uint8_t Byte;
 
 	IINCHIP_ISR_DISABLE();
@@ -335,22 +374,10 @@ uint16_t IINCHIP_read_buf(uint16_t addr, uint8_t * buf,uint16_t len)
 	while ( !(SPSR & _BV(SPIF)) );
 
 	SPDR = Byte;								// load the Data Read data length 7-0
-	Byte = 0x5A;								// pre-load the dummy byte.
-	while ( !(SPSR & _BV(SPIF)) );
-
-	SPDR = Byte;								// Begin dummy transmission
-
-	idx = 0;
-	while (idx < len - 1)
-	{
-		while ( !(SPSR & _BV(SPIF)) );
-		Byte = SPDR;							// copy received byte
-		SPDR = 0x5A;							// Continue dummy transmission
-		buf [ idx++ ] = Byte;
-	}
 	while ( !(SPSR & _BV(SPIF)) );
 
-	buf [ idx ] = SPDR;							// store the last byte that was read
+	if (len != 0)
+		spiMultiByteRx(buf, len);				// Read data, at SPI_CLOCK_DIV2 with the assembler loop
 
 	portEXIT_CRITICAL();
 
@@ -729,19 +756,7 @@ User should check this value first and control the size of transmitted data.
 */
 uint16_t getSn_TX_FSR(SOCKET s)
 {
-	uint16_t val  = 0;
-	uint16_t val1 = 0;
-	do
-	{
-		val1 = IINCHIP_read(Sn_TX_FSR0(s));
-		val1 = (val1 << 8) + IINCHIP_read(Sn_TX_FSR1(s));
-      if (val1 != 0)
-		{
-   			val = IINCHIP_read(Sn_TX_FSR0(s));
-   			val = (val << 8) + IINCHIP_read(Sn_TX_FSR1(s));
-		}
-	} while (val != val1);
-   return val;
+	return IINCHIP_read_word(Sn_TX_FSR0(s));	// Sn_TX_FSR1 follows
 }
 
 
@@ -752,19 +767,7 @@ This gives size of received data in receive buffer.
 */
 uint16_t getSn_RX_RSR(SOCKET s)
 {
-	uint16_t val  = 0;
-	uint16_t val1 = 0;
-	do
-	{
-		val1 = IINCHIP_read(Sn_RX_RSR0(s));
-		val1 = (val1 << 8) + IINCHIP_read(Sn_RX_RSR1(s));
-      if(val1 != 0)
-		{
-   			val = IINCHIP_read(Sn_RX_RSR0(s));
-   			val = (val << 8) + IINCHIP_read(Sn_RX_RSR1(s));
-		}
-	} while (val != val1);
-   return val;
+	return IINCHIP_read_word(Sn_RX_RSR0(s));	// Sn_RX_RSR1 follows
 }
 
 
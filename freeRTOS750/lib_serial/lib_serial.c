@@ -308,6 +308,237 @@ void xSerialxPrint_P( xComPortHandlePtr pxPort, PGM_P str)
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_HEAP_STATS == 1 )
+
+void xSerialxPrintHeapStats( xComPortHandlePtr pxPort )
+{
+	xHeapStatsType xHeapStats;
+	xHeapTraceEvent xEvent;
+	unsigned portBASE_TYPE x;
+	uint16_t usLastSequence = 0;
+
+	vPortGetHeapStats( &xHeapStats );
+
+	xSerialxPrintf_P( pxPort, PSTR("\r\nHeap free %u min %u largest %u blocks %u frag %u%%\r\n"),
+			xHeapStats.xFreeBytes,
+			xHeapStats.xMinimumEverFreeBytes,
+			xHeapStats.xLargestFreeBlock,
+			xHeapStats.xNumberOfFreeBlocks,
+			xHeapStats.ucFragmentation );
+
+	/* Events are read oldest first.  Any made while printing push the oldest
+	out from under the index, so skip those already printed. */
+	for( x = 0; xPortGetHeapTraceEvent( x, &xEvent ) == pdPASS; ++x )
+	{
+		if( x == 0 )
+			xSerialxPrint_P( pxPort, PSTR("  SEQ E   ADDR  SIZE CALLER  TICK\r\n"));
+		else if( (int16_t)(xEvent.usSequence - usLastSequence) <= 0 )
+			continue;
+
+		xSerialxPrintf_P( pxPort, PSTR("%5u %c 0x%04x %5u 0x%04x %5u\r\n"),
+				xEvent.usSequence,
+				xEvent.ucEvent,
+				(uint16_t)xEvent.pvAddress,
+				xEvent.xSize,
+				(uint16_t)xEvent.pvCaller,	// word address, double it for the map file
+				xEvent.xTime );
+
+		usLastSequence = xEvent.usSequence;
+	}
+}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_TRACE_FACILITY == 1 )
+
+/* The previous sample, kept on the heap so each report covers the time since the last. */
+static xTaskStatusType *pxPreviousTaskStats = NULL;
+static unsigned portBASE_TYPE uxPreviousTaskCount = 0;
+static uint32_t ulPreviousTotalRunTime = 0;
+
+void xSerialxPrintTaskStats( xComPortHandlePtr pxPort )
+{
+	xTaskStatusType *pxTaskStats;
+	unsigned portBASE_TYPE uxTaskCount, x, y;
+	uint32_t ulTotalRunTime, ulElapsed, ulElapsedDiv1000, ulTaskTime, ulPermille;
+
+	uxTaskCount = uxTaskGetNumberOfTasks();
+
+	if( !(pxTaskStats = (xTaskStatusType *)pvPortMalloc( uxTaskCount * sizeof(xTaskStatusType) )))
+	{
+		xSerialxPrint_P( pxPort, PSTR("\r\nNo heap for task stats.\r\n"));
+		return;
+	}
+
+	uxTaskCount = uxTaskGetSystemState( pxTaskStats, uxTaskCount, &ulTotalRunTime );
+
+	ulElapsed = ulTotalRunTime - ulPreviousTotalRunTime;
+	ulElapsedDiv1000 = ulElapsed / 1000;
+
+	xSerialxPrintf_P( pxPort, PSTR("\r\n%u tasks, %lu.%03lu sec sampled\r\n"), uxTaskCount,
+			ulElapsed / portRUN_TIME_COUNTER_HZ,
+			(ulElapsed % portRUN_TIME_COUNTER_HZ) * 1000 / portRUN_TIME_COUNTER_HZ );
+	xSerialxPrint_P( pxPort, PSTR(" NUM NAME             S PRI STACK  RUN TIME  %CPU\r\n"));
+
+	for( x = 0; x < uxTaskCount; ++x )
+	{
+		ulTaskTime = pxTaskStats[x].ulRunTimeCounter;
+
+		/* Subtract the previous sample of the same task, if there was one. */
+		for( y = 0; y < uxPreviousTaskCount; ++y )
+		{
+			if( pxPreviousTaskStats[y].xHandle == pxTaskStats[x].xHandle )
+			{
+				ulTaskTime -= pxPreviousTaskStats[y].ulRunTimeCounter;
+				break;
+			}
+		}
+
+		ulPermille = ulElapsedDiv1000 ? ulTaskTime / ulElapsedDiv1000 : 0;
+
+		xSerialxPrintf_P( pxPort, PSTR("%4u %-*s %c %3u %5u %9lu %3lu.%lu\r\n"),
+				pxTaskStats[x].xTaskNumber,
+				configMAX_TASK_NAME_LEN, (const char *)pxTaskStats[x].pcTaskName,
+				"XRBSD"[ pxTaskStats[x].eCurrentState ],	// eRunning is reported as eReady
+				pxTaskStats[x].uxCurrentPriority,
+				pxTaskStats[x].usStackHighWaterMark,
+				ulTaskTime,
+				ulPermille / 10, ulPermille % 10 );
+	}
+
+	/* Keep this sample for the next report. */
+	vPortFree( pxPreviousTaskStats );
+	pxPreviousTaskStats = pxTaskStats;
+	uxPreviousTaskCount = uxTaskCount;
+	ulPreviousTotalRunTime = ulTotalRunTime;
+}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIMER_STATS == 1 )
+
+void xSerialxPrintTimerStats( xComPortHandlePtr pxPort, xTimerHandle xTimer )
+{
+	xTimerStatsType xStats;
+	uint32_t ulAverage;
+
+	vTimerGetStats( xTimer, &xStats );
+
+	ulAverage = xStats.ulCallbacks ? xStats.ulTotalRunTime / xStats.ulCallbacks : 0;
+
+	xSerialxPrintf_P( pxPort, PSTR("Timer %-*s calls %lu run avg %lu max %lu late max %u\r\n"),
+			configMAX_TASK_NAME_LEN, (const char *)pcTimerGetTimerName( xTimer ),
+			xStats.ulCallbacks,
+			ulAverage,
+			xStats.ulMaxRunTime,
+			xStats.xMaxLateness );
+}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STACK_REPORT == 1 )
+
+void xSerialxPrintStackReport( xComPortHandlePtr pxPort )
+{
+	xTaskStatusType *pxTaskStats;
+	unsigned portBASE_TYPE uxTaskCount, x;
+	uint16_t usSize, usFree;
+
+	uxTaskCount = uxTaskGetNumberOfTasks();
+
+	if( !(pxTaskStats = (xTaskStatusType *)pvPortMalloc( uxTaskCount * sizeof(xTaskStatusType) )))
+	{
+		xSerialxPrint_P( pxPort, PSTR("\r\nNo heap for stack report.\r\n"));
+		return;
+	}
+
+	uxTaskCount = uxTaskGetSystemState( pxTaskStats, uxTaskCount, NULL );
+
+	xSerialxPrint_P( pxPort, PSTR("\r\nStack NAME             SIZE  USED  FREE\r\n"));
+
+	for( x = 0; x < uxTaskCount; ++x )
+	{
+		xSerialxPrintf_P( pxPort, PSTR("Stack %-*s %5u %5u %5u\r\n"),
+				configMAX_TASK_NAME_LEN, (const char *)pxTaskStats[x].pcTaskName,
+				pxTaskStats[x].usStackDepth,
+				pxTaskStats[x].usStackDepth - pxTaskStats[x].usStackHighWaterMark,
+				pxTaskStats[x].usStackHighWaterMark );
+	}
+
+	vPortFree( pxTaskStats );
+
+	usSize = usPortGetSystemStackSize();
+	usFree = usPortGetSystemStackHighWaterMark();
+
+	xSerialxPrintf_P( pxPort, PSTR("Stack %-*s %5u %5u %5u\r\n"),
+			configMAX_TASK_NAME_LEN, "(system)",
+			usSize, usSize - usFree, usFree );
+}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CRITICAL_PROFILER == 1 )
+
+void xSerialxPrintCriticalStats( xComPortHandlePtr pxPort, portBASE_TYPE xReset )
+{
+	xPortCriticalStats xStats;
+	uint32_t ulElapsed, ulPermille;
+
+	vPortGetCriticalStats( &xStats, xReset );
+
+	ulElapsed = ulPortGetRunTimeCounterValue() - xStats.ulSince;
+	ulPermille = ( ulElapsed / 1000 ) ? xStats.ulTotalCount / ( ulElapsed / 1000 ) : 0;
+
+	// Byte addresses, as in the map file and avr-objdump listings.
+	xSerialxPrintf_P( pxPort, PSTR("Critical max %lu us entered 0x%05lx left 0x%05lx, %lu sections %lu.%lu%%\r\n"),
+			(uint32_t)xStats.usMaxCount * 1000 / ( portRUN_TIME_COUNTER_HZ / 1000 ),
+			(uint32_t)(uint16_t)xStats.pvMaxEnter * 2,
+			(uint32_t)(uint16_t)xStats.pvMaxExit * 2,
+			xStats.ulSpans,
+			ulPermille / 10, ulPermille % 10 );
+}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( SPI_STATS == 1 )
+
+void xSerialxPrintSPIStats( xComPortHandlePtr pxPort, portBASE_TYPE xReset )
+{
+	static const char * const pcDeviceNames[ Default + 1 ] = { "Wiznet", "SDCard", "Default" };
+	SPI_STATISTICS xStats;
+	uint32_t ulElapsed, ulPermille;
+	uint8_t x;
+
+	xSerialxPrint_P( pxPort, PSTR("\r\nSPI DEVICE      HOLDS      BYTES  HOLD ms  MAX us   BUSY  WAIT ms  MAX us TIMEOUTS\r\n"));
+
+	for( x = 0; x <= Default; ++x )
+	{
+		spiGetStats( (SPI_SLAVE_SELECT)x, &xStats, xReset );
+
+		ulElapsed = ulPortGetRunTimeCounterValue() - xStats.since;
+		ulPermille = ( ulElapsed / 1000 ) ? xStats.holdTime / ( ulElapsed / 1000 ) : 0;
+
+		xSerialxPrintf_P( pxPort, PSTR("SPI %-8s %8lu %10lu %8lu %7lu %3lu.%lu%% %8lu %7lu %8u\r\n"),
+				pcDeviceNames[x],
+				xStats.transactions,
+				xStats.bytes,
+				xStats.holdTime / ( portRUN_TIME_COUNTER_HZ / 1000 ),
+				xStats.maxHoldTime * 1000 / ( portRUN_TIME_COUNTER_HZ / 1000 ),
+				ulPermille / 10, ulPermille % 10,
+				xStats.waitTime / ( portRUN_TIME_COUNTER_HZ / 1000 ),
+				xStats.maxWaitTime * 1000 / ( portRUN_TIME_COUNTER_HZ / 1000 ),
+				xStats.timeouts );
+	}
+}
+
+#endif
+/*-----------------------------------------------------------*/
+
 inline void xSerialFlush( xComPortHandlePtr pxPort )
 {
 	/* Flush received characters from the serial port buffer.*/
@@ -16,6 +16,18 @@
 
 #include <spi.h>
 
+#if (SPI_STATS == 1)
+#include <string.h>
+#endif
+
+#if (SPI_ASYNC == 1)
+#include <avr/interrupt.h>
+#endif
+
+#if (SPI_ASYNC == 1) || (SPI_USART_BUS == 1)
+#include <task.h>
+#endif
+
 #if defined(portW5200)
 #include <w5200.h>
 #else
@@ -25,6 +37,121 @@
 /* Declare a binary Semaphore flag for the SPI Bus. To ensure only single access to SPI Bus. */
 xSemaphoreHandle xSPISemaphore; // removed STATIC to allow ramfs.c to use same semaphore.
 
+#if (SPI_ASYNC == 1)
+/* Given by the SPI_STC interrupt when an interrupt driven transfer completes. */
+static xSemaphoreHandle xSPIDoneSemaphore;
+
+/* The transfer being moved by the SPI_STC interrupt. */
+static const uint8_t * volatile spiAsyncTx;
+static uint8_t * volatile spiAsyncRx;
+static volatile uint16_t spiAsyncRemaining;
+
+static uint8_t spiAsyncWorthwhile(const uint16_t length);
+#endif
+
+#if (SPI_USART_BUS == 1)
+/* The registers of a USART used as an SPI bus, and its XCK (SCK) pin. */
+typedef struct
+{
+	volatile uint8_t *ucsra;
+	volatile uint8_t *ucsrb;
+	volatile uint8_t *ucsrc;
+	volatile uint16_t *ubrr;
+	volatile uint8_t *udr;
+	volatile uint8_t *xckDir;
+	uint8_t xckBit;
+} SPI_USART;
+
+/* One for each SPI_BUS after SPI_BUS_SPI, in the same order. */
+static const SPI_USART spiUsart[SPI_BUSES - 1] =
+{
+#if defined(UBRR1)
+	{ &UCSR1A, &UCSR1B, &UCSR1C, &UBRR1, &UDR1, &SPI_USART1_PORT_DIR_XCK, SPI_USART1_BIT_XCK },
+#endif
+#if defined(UBRR2)
+	{ &UCSR2A, &UCSR2B, &UCSR2C, &UBRR2, &UDR2, &SPI_USART2_PORT_DIR_XCK, SPI_USART2_BIT_XCK },
+#endif
+#if defined(UBRR3)
+	{ &UCSR3A, &UCSR3B, &UCSR3C, &UBRR3, &UDR3, &SPI_USART3_PORT_DIR_XCK, SPI_USART3_BIT_XCK },
+#endif
+};
+
+/* MSPIM bits in UCSRnC. They are in the same place in every USART. */
+#define SPI_USART_MSPIM		(_BV(UMSEL01) | _BV(UMSEL00))
+#define SPI_USART_UDORD		_BV(UCSZ01)		// LSB first
+#define SPI_USART_UCPHA		_BV(UCSZ00)
+#define SPI_USART_UCPOL		_BV(UCPOL0)
+
+/* UBRRn for each SPI_CLOCK_DIVx, as MSPIM SCK = F_CPU / (2 * (UBRRn + 1)). */
+static const uint8_t spiUsartUBRR[8] = { 1, 7, 31, 63, 0, 3, 15, 31 };
+
+/* Semaphores for the USART buses. The SPI module uses xSPISemaphore. */
+static xSemaphoreHandle xSPIUsartSemaphore[SPI_BUSES - 1];
+
+/* The bus each device is bound to. Default is the last SPI_SLAVE_SELECT. */
+static uint8_t spiDeviceBus[Default + 1];
+
+/* The task holding each bus, and when it took it, so the calls that don't
+ * name a device can go to the bus the task took most recently. */
+static xTaskHandle xSPIBusOwner[SPI_BUSES];
+static uint8_t spiBusTakenAt[SPI_BUSES];
+static uint8_t spiBusTakes;
+
+static xSemaphoreHandle spiBusSemaphore(const uint8_t bus);
+static uint8_t spiCurrentBus(void);
+static void spiUsartBegin(const uint8_t bus);
+static void spiUsartSetClockDivider(const uint8_t bus, uint8_t rate);
+static void spiUsartSetDataMode(const uint8_t bus, uint8_t mode);
+static void spiUsartSetBitOrder(const uint8_t bus, uint8_t bitOrder);
+static uint8_t spiUsartExchange(const uint8_t bus, const uint8_t *tx, uint8_t *rx, uint16_t length);
+static uint8_t spiUsartTransaction(const uint8_t bus, const SPI_SEGMENT *segments, const uint8_t count);
+#endif
+
+#if (SPI_ASM_DIV2 == 1)
+/* The SPI module is at SPI_CLOCK_DIV2, and the kernels can be used. */
+#define spiAtDiv2()	( !(SPCR & SPI_CLOCK_MASK) && (SPSR & SPI_2XCLOCK_MASK) )
+
+static void spiDiv2Tx(const uint8_t *data, uint16_t length);
+static void spiDiv2Rx(uint8_t *data, uint16_t length);
+static void spiDiv2Exchange(const uint8_t *tx, uint8_t *rx, uint16_t length);
+static uint16_t spiDiv2TxCRC16(const uint8_t *data, uint16_t length, uint16_t crc);
+#endif
+
+#if (SPI_STATS == 1)
+#if ( configGENERATE_RUN_TIME_STATS == 0 )
+#error SPI_STATS times the bus with the run time counter, so configGENERATE_RUN_TIME_STATS must also be set to 1.
+#endif
+
+#if (SPI_USART_BUS == 0)
+#define SPI_BUS_SPI		0		// Without the USART buses the SPI module is the only bus.
+#define SPI_BUSES		1
+#define spiStatsBus(SS_pin)	SPI_BUS_SPI
+#else
+#define spiStatsBus(SS_pin)	spiDeviceBus[SS_pin]
+#endif
+
+static SPI_STATISTICS spiStats[Default + 1];
+
+// For each bus, when it was taken and the bytes moved since. Only the task
+// holding the bus changes these.
+static uint32_t spiStatsTakenAt[SPI_BUSES];
+static uint32_t spiStatsBytes[SPI_BUSES];
+
+static void spiStatsWaited(SPI_SLAVE_SELECT SS_pin, const uint32_t waitStart, const uint8_t taken);
+static void spiStatsBegin(SPI_SLAVE_SELECT SS_pin);
+static void spiStatsEnd(SPI_SLAVE_SELECT SS_pin);
+
+#define spiStatsAddBytes(bus, n)	( spiStatsBytes[bus] += (n) )
+#else
+#define spiStatsAddBytes(bus, n)
+#endif
+
+static void spiModuleSetClockDivider(uint8_t rate);
+static void spiModuleSetDataMode(uint8_t mode);
+static void spiAssertSS(SPI_SLAVE_SELECT SS_pin);
+static void spiReleaseSS(SPI_SLAVE_SELECT SS_pin);
+static uint8_t spiSegmentTransfer(const SPI_SEGMENT *segment);
+
 /*******************************************************/
 
 void spiBegin(SPI_SLAVE_SELECT SS_pin)
@@ -87,6 +214,20 @@ void spiBegin(SPI_SLAVE_SELECT SS_pin)
 
     if( xSPISemaphore == NULL ) 					/* Check to see if the semaphore has not been created. */
     	vSemaphoreCreateBinary( xSPISemaphore );	/* Then create the SPI bus binary semaphore */
+
+#if (SPI_ASYNC == 1)
+	if( xSPIDoneSemaphore == NULL )
+	{
+		vSemaphoreCreateBinary( xSPIDoneSemaphore );	/* Created given, so take it. Only the interrupt gives it. */
+		if( xSPIDoneSemaphore != NULL )
+			xSemaphoreTake( xSPIDoneSemaphore, 0 );
+	}
+#endif
+
+#if (SPI_USART_BUS == 1)
+	if ( spiDeviceBus[SS_pin] != SPI_BUS_SPI )
+		spiUsartBegin( spiDeviceBus[SS_pin] );
+#endif
 }
 
 
@@ -96,18 +237,55 @@ void spiEnd()
 	if( xSPISemaphore != NULL )
 		vQueueDelete( xSPISemaphore );		/* FreeRTOS semaphore */
 
+#if (SPI_ASYNC == 1)
+	if( xSPIDoneSemaphore != NULL )
+		vQueueDelete( xSPIDoneSemaphore );
+	xSPIDoneSemaphore = NULL;
+#endif
+
 	SPCR &= ~( _BV(MSTR) | _BV(SPE) );
 	// Don't bother to tidy up. This function is not likely to be actually used.
 }
 
+// spiSetClockDivider() and spiSetDataMode() are called before every transfer
+// by drivers sharing the bus, and nearly always find the bus already set up.
+// Compare first, and only write SPCR or SPSR if something changes.
+
 inline void spiSetClockDivider(uint8_t rate)
 {
-	SPCR = (SPCR & ~SPI_CLOCK_MASK) | (rate & SPI_CLOCK_MASK);
-	SPSR = (SPSR & ~SPI_2XCLOCK_MASK) | ((rate >> 2) & SPI_2XCLOCK_MASK);
+#if (SPI_USART_BUS == 1)
+	uint8_t bus = spiCurrentBus();
+
+	if ( bus != SPI_BUS_SPI )
+	{
+		spiUsartSetClockDivider(bus, rate);
+		return;
+	}
+#endif
+
+	spiModuleSetClockDivider(rate);
+}
+
+static void spiModuleSetClockDivider(uint8_t rate)
+{
+	if ( (SPCR & SPI_CLOCK_MASK) != (rate & SPI_CLOCK_MASK) )
+		SPCR = (SPCR & ~SPI_CLOCK_MASK) | (rate & SPI_CLOCK_MASK);
+	if ( (SPSR & SPI_2XCLOCK_MASK) != ((rate >> 2) & SPI_2XCLOCK_MASK) )
+		SPSR = (SPSR & ~SPI_2XCLOCK_MASK) | ((rate >> 2) & SPI_2XCLOCK_MASK);
 }
 
 inline void spiSetBitOrder(uint8_t bitOrder)
 {
+#if (SPI_USART_BUS == 1)
+	uint8_t bus = spiCurrentBus();
+
+	if ( bus != SPI_BUS_SPI )
+	{
+		spiUsartSetBitOrder(bus, bitOrder);
+		return;
+	}
+#endif
+
 	if(bitOrder == SPI_LSBFIRST) {
 		SPCR |= _BV(DORD);
 	} else {
@@ -117,7 +295,23 @@ inline void spiSetBitOrder(uint8_t bitOrder)
 
 inline void spiSetDataMode(uint8_t mode)
 {
-	SPCR = (SPCR & ~SPI_MODE_MASK) | mode;
+#if (SPI_USART_BUS == 1)
+	uint8_t bus = spiCurrentBus();
+
+	if ( bus != SPI_BUS_SPI )
+	{
+		spiUsartSetDataMode(bus, mode);
+		return;
+	}
+#endif
+
+	spiModuleSetDataMode(mode);
+}
+
+static void spiModuleSetDataMode(uint8_t mode)
+{
+	if ( (SPCR & SPI_MODE_MASK) != mode )
+		SPCR = (SPCR & ~SPI_MODE_MASK) | mode;
 }
 
 
@@ -138,28 +332,9 @@ inline void spiDetachInterrupt()
 uint8_t spiSelect(SPI_SLAVE_SELECT SS_pin)	/* 1:Successful, 0:Timeout */
 {
 
-	if ( (xSemaphoreTake( xSPISemaphore, (SPI_TIMEOUT / portTICK_RATE_MS )) == pdTRUE )	)
+	if ( spiTakeBus(SS_pin) )
 	{
-
-		switch (SS_pin)
-		{
-		case Wiznet:	// added for EtherMega Wiznet 5100/5200 support
-#if defined(__DEF_W5100_DFROBOT__) && defined(_W5100_H_)
-			W5100_SEN_ENABLE(1); // Enable SEN, to get on the SPI bus. PORT D7
-#endif
-			SPI_PORT &= ~SPI_BIT_SS_WIZNET;
-			break;
-
-		case SDCard:	// added for  SD Card support
-			SPI_PORT_SS_SD &= ~SPI_BIT_SS_SD; // Pull SS low to select the card.
-			break;
-
-		case Default:	// default SS line for Arduino Uno
-		default:
-			SPI_PORT &= ~SPI_BIT_SS;
-			break;
-		}
-
+		spiAssertSS(SS_pin);
 		return 1;	// OK /
 	}
 	else
@@ -172,6 +347,85 @@ uint8_t spiSelect(SPI_SLAVE_SELECT SS_pin)	/* 1:Successful, 0:Timeout */
 /*-----------------------------------------------------------------------*/
 
 void spiDeselect(SPI_SLAVE_SELECT SS_pin)
+{
+	spiReleaseSS(SS_pin);
+	spiGiveBus(SS_pin);
+}
+
+
+uint8_t spiTakeBus(SPI_SLAVE_SELECT SS_pin)	/* 1:Successful, 0:Timeout */
+{
+	uint8_t taken;
+#if (SPI_STATS == 1)
+	uint32_t waitStart = portGET_RUN_TIME_COUNTER_VALUE();
+#endif
+
+#if (SPI_USART_BUS == 1)
+	uint8_t bus = spiDeviceBus[SS_pin];
+
+	taken = ( xSemaphoreTake( spiBusSemaphore(bus), (SPI_TIMEOUT / portTICK_RATE_MS) ) == pdTRUE );
+
+	if ( taken )
+	{
+		xSPIBusOwner[bus] = xTaskGetCurrentTaskHandle();
+		spiBusTakenAt[bus] = ++spiBusTakes;
+	}
+#else
+	(void) SS_pin;
+	taken = ( xSemaphoreTake( xSPISemaphore, (SPI_TIMEOUT / portTICK_RATE_MS) ) == pdTRUE );
+#endif
+
+#if (SPI_STATS == 1)
+	spiStatsWaited(SS_pin, waitStart, taken);
+	if ( taken ) spiStatsBegin(SS_pin);
+#endif
+	return taken;
+}
+
+
+void spiGiveBus(SPI_SLAVE_SELECT SS_pin)
+{
+#if (SPI_STATS == 1)
+	spiStatsEnd(SS_pin);
+#endif
+
+#if (SPI_USART_BUS == 1)
+	uint8_t bus = spiDeviceBus[SS_pin];
+
+	xSPIBusOwner[bus] = NULL;
+	xSemaphoreGive( spiBusSemaphore(bus) );
+#else
+	(void) SS_pin;
+	xSemaphoreGive( xSPISemaphore );	/* Free FreeRTOS semaphore to allow other SPI access */
+#endif
+}
+
+
+static void spiAssertSS(SPI_SLAVE_SELECT SS_pin)
+{
+	// Pull SS low to select the device.
+	switch (SS_pin)
+	{
+	case Wiznet:	// added for EtherMega Wiznet 5100/5200 support
+#if defined(__DEF_W5100_DFROBOT__) && defined(_W5100_H_)
+		W5100_SEN_ENABLE(1); // Enable SEN, to get on the SPI bus. PORT D7
+#endif
+		SPI_PORT &= ~SPI_BIT_SS_WIZNET;
+		break;
+
+	case SDCard:	// added for  SD Card support
+		SPI_PORT_SS_SD &= ~SPI_BIT_SS_SD; // Pull SS low to select the card.
+		break;
+
+	case Default:	// default SS line for Arduino Uno
+	default:
+		SPI_PORT &= ~SPI_BIT_SS;
+		break;
+	}
+}
+
+
+static void spiReleaseSS(SPI_SLAVE_SELECT SS_pin)
 {
 	// Pull SS high to Deselect the card.
 	switch (SS_pin)
@@ -193,14 +447,19 @@ void spiDeselect(SPI_SLAVE_SELECT SS_pin)
 		SPI_PORT |= SPI_BIT_SS;
 		break;
 	}
-
-	xSemaphoreGive( xSPISemaphore );	/* Free FreeRTOS semaphore to allow other SPI access */
 }
 
 
 
 inline uint8_t spiTransfer(uint8_t data)
 {
+#if (SPI_USART_BUS == 1)
+	uint8_t bus = spiCurrentBus();
+
+	if ( bus != SPI_BUS_SPI )
+		return spiUsartExchange(bus, &data, &data, 1) ? data : 0;
+#endif
+
 	// Make sure you manually pull slave select low to indicate start of transfer.
 	// That is NOT done by this function..., because...
 	// Some devices need to have their SS held low across multiple transfer calls.
@@ -214,6 +473,8 @@ inline uint8_t spiTransfer(uint8_t data)
 	// We will try to recover by setting the MSTR bit.
 	if ( !(SPCR & _BV(MSTR)) ) SPCR |= _BV(MSTR);
 
+	spiStatsAddBytes(SPI_BUS_SPI, 1);
+
 	SPDR = data; 	// Begin transmission
 
 	while ( !(SPSR & _BV(SPIF)) )
@@ -241,12 +502,20 @@ inline uint8_t spiTransfer(uint8_t data)
  *
  * Worth doing if you can!
  *
+ * At SPI_CLOCK_DIV2 the SPI_ASM_DIV2 kernels below take 1.125uS a byte to
+ * send, and 1.1875uS to receive.
+ *
  */
 
 uint8_t spiMultiByteTx(const uint8_t *data, const uint16_t length)
 {
 	uint16_t index = 0;
 	uint8_t TxByte;
+#if (SPI_USART_BUS == 1)
+	uint8_t bus = spiCurrentBus();
+
+	if ( bus != SPI_BUS_SPI ) return spiUsartExchange(bus, data, NULL, length);
+#endif
 
 	// Make sure you manually pull slave select low to indicate start of transfer.
 	// That is NOT done by this function..., because...
@@ -263,6 +532,24 @@ uint8_t spiMultiByteTx(const uint8_t *data, const uint16_t length)
 	if ( !(SPCR & _BV(MSTR)) ) SPCR |= _BV(MSTR);
 	if ( !(SPCR & _BV(MSTR)) ) return 0;
 
+	spiStatsAddBytes(SPI_BUS_SPI, length);
+
+#if (SPI_ASM_DIV2 == 1)
+	if ( length != 0 && spiAtDiv2() )
+	{
+		spiDiv2Tx(data, length);
+		return 1;
+	}
+#endif
+
+#if (SPI_ASYNC == 1)
+	if ( spiAsyncWorthwhile(length) )
+	{
+		SPI_TRANSFER transfer = { data, NULL, length };
+		return spiAsyncStart(&transfer) && spiAsyncWait();
+	}
+#endif
+
 	SPDR = data[ index++ ]; // Begin transmission
 	while (index < length)
 	{
@@ -282,6 +569,11 @@ uint8_t spiMultiByteRx(uint8_t *data, const uint16_t length)
 {
 	uint16_t index = 0;
 	uint8_t RxByte;
+#if (SPI_USART_BUS == 1)
+	uint8_t bus = spiCurrentBus();
+
+	if ( bus != SPI_BUS_SPI ) return spiUsartExchange(bus, NULL, data, length);
+#endif
 
 	// Make sure you manually pull slave select low to indicate start of transfer.
 	// That is NOT done by this function..., because...
@@ -298,6 +590,24 @@ uint8_t spiMultiByteRx(uint8_t *data, const uint16_t length)
 	if ( !(SPCR & _BV(MSTR)) ) SPCR |= _BV(MSTR);
 	if ( !(SPCR & _BV(MSTR)) ) return 0;
 
+	spiStatsAddBytes(SPI_BUS_SPI, length);
+
+#if (SPI_ASM_DIV2 == 1)
+	if ( length != 0 && spiAtDiv2() )
+	{
+		spiDiv2Rx(data, length);
+		return 1;
+	}
+#endif
+
+#if (SPI_ASYNC == 1)
+	if ( spiAsyncWorthwhile(length) )
+	{
+		SPI_TRANSFER transfer = { NULL, data, length };
+		return spiAsyncStart(&transfer) && spiAsyncWait();
+	}
+#endif
+
 	SPDR = 0xFF; // Begin dummy transmission
 	while (index < length - 1)
 	{
@@ -320,6 +630,11 @@ inline uint8_t spiMultiByteTransfer(uint8_t *data, const uint16_t length)
 {
 	uint16_t index = 0;
 	uint8_t TxByte, RxByte;
+#if (SPI_USART_BUS == 1)
+	uint8_t bus = spiCurrentBus();
+
+	if ( bus != SPI_BUS_SPI ) return spiUsartExchange(bus, data, data, length);
+#endif
 
 	// Make sure you manually pull slave select low to indicate start of transfer.
 	// That is NOT done by this function..., because...
@@ -336,6 +651,24 @@ inline uint8_t spiMultiByteTransfer(uint8_t *data, const uint16_t length)
 	if ( !(SPCR & _BV(MSTR)) ) SPCR |= _BV(MSTR);
 	if ( !(SPCR & _BV(MSTR)) ) return 0;
 
+	spiStatsAddBytes(SPI_BUS_SPI, length);
+
+#if (SPI_ASM_DIV2 == 1)
+	if ( length != 0 && spiAtDiv2() )
+	{
+		spiDiv2Exchange(data, data, length);
+		return 1;
+	}
+#endif
+
+#if (SPI_ASYNC == 1)
+	if ( spiAsyncWorthwhile(length) )
+	{
+		SPI_TRANSFER transfer = { data, data, length };
+		return spiAsyncStart(&transfer) && spiAsyncWait();
+	}
+#endif
+
 	SPDR = data[ index ]; // Begin first byte transfer
 	while (index < length - 1)
 	{
@@ -355,3 +688,665 @@ inline uint8_t spiMultiByteTransfer(uint8_t *data, const uint16_t length)
 	// That is NOT done by this function.
 	// Using spiDeselect (SS_pin);
 }
+
+uint8_t spiMultiByteTxCRC16(const uint8_t *data, const uint16_t length, uint16_t *crc)
+{
+	uint16_t index = 0;
+	uint8_t TxByte, x;
+
+#if (SPI_USART_BUS == 1)
+	if ( spiCurrentBus() != SPI_BUS_SPI ) return 0;
+#endif
+
+	if ( !(SPCR & _BV(SPE)) ) return 0;
+	if ( !(SPCR & _BV(MSTR)) ) SPCR |= _BV(MSTR);
+	if ( !(SPCR & _BV(MSTR)) ) return 0;
+
+	if ( length == 0 ) return 1;
+
+	spiStatsAddBytes(SPI_BUS_SPI, length);
+
+#if (SPI_ASM_DIV2 == 1)
+	if ( spiAtDiv2() )
+	{
+		*crc = spiDiv2TxCRC16(data, length, *crc);
+		return 1;
+	}
+#endif
+
+	while (index < length)
+	{
+		TxByte = data[ index++ ];
+		SPDR = TxByte;					// send the byte, and work out its CRC while it goes
+		x = (uint8_t)(*crc >> 8) ^ TxByte;
+		x ^= x >> 4;
+		*crc = (*crc << 8) ^ ((uint16_t)x << 12) ^ ((uint16_t)x << 5) ^ x;
+		while ( !(SPSR & _BV(SPIF)) );
+	}
+	return 1;
+}
+
+/*-----------------------------------------------------------------------*/
+/* Transactions                                                          */
+/*-----------------------------------------------------------------------*/
+
+uint8_t spiTransaction(const SPI_SEGMENT *segments, const uint8_t count)
+{
+	uint8_t index;
+	uint8_t result = 1;
+#if (SPI_STATS == 1)
+	uint32_t waitStart;
+#endif
+
+#if (SPI_USART_BUS == 1)
+	if ( count != 0 && spiDeviceBus[segments->SS_pin] != SPI_BUS_SPI )
+		return spiUsartTransaction(spiDeviceBus[segments->SS_pin], segments, count);
+#endif
+
+#if (SPI_STATS == 1)
+	waitStart = portGET_RUN_TIME_COUNTER_VALUE();
+	result = ( xSemaphoreTake( xSPISemaphore, (SPI_TIMEOUT / portTICK_RATE_MS) ) == pdTRUE );
+	if ( count != 0 ) spiStatsWaited(segments->SS_pin, waitStart, result);
+	if ( !result ) return 0;
+#else
+	if ( xSemaphoreTake( xSPISemaphore, (SPI_TIMEOUT / portTICK_RATE_MS) ) != pdTRUE ) return 0;
+#endif
+
+	// If the SPI module has not been enabled yet, then return with nothing.
+	// Check master mode once only at the start, as spiMultiByteTx() does.
+	if ( !(SPCR & _BV(SPE)) ) result = 0;
+	else if ( !(SPCR & _BV(MSTR)) ) SPCR |= _BV(MSTR);
+	if ( !(SPCR & _BV(MSTR)) ) result = 0;
+
+	for ( index = 0; result && index < count; ++index, ++segments )
+	{
+#if (SPI_USART_BUS == 1)
+		if ( spiDeviceBus[segments->SS_pin] != SPI_BUS_SPI )
+		{
+			result = 0;
+			break;
+		}
+#endif
+		// Both of these skip the register write when the bus is already set up.
+		spiModuleSetDataMode(segments->mode);
+		spiModuleSetClockDivider(segments->divider);
+
+#if (SPI_STATS == 1)
+		spiStatsBegin(segments->SS_pin);
+#endif
+		spiAssertSS(segments->SS_pin);
+		result = spiSegmentTransfer(segments);
+		spiReleaseSS(segments->SS_pin);
+#if (SPI_STATS == 1)
+		spiStatsEnd(segments->SS_pin);
+#endif
+	}
+
+	xSemaphoreGive( xSPISemaphore );
+	return result;
+}
+
+static uint8_t spiSegmentTransfer(const SPI_SEGMENT *segment)
+{
+	const uint8_t *tx = segment->txData;
+	uint8_t *rx = segment->rxData;
+	uint16_t remaining = segment->length;
+	uint8_t TxByte, RxByte;
+
+	if ( remaining == 0 ) return 1;
+
+	spiStatsAddBytes(SPI_BUS_SPI, remaining);
+
+#if (SPI_ASM_DIV2 == 1)
+	if ( (tx != NULL || rx != NULL) && spiAtDiv2() )
+	{
+		if ( tx == NULL ) spiDiv2Rx(rx, remaining);
+		else if ( rx == NULL ) spiDiv2Tx(tx, remaining);
+		else spiDiv2Exchange(tx, rx, remaining);
+		return 1;
+	}
+#endif
+
+#if (SPI_ASYNC == 1)
+	if ( spiAsyncWorthwhile(remaining) )
+	{
+		SPI_TRANSFER transfer = { tx, rx, remaining };
+		return spiAsyncStart(&transfer) && spiAsyncWait();
+	}
+#endif
+
+	SPDR = (tx != NULL) ? *tx++ : 0xFF;	// Begin first byte transfer
+	while ( --remaining != 0 )
+	{
+		TxByte = (tx != NULL) ? *tx++ : 0xFF;	// pre-load the next byte, while transferring
+		while ( !(SPSR & _BV(SPIF)) );
+		RxByte = SPDR;
+		SPDR = TxByte;
+		if ( rx != NULL ) *rx++ = RxByte;	// store the byte that was read, while transferring
+	}
+	while ( !(SPSR & _BV(SPIF)) );
+
+	RxByte = SPDR;
+	if ( rx != NULL ) *rx = RxByte;		// store the last byte that was read
+	return 1;
+}
+
+#if (SPI_ASM_DIV2 == 1)
+
+/*-----------------------------------------------------------------------*/
+/* SPI_CLOCK_DIV2 transfer kernels                                       */
+/*-----------------------------------------------------------------------*/
+
+// At SPI_CLOCK_DIV2 a byte takes 16 CPU cycles, less than one turn of a
+// polling loop, so the loops in C lose a few cycles on every byte. These
+// write SPDR blind instead, a counted 18 cycles after the write before,
+// which is after the byte has gone (writing sooner sets WCOL, and the byte
+// is lost). The receive loops read each byte before writing the next, at 19
+// cycles a byte, as there is only one receive buffer. So an interrupt only
+// makes a gap longer, never lets a byte be overwritten or lost, and they can
+// run with interrupts on. At the end SPIF is cleared, as the polled loops
+// leave it. The cycle counts are from the start of the out that sends a
+// byte. Every length must be at least 1, and the SPI must be idle at
+// SPI_CLOCK_DIV2.
+
+static void spiDiv2Tx(const uint8_t *data, uint16_t length)
+{
+	asm volatile (
+		"ld		__tmp_reg__, %a[data]+		\n\t"
+		"1:									\n\t"
+		"out	%[spdr], __tmp_reg__		\n\t"	// 0	send a byte
+		"sbiw	%[length], 1				\n\t"	// 1
+		"breq	2f							\n\t"	// 3
+		"ld		__tmp_reg__, %a[data]+		\n\t"	// 4	pre-load the next byte
+		"rjmp	.+0							\n\t"	// 6	2 cycle delays
+		"rjmp	.+0							\n\t"	// 8
+		"rjmp	.+0							\n\t"	// 10
+		"rjmp	.+0							\n\t"	// 12
+		"rjmp	.+0							\n\t"	// 14
+		"rjmp	1b							\n\t"	// 16	on to the out at 18
+		"2:									\n\t"	// 5	after the last byte
+		"rjmp	.+0							\n\t"	// 5
+		"rjmp	.+0							\n\t"	// 7
+		"rjmp	.+0							\n\t"	// 9
+		"rjmp	.+0							\n\t"	// 11
+		"rjmp	.+0							\n\t"	// 13
+		"rjmp	.+0							\n\t"	// 15
+		"nop								\n\t"	// 17
+		"in		__tmp_reg__, %[spsr]		\n\t"	// 18	the last byte has gone,
+		"in		__tmp_reg__, %[spdr]		\n\t"	// 19	so clear SPIF
+		: [data] "+z" (data), [length] "+w" (length)
+		: [spdr] "I" (_SFR_IO_ADDR(SPDR)), [spsr] "I" (_SFR_IO_ADDR(SPSR))
+		: "memory"
+	);
+}
+
+static void spiDiv2Rx(uint8_t *data, uint16_t length)
+{
+	// Each byte is read before the next is started, so the next byte can't
+	// overwrite it in the receive buffer, however late the read is.
+	asm volatile (
+		"out	%[spdr], %[ff]				\n\t"	// 0	start the first byte
+		"sbiw	%[length], 1				\n\t"	// 1
+		"breq	2f							\n\t"	// 3
+		"rjmp	.+0							\n\t"	// 4
+		"nop								\n\t"	// 6
+		"1:									\n\t"	// 7
+		"rjmp	.+0							\n\t"	// 7	2 cycle delays
+		"rjmp	.+0							\n\t"	// 9
+		"rjmp	.+0							\n\t"	// 11
+		"rjmp	.+0							\n\t"	// 13
+		"rjmp	.+0							\n\t"	// 15
+		"nop								\n\t"	// 17
+		"in		__tmp_reg__, %[spdr]		\n\t"	// 18	read the byte that is in,
+		"out	%[spdr], %[ff]				\n\t"	// 19 (0)	then start the next
+		"st		%a[data]+, __tmp_reg__		\n\t"	// 1
+		"sbiw	%[length], 1				\n\t"	// 3
+		"brne	1b							\n\t"	// 5	on to 7
+		"2:									\n\t"	// 6, or 5 for a single byte
+		"rjmp	.+0							\n\t"	// 6
+		"rjmp	.+0							\n\t"	// 8
+		"rjmp	.+0							\n\t"	// 10
+		"rjmp	.+0							\n\t"	// 12
+		"rjmp	.+0							\n\t"	// 14
+		"rjmp	.+0							\n\t"	// 16
+		"rjmp	.+0							\n\t"	// 18
+		"in		__tmp_reg__, %[spsr]		\n\t"	// 20	the last byte is in,
+		"in		__tmp_reg__, %[spdr]		\n\t"	// 21	so clear SPIF and read it
+		"st		%a[data], __tmp_reg__		\n\t"
+		: [data] "+z" (data), [length] "+w" (length)
+		: [spdr] "I" (_SFR_IO_ADDR(SPDR)), [spsr] "I" (_SFR_IO_ADDR(SPSR)), [ff] "r" ((uint8_t)0xFF)
+		: "memory"
+	);
+}
+
+static void spiDiv2Exchange(const uint8_t *tx, uint8_t *rx, uint16_t length)
+{
+	// As spiDiv2Rx(), with the pre-load of the next byte in place of a delay.
+	// tx and rx may be the same buffer, as rx trails tx.
+	uint8_t next;
+
+	asm volatile (
+		"ld		%[next], %a[tx]+			\n\t"
+		"out	%[spdr], %[next]			\n\t"	// 0	send the first byte
+		"sbiw	%[length], 1				\n\t"	// 1
+		"breq	2f							\n\t"	// 3
+		"rjmp	.+0							\n\t"	// 4
+		"nop								\n\t"	// 6
+		"1:									\n\t"	// 7
+		"ld		%[next], %a[tx]+			\n\t"	// 7	pre-load the next byte
+		"rjmp	.+0							\n\t"	// 9
+		"rjmp	.+0							\n\t"	// 11
+		"rjmp	.+0							\n\t"	// 13
+		"rjmp	.+0							\n\t"	// 15
+		"nop								\n\t"	// 17
+		"in		__tmp_reg__, %[spdr]		\n\t"	// 18	read the byte that is in,
+		"out	%[spdr], %[next]			\n\t"	// 19 (0)	then send the next
+		"st		%a[rx]+, __tmp_reg__		\n\t"	// 1
+		"sbiw	%[length], 1				\n\t"	// 3
+		"brne	1b							\n\t"	// 5	on to 7
+		"2:									\n\t"	// 6, or 5 for a single byte
+		"rjmp	.+0							\n\t"	// 6
+		"rjmp	.+0							\n\t"	// 8
+		"rjmp	.+0							\n\t"	// 10
+		"rjmp	.+0							\n\t"	// 12
+		"rjmp	.+0							\n\t"	// 14
+		"rjmp	.+0							\n\t"	// 16
+		"rjmp	.+0							\n\t"	// 18
+		"in		__tmp_reg__, %[spsr]		\n\t"	// 20	the last byte is in,
+		"in		__tmp_reg__, %[spdr]		\n\t"	// 21	so clear SPIF and read it
+		"st		%a[rx], __tmp_reg__			\n\t"
+		: [tx] "+z" (tx), [rx] "+x" (rx), [length] "+w" (length), [next] "=&r" (next)
+		: [spdr] "I" (_SFR_IO_ADDR(SPDR)), [spsr] "I" (_SFR_IO_ADDR(SPSR))
+		: "memory"
+	);
+}
+
+static uint16_t spiDiv2TxCRC16(const uint8_t *data, uint16_t length, uint16_t crc)
+{
+	uint8_t x, t;
+
+	// The CRC of each byte is worked out while it is sent, taking the place
+	// of the delay, so the bytes go at 26 cycles rather than 18.
+	// x = (crc >> 8) ^ byte, x ^= x >> 4, crc = (crc << 8) ^ (x << 12) ^ (x << 5) ^ x
+	asm volatile (
+		"ld		%[x], %a[data]+				\n\t"
+		"1:									\n\t"
+		"out	%[spdr], %[x]				\n\t"	// 0	send a byte
+		"eor	%[x], %B[crc]				\n\t"	// 1	x = byte ^ crc high
+		"mov	%[t], %[x]					\n\t"	// 2
+		"swap	%[t]						\n\t"	// 3
+		"andi	%[t], 0x0F					\n\t"	// 4
+		"eor	%[x], %[t]					\n\t"	// 5	x ^= x >> 4
+		"mov	%B[crc], %A[crc]			\n\t"	// 6	crc high = crc low
+		"mov	%[t], %[x]					\n\t"	// 7
+		"swap	%[t]						\n\t"	// 8
+		"andi	%[t], 0xF0					\n\t"	// 9
+		"eor	%B[crc], %[t]				\n\t"	// 10	^ x << 12
+		"lsl	%[t]						\n\t"	// 11
+		"mov	%A[crc], %[x]				\n\t"	// 12	crc low = x
+		"eor	%A[crc], %[t]				\n\t"	// 13	^ low byte of x << 5
+		"mov	%[t], %[x]					\n\t"	// 14
+		"lsr	%[t]						\n\t"	// 15
+		"lsr	%[t]						\n\t"	// 16
+		"lsr	%[t]						\n\t"	// 17
+		"eor	%B[crc], %[t]				\n\t"	// 18	^ high byte of x << 5
+		"sbiw	%[length], 1				\n\t"	// 19
+		"breq	2f							\n\t"	// 21
+		"ld		%[x], %a[data]+				\n\t"	// 22	pre-load the next byte
+		"rjmp	1b							\n\t"	// 24	on to the out at 26
+		"2:									\n\t"	// 23	the last byte has gone,
+		"in		__tmp_reg__, %[spsr]		\n\t"	// 23	so clear SPIF
+		"in		__tmp_reg__, %[spdr]		\n\t"
+		: [data] "+z" (data), [length] "+w" (length), [crc] "+r" (crc), [x] "=&r" (x), [t] "=&d" (t)
+		: [spdr] "I" (_SFR_IO_ADDR(SPDR)), [spsr] "I" (_SFR_IO_ADDR(SPSR))
+		: "memory"
+	);
+
+	return crc;
+}
+
+#endif
+
+#if (SPI_USART_BUS == 1)
+
+/*-----------------------------------------------------------------------*/
+/* USART buses                                                           */
+/*-----------------------------------------------------------------------*/
+
+void spiBindBus(SPI_SLAVE_SELECT SS_pin, SPI_BUS bus)
+{
+	spiDeviceBus[SS_pin] = bus;
+}
+
+static xSemaphoreHandle spiBusSemaphore(const uint8_t bus)
+{
+	return ( bus == SPI_BUS_SPI ) ? xSPISemaphore : xSPIUsartSemaphore[bus - 1];
+}
+
+static uint8_t spiCurrentBus(void)
+{
+	xTaskHandle xTask = xTaskGetCurrentTaskHandle();
+	uint8_t bus, current = SPI_BUS_SPI;
+	uint8_t age, youngest = 0xFF;
+
+	// Before any task is created there is no owner to tell apart.
+	if ( xTask == NULL ) return SPI_BUS_SPI;
+
+	// Of the buses this task holds, the one it took last. The ages wrap
+	// safely, as a task holds no more than SPI_BUSES at once.
+	for ( bus = 0; bus < SPI_BUSES; ++bus )
+	{
+		if ( xSPIBusOwner[bus] != xTask ) continue;
+
+		age = spiBusTakes - spiBusTakenAt[bus];
+		if ( age <= youngest )
+		{
+			youngest = age;
+			current = bus;
+		}
+	}
+
+	return current;
+}
+
+static void spiUsartBegin(const uint8_t bus)
+{
+	const SPI_USART *usart = &spiUsart[bus - 1];
+
+	// UBRRn must be 0 when the transmitter is enabled, so XCK starts at once.
+	// Then set the same clock, mode and bit order as the SPI module starts with.
+	*usart->ubrr = 0;
+	*usart->xckDir |= usart->xckBit;			// XCK as output makes the USART the master
+	*usart->ucsrc = SPI_USART_MSPIM;			// SPI_MODE0, MSB first
+	*usart->ucsrb = _BV(RXEN0) | _BV(TXEN0);	// TXD and RXD are taken over by the USART
+	*usart->ubrr = spiUsartUBRR[SPI_CLOCK_DIV4];
+
+	if( xSPIUsartSemaphore[bus - 1] == NULL )
+		vSemaphoreCreateBinary( xSPIUsartSemaphore[bus - 1] );
+}
+
+static void spiUsartSetClockDivider(const uint8_t bus, uint8_t rate)
+{
+	const SPI_USART *usart = &spiUsart[bus - 1];
+	uint16_t ubrr = spiUsartUBRR[ rate & (SPI_2XCLOCK_MASK << 2 | SPI_CLOCK_MASK) ];
+
+	if ( *usart->ubrr != ubrr )
+		*usart->ubrr = ubrr;
+}
+
+static void spiUsartSetDataMode(const uint8_t bus, uint8_t mode)
+{
+	const SPI_USART *usart = &spiUsart[bus - 1];
+	uint8_t ucsrc = *usart->ucsrc & ~(SPI_USART_UCPHA | SPI_USART_UCPOL);
+
+	if ( mode & SPI_MODE1 ) ucsrc |= SPI_USART_UCPHA;	// CPHA
+	if ( mode & SPI_MODE2 ) ucsrc |= SPI_USART_UCPOL;	// CPOL
+
+	if ( *usart->ucsrc != ucsrc )
+		*usart->ucsrc = ucsrc;
+}
+
+static void spiUsartSetBitOrder(const uint8_t bus, uint8_t bitOrder)
+{
+	const SPI_USART *usart = &spiUsart[bus - 1];
+
+	if(bitOrder == SPI_LSBFIRST) {
+		*usart->ucsrc |= SPI_USART_UDORD;
+	} else {
+		*usart->ucsrc &= ~SPI_USART_UDORD;
+	}
+}
+
+static uint8_t spiUsartExchange(const uint8_t bus, const uint8_t *tx, uint8_t *rx, uint16_t length)
+{
+	const SPI_USART *usart = &spiUsart[bus - 1];
+	uint16_t txRemaining = length;
+	uint16_t rxRemaining = length;
+	uint8_t RxByte;
+
+	// If the USART has not been set up by spiBegin(), then return with nothing.
+	if ( !(*usart->ucsrb & _BV(TXEN0)) ) return 0;
+
+	spiStatsAddBytes(bus, length);
+
+	// Each exchange reads every byte it sends, so the receive buffer starts empty.
+	while ( rxRemaining != 0 )
+	{
+		// Keep the transmit buffer full, but no more than two bytes ahead of
+		// the receiver, so the two byte receive buffer can't overrun.
+		if ( txRemaining != 0 && (rxRemaining - txRemaining) < 2 && (*usart->ucsra & _BV(UDRE0)) )
+		{
+			*usart->udr = (tx != NULL) ? *tx++ : 0xFF;
+			--txRemaining;
+		}
+
+		if ( *usart->ucsra & _BV(RXC0) )
+		{
+			RxByte = *usart->udr;
+			if ( rx != NULL ) *rx++ = RxByte;
+			--rxRemaining;
+		}
+	}
+
+	return 1;
+}
+
+static uint8_t spiUsartTransaction(const uint8_t bus, const SPI_SEGMENT *segments, const uint8_t count)
+{
+	uint8_t index;
+	uint8_t result = 1;
+#if (SPI_STATS == 1)
+	uint32_t waitStart = portGET_RUN_TIME_COUNTER_VALUE();
+
+	result = ( xSemaphoreTake( xSPIUsartSemaphore[bus - 1], (SPI_TIMEOUT / portTICK_RATE_MS) ) == pdTRUE );
+	spiStatsWaited(segments->SS_pin, waitStart, result);
+	if ( !result ) return 0;
+#else
+	if ( xSemaphoreTake( xSPIUsartSemaphore[bus - 1], (SPI_TIMEOUT / portTICK_RATE_MS) ) != pdTRUE ) return 0;
+#endif
+
+	for ( index = 0; result && index < count; ++index, ++segments )
+	{
+		if ( spiDeviceBus[segments->SS_pin] != bus )
+		{
+			result = 0;
+			break;
+		}
+
+		spiUsartSetDataMode(bus, segments->mode);
+		spiUsartSetClockDivider(bus, segments->divider);
+
+#if (SPI_STATS == 1)
+		spiStatsBegin(segments->SS_pin);
+#endif
+		spiAssertSS(segments->SS_pin);
+		result = spiUsartExchange(bus, segments->txData, segments->rxData, segments->length);
+		spiReleaseSS(segments->SS_pin);
+#if (SPI_STATS == 1)
+		spiStatsEnd(segments->SS_pin);
+#endif
+	}
+
+	xSemaphoreGive( xSPIUsartSemaphore[bus - 1] );
+	return result;
+}
+
+#endif
+
+#if (SPI_STATS == 1)
+
+/*-----------------------------------------------------------------------*/
+/* Bus statistics                                                        */
+/*-----------------------------------------------------------------------*/
+
+void spiGetStats(SPI_SLAVE_SELECT SS_pin, SPI_STATISTICS *stats, uint8_t reset)
+{
+	portENTER_CRITICAL();
+	{
+		*stats = spiStats[SS_pin];
+
+		if ( reset )
+		{
+			memset( &spiStats[SS_pin], 0, sizeof(SPI_STATISTICS) );
+			spiStats[SS_pin].since = portGET_RUN_TIME_COUNTER_VALUE();
+		}
+	}
+	portEXIT_CRITICAL();
+}
+
+static void spiStatsWaited(SPI_SLAVE_SELECT SS_pin, const uint32_t waitStart, const uint8_t taken)
+{
+	SPI_STATISTICS *stats = &spiStats[SS_pin];
+	uint32_t waited = portGET_RUN_TIME_COUNTER_VALUE() - waitStart;
+
+	// Tasks waiting for the same device may time out together, so these
+	// figures aren't only changed by the task holding the bus.
+	portENTER_CRITICAL();
+	{
+		stats->waitTime += waited;
+		if ( waited > stats->maxWaitTime ) stats->maxWaitTime = waited;
+		if ( !taken ) ++stats->timeouts;
+	}
+	portEXIT_CRITICAL();
+}
+
+static void spiStatsBegin(SPI_SLAVE_SELECT SS_pin)
+{
+	uint8_t bus = spiStatsBus(SS_pin);
+
+	spiStatsBytes[bus] = 0;
+	spiStatsTakenAt[bus] = portGET_RUN_TIME_COUNTER_VALUE();
+}
+
+static void spiStatsEnd(SPI_SLAVE_SELECT SS_pin)
+{
+	uint8_t bus = spiStatsBus(SS_pin);
+	SPI_STATISTICS *stats = &spiStats[SS_pin];
+	uint32_t held = portGET_RUN_TIME_COUNTER_VALUE() - spiStatsTakenAt[bus];
+
+	portENTER_CRITICAL();
+	{
+		++stats->transactions;
+		stats->bytes += spiStatsBytes[bus];
+		stats->holdTime += held;
+		if ( held > stats->maxHoldTime ) stats->maxHoldTime = held;
+	}
+	portEXIT_CRITICAL();
+}
+
+#endif
+
+#if (SPI_ASYNC == 1)
+
+/*-----------------------------------------------------------------------*/
+/* Interrupt driven transfers                                            */
+/*-----------------------------------------------------------------------*/
+
+static uint8_t spiAsyncWorthwhile(const uint16_t length)
+{
+	// log2 of the CPU cycles per SPI clock, for SPR1:SPR0 = 0 to 3.
+	static const uint8_t dividerShift[4] = { 2, 4, 6, 7 };
+	uint8_t byteShift;
+
+	// log2 of the CPU cycles per byte, 8 SPI clocks, halved by SPI2X.
+	byteShift = dividerShift[ SPCR & SPI_CLOCK_MASK ] + 3 - (SPSR & SPI_2XCLOCK_MASK);
+
+	if ( (1U << byteShift) < SPI_ASYNC_MIN_BYTE_CYCLES ) return 0;
+	if ( ((uint32_t)length << byteShift) < SPI_ASYNC_MIN_CYCLES ) return 0;
+	if ( xSPIDoneSemaphore == NULL ) return 0;
+
+	// With interrupts off, inside a critical section, there would be no
+	// interrupt to move the bytes.
+	if ( !(SREG & _BV(SREG_I)) ) return 0;
+
+#if ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 )
+	// A transfer before the scheduler starts can't block, so stays polled.
+	if ( xTaskGetSchedulerState() != taskSCHEDULER_RUNNING ) return 0;
+#endif
+
+	return 1;
+}
+
+uint8_t spiAsyncStart(const SPI_TRANSFER *transfer)
+{
+	uint8_t tmp;
+
+	// Make sure you manually pull slave select low to indicate start of transfer.
+	// That is NOT done by this function.
+
+	if ( !(SPCR & _BV(SPE)) || transfer->length == 0 ) return 0;
+	if ( !(SPCR & _BV(MSTR)) ) SPCR |= _BV(MSTR);
+	if ( !(SPCR & _BV(MSTR)) ) return 0;
+
+	spiAsyncTx = transfer->txData;
+	spiAsyncRx = transfer->rxData;
+	spiAsyncRemaining = transfer->length;
+
+	// Clear any SPIF left by a polled transfer, so the first interrupt is for
+	// the first byte of this one.
+	tmp = SPSR;
+	tmp = SPDR;
+	(void) tmp;
+
+	if ( spiAsyncTx != NULL )
+	{
+		SPDR = *spiAsyncTx;
+		spiAsyncTx = spiAsyncTx + 1;
+	}
+	else
+		SPDR = 0xFF;
+
+	spiAttachInterrupt();
+	return 1;
+}
+
+uint8_t spiAsyncWait(void)
+{
+	if ( xSemaphoreTake( xSPIDoneSemaphore, (SPI_TIMEOUT / portTICK_RATE_MS) ) == pdTRUE )
+		return 1;
+
+	// Timed out, probably because the SPI module left master mode. Give up on
+	// the transfer, and take the semaphore in case it completed just now.
+	spiDetachInterrupt();
+	xSemaphoreTake( xSPIDoneSemaphore, 0 );
+	return 0;
+}
+
+ISR(SPI_STC_vect)
+{
+	// Interrupts don't nest, so copy the transfer state out of the volatiles.
+	const uint8_t *tx = spiAsyncTx;
+	uint8_t *rx = spiAsyncRx;
+	uint16_t remaining = spiAsyncRemaining;
+	uint8_t RxByte;
+	signed portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+	RxByte = SPDR;
+
+	if ( --remaining != 0 )
+	{
+		// Start the next byte first, so the bus is busy while we store this one.
+		if ( tx != NULL )
+			SPDR = *tx++;
+		else
+			SPDR = 0xFF;
+	}
+
+	if ( rx != NULL )
+		*rx++ = RxByte;
+
+	spiAsyncTx = tx;
+	spiAsyncRx = rx;
+	spiAsyncRemaining = remaining;
+
+	if ( remaining == 0 )
+	{
+		spiDetachInterrupt();
+		xSemaphoreGiveFromISR( xSPIDoneSemaphore, &xHigherPriorityTaskWoken );
+	}
+
+	if( xHigherPriorityTaskWoken )
+		taskYIELD ();
+}
+
+#endif
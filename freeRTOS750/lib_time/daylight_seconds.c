@@ -37,9 +37,9 @@
 #include <time.h>
 #include <math.h>
 
-extern long     __latitude;
+extern int32_t  __latitude;
 
-long
+int32_t
 daylight_seconds(const time_t * timer)
 {
     double          l, d;
@@ -50,7 +50,7 @@
 #include <math.h>
 #include "ephemera_common.h"
 
-int
+int16_t
 equation_of_time(const time_t * timer)
 {
     int32_t         s, p;
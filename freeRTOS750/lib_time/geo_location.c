@@ -28,5 +28,7 @@
 
 /* $Id$ */
 
-long            __latitude;
-long            __longitude;
+#include <stdint.h>
+
+int32_t         __latitude;
+int32_t         __longitude;
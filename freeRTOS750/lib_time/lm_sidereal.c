@@ -33,7 +33,7 @@
 */
 #include <time.h>
 
-extern long     __longitude;
+extern int32_t  __longitude;
 
 unsigned long
 lm_sidereal(const time_t * timer)
@@ -35,7 +35,7 @@
 
 #include <time.h>
 
-extern long     __utc_offset;
+extern int32_t  __utc_offset;
 
 extern int      (*__dst_ptr) (const time_t *, int32_t *);
 
@@ -36,7 +36,7 @@
 #include <time.h>
 
 uint8_t
-month_length(int year, uint8_t month)
+month_length(int16_t year, uint8_t month)
 {
     if (month == 2)
         return 28 + is_leap_year(year);
@@ -33,11 +33,13 @@
 	North latitude and East longitude being positive values.
 */
 
-extern long     __latitude;
-extern long     __longitude;
+#include <time.h>
+
+extern int32_t  __latitude;
+extern int32_t  __longitude;
 
 void
-set_position(long lat, long lon)
+set_position(int32_t lat, int32_t lon)
 {
 	__latitude = lat;
 	__longitude = lon;
@@ -34,7 +34,7 @@
 
 #include <time.h>
 
-extern long     __longitude;
+extern int32_t  __longitude;
 
 time_t
 solar_noon(const time_t * timer)
@@ -36,7 +36,7 @@
 #include <stdio.h>
 #include <time.h>
 
-extern long     __utc_offset;
+extern int32_t  __utc_offset;
 
 #ifdef __MEMX
 
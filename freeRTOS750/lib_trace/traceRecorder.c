@@ -0,0 +1,376 @@
+/*
+    FreeRTOS V7.5.0 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+*/
+
+
+/*
+ * Kernel event trace recorder.  See traceRecorder.h and traceHooks.h.
+ */
+
+#include <string.h>
+
+/* Scheduler include files. */
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include <lib_serial.h>
+#include <ff.h>
+
+#if defined(portEXT_RAM)
+#include <ext_ram.h>
+#endif
+
+#include <traceRecorder.h>
+
+#if ( configUSE_TRACE_RECORDER == 1 )
+
+/* The number of tasks whose names are kept, and the characters kept of each. */
+#ifndef configTRACE_MAX_TASKS
+	#define configTRACE_MAX_TASKS		8
+#endif
+
+#ifndef configTRACE_NAME_LEN
+	#define configTRACE_NAME_LEN		8
+#endif
+
+/* The number of events read out of the ring buffer at a time by a flush. */
+#define traceFLUSH_CHUNK				8
+
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+	#define traceTIMESTAMP()			portGET_RUN_TIME_COUNTER_VALUE()
+	#define traceTIMESTAMP_HZ			portRUN_TIME_COUNTER_HZ
+#else
+	#define traceTIMESTAMP()			( ( uint32_t ) xTaskGetTickCountFromISR() )
+	#define traceTIMESTAMP_HZ			configTICK_RATE_HZ
+#endif
+
+#if defined(portEXT_RAM) && ( defined(portEXT_RAMFS) || defined(portEXT_RAM_TASK_BANKS) )
+
+	/* The kernel heap, and so every stack, is in internal SRAM.  So a whole
+	XRAM bank can be switched in while an event is written. */
+	#ifndef configTRACE_XRAM_BANK
+		#if defined(portEXT_RAMFS)
+			#define configTRACE_XRAM_BANK	1		// RAMFS clients on the Port K SS lines use banks 8 to 15.
+		#else
+			#define configTRACE_XRAM_BANK	( RAM_BANKS - 1 )
+		#endif
+	#endif
+
+	#ifndef configTRACE_BUFFER_EVENTS
+		#define configTRACE_BUFFER_EVENTS	4096	// 32kByte, the smaller bank size.
+	#endif
+
+	#if ( ( configTRACE_BUFFER_EVENTS * 8UL ) > ( XRAMEND - XRAMSTART + 1UL ) )
+		#error configTRACE_BUFFER_EVENTS is too large for one XRAM bank
+	#endif
+
+	#define pxTraceBuffer				( ( xTraceEvent * ) XRAMSTART )
+
+	#define traceSELECT_BUFFER()		ucTraceSavedBank = getMemoryBank(); setMemoryBank( configTRACE_XRAM_BANK, false )
+	#define traceRELEASE_BUFFER()		setMemoryBank( ucTraceSavedBank, false )
+	#define traceBUFFER_BANK_VARIABLE	uint8_t ucTraceSavedBank;
+
+#else
+
+	#if defined(portEXT_RAM) && !defined(portEXT_RAM_16_BANK)
+		/* After the kernel heap in XRAM bank 0. */
+		#ifndef configTRACE_BUFFER_EVENTS
+			#define configTRACE_BUFFER_EVENTS	1024
+		#endif
+		static xTraceEvent pxTraceBuffer[ configTRACE_BUFFER_EVENTS ] __attribute__((section(".ext_ram_heap")));
+	#else
+		#ifndef configTRACE_BUFFER_EVENTS
+			#define configTRACE_BUFFER_EVENTS	32
+		#endif
+		static xTraceEvent pxTraceBuffer[ configTRACE_BUFFER_EVENTS ];
+	#endif
+
+	#define traceSELECT_BUFFER()
+	#define traceRELEASE_BUFFER()
+	#define traceBUFFER_BANK_VARIABLE
+
+#endif
+
+/* The ring buffer state.  usTraceHead is the slot the next event goes in, and
+the oldest event is usTraceCount slots before it. */
+static uint16_t usTraceHead = 0;
+static uint16_t usTraceCount = 0;
+static uint32_t ulTraceLost = 0;
+static volatile portBASE_TYPE xTraceRunning = pdTRUE;
+
+/* Task handles and names, written into the header of each flush. */
+typedef struct xTRACE_TASK_NAME
+{
+	uint16_t usTask;
+	char cName[ configTRACE_NAME_LEN ];
+} xTraceTaskName;
+
+static xTraceTaskName xTraceTasks[ configTRACE_MAX_TASKS ];
+
+/* Writes out a flush, returning pdFAIL if the output has failed. */
+typedef portBASE_TYPE ( *pdTRACE_WRITER )( const void *pvData, uint16_t usLength, void *pvContext );
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Copies up to usMaximum events out of the ring buffer, oldest first, and
+ * removes them from it.
+ */
+static uint16_t prvTraceRead( xTraceEvent *pxEvents, uint16_t usMaximum );
+
+/*
+ * Writes a header, the task names, then the events that are in the buffer
+ * when it is called.  Returns the number of events written.
+ */
+static uint16_t prvTraceFlush( pdTRACE_WRITER pxWriter, void *pvContext );
+
+static portBASE_TYPE prvTraceWriteFile( const void *pvData, uint16_t usLength, void *pvContext );
+static portBASE_TYPE prvTraceWriteSerial( const void *pvData, uint16_t usLength, void *pvContext );
+
+/*-----------------------------------------------------------*/
+
+void vTraceRecord( uint8_t ucEvent, uint8_t ucParam, uint16_t usObject )
+{
+	xTraceEvent xEvent;
+	traceBUFFER_BANK_VARIABLE
+
+	if( xTraceRunning == pdFALSE )
+		return;
+
+	xEvent.usObject = usObject;
+	xEvent.ucEvent = ucEvent;
+	xEvent.ucParam = ucParam;
+
+	portENTER_CRITICAL();
+	{
+		xEvent.ulTimeStamp = traceTIMESTAMP();
+
+		traceSELECT_BUFFER();
+		pxTraceBuffer[ usTraceHead ] = xEvent;
+		traceRELEASE_BUFFER();
+
+		if( ++usTraceHead >= configTRACE_BUFFER_EVENTS )
+			usTraceHead = 0;
+
+		// When full, the oldest event has just been overwritten.
+		if( usTraceCount < configTRACE_BUFFER_EVENTS )
+			++usTraceCount;
+		else
+			++ulTraceLost;
+	}
+	portEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vTraceTaskCreate( uint16_t usTask, uint8_t ucPriority, const char *pcName )
+{
+	uint8_t i, ucFree = configTRACE_MAX_TASKS;
+
+	// Reuse the entry of a deleted task that had the same handle, or take a free one.
+	for( i = 0; i < configTRACE_MAX_TASKS; ++i )
+	{
+		if( xTraceTasks[ i ].usTask == usTask )
+		{
+			ucFree = i;
+			break;
+		}
+		if( ( xTraceTasks[ i ].usTask == 0 ) && ( ucFree == configTRACE_MAX_TASKS ) )
+			ucFree = i;
+	}
+
+	if( ucFree < configTRACE_MAX_TASKS )
+	{
+		xTraceTasks[ ucFree ].usTask = usTask;
+		strncpy( xTraceTasks[ ucFree ].cName, pcName, configTRACE_NAME_LEN );
+	}
+
+	vTraceRecord( traceEVENT_TASK_CREATE, ucPriority, usTask );
+}
+/*-----------------------------------------------------------*/
+
+void vTraceStart( void )
+{
+	xTraceRunning = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+void vTraceStop( void )
+{
+	xTraceRunning = pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+void vTraceClear( void )
+{
+	portENTER_CRITICAL();
+	{
+		usTraceCount = 0;
+		ulTraceLost = 0;
+	}
+	portEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+FRESULT xTraceFlushToFile( FIL *pxFile )
+{
+	FRESULT xResult = FR_OK;
+	void *pvContext[ 2 ];
+
+	pvContext[ 0 ] = pxFile;
+	pvContext[ 1 ] = &xResult;
+
+	prvTraceFlush( prvTraceWriteFile, pvContext );
+
+	return xResult;
+}
+/*-----------------------------------------------------------*/
+
+uint16_t usTraceFlushToSerial( xComPortHandlePtr pxPort )
+{
+	return prvTraceFlush( prvTraceWriteSerial, pxPort );
+}
+/*-----------------------------------------------------------*/
+
+static uint16_t prvTraceRead( xTraceEvent *pxEvents, uint16_t usMaximum )
+{
+	uint16_t usRead, usTail;
+	traceBUFFER_BANK_VARIABLE
+
+	portENTER_CRITICAL();
+	{
+		if( usMaximum > usTraceCount )
+			usMaximum = usTraceCount;
+
+		if( usTraceHead >= usTraceCount )
+			usTail = usTraceHead - usTraceCount;
+		else
+			usTail = usTraceHead + configTRACE_BUFFER_EVENTS - usTraceCount;
+
+		traceSELECT_BUFFER();
+		for( usRead = 0; usRead < usMaximum; ++usRead )
+		{
+			pxEvents[ usRead ] = pxTraceBuffer[ usTail ];
+
+			if( ++usTail >= configTRACE_BUFFER_EVENTS )
+				usTail = 0;
+		}
+		traceRELEASE_BUFFER();
+
+		usTraceCount -= usMaximum;
+	}
+	portEXIT_CRITICAL();
+
+	return usMaximum;
+}
+/*-----------------------------------------------------------*/
+
+static uint16_t prvTraceFlush( pdTRACE_WRITER pxWriter, void *pvContext )
+{
+	xTraceHeader xHeader;
+	xTraceEvent xEvents[ traceFLUSH_CHUNK ];
+	xTraceTaskName xTask;
+	uint16_t usWritten, usChunk;
+	uint8_t i;
+
+	memcpy( xHeader.ucMagic, "FRTR", 4 );
+	xHeader.ucVersion = traceFORMAT_VERSION;
+	xHeader.ucNameLength = configTRACE_NAME_LEN;
+	xHeader.ucEventSize = sizeof( xTraceEvent );
+	xHeader.ulTimeStampHz = traceTIMESTAMP_HZ;
+	xHeader.ulTickHz = configTICK_RATE_HZ;
+	xHeader.usBufferEvents = configTRACE_BUFFER_EVENTS;
+
+	xHeader.ucTaskCount = 0;
+	for( i = 0; i < configTRACE_MAX_TASKS; ++i )
+		if( xTraceTasks[ i ].usTask != 0 )
+			++xHeader.ucTaskCount;
+
+	// Only the events here now are flushed. Any recorded while writing wait for the next flush.
+	portENTER_CRITICAL();
+	{
+		xHeader.usEventCount = usTraceCount;
+		xHeader.ulLost = ulTraceLost;
+		ulTraceLost = 0;
+	}
+	portEXIT_CRITICAL();
+
+	if( pxWriter( &xHeader, sizeof( xHeader ), pvContext ) == pdFAIL )
+		return 0;
+
+	for( i = 0; i < configTRACE_MAX_TASKS; ++i )
+	{
+		portENTER_CRITICAL();
+		xTask = xTraceTasks[ i ];
+		portEXIT_CRITICAL();
+
+		if( xTask.usTask != 0 )
+			if( pxWriter( &xTask, sizeof( xTask ), pvContext ) == pdFAIL )
+				return 0;
+	}
+
+	for( usWritten = 0; usWritten < xHeader.usEventCount; usWritten += usChunk )
+	{
+		usChunk = xHeader.usEventCount - usWritten;
+		if( usChunk > traceFLUSH_CHUNK )
+			usChunk = traceFLUSH_CHUNK;
+
+		// The buffer only loses events to a reader, so these are always there.
+		usChunk = prvTraceRead( xEvents, usChunk );
+
+		if( pxWriter( xEvents, usChunk * sizeof( xTraceEvent ), pvContext ) == pdFAIL )
+			break;
+	}
+
+	return usWritten;
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvTraceWriteFile( const void *pvData, uint16_t usLength, void *pvContext )
+{
+	FIL *pxFile = ( ( void ** ) pvContext )[ 0 ];
+	FRESULT *pxResult = ( ( void ** ) pvContext )[ 1 ];
+	uint16_t usWritten;
+
+	*pxResult = f_write( pxFile, pvData, usLength, &usWritten );
+
+	if( ( *pxResult == FR_OK ) && ( usWritten != usLength ) )
+		*pxResult = FR_DENIED;		// the disk is full
+
+	return ( *pxResult == FR_OK ) ? pdPASS : pdFAIL;
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvTraceWriteSerial( const void *pvData, uint16_t usLength, void *pvContext )
+{
+	const uint8_t *pucData = pvData;
+
+	// xSerialPutChar() gives up if the transmit buffer stays full, so keep trying.
+	while( usLength-- )
+	{
+		while( xSerialPutChar( ( xComPortHandlePtr ) pvContext, *pucData ) == pdFAIL )
+			taskYIELD();
+		++pucData;
+	}
+
+	return pdPASS;
+}
+
+#endif /* configUSE_TRACE_RECORDER */
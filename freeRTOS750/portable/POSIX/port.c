@@ -0,0 +1,303 @@
+/*
+    FreeRTOS V7.5.0 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * POSIX (Linux host) simulator port.
+ *
+ * This port lets the kernel and the hardware independent libraries run as an
+ * ordinary Linux process, so scheduler, queue and allocator costs can be
+ * measured and regression tested without an AVR attached.
+ *
+ * Each task is given a ucontext and a native stack allocated from the host
+ * C library.  The stack allocated by the kernel for the task is still
+ * painted with tskSTACK_FILL_BYTE and holds a single pointer to the host
+ * context at its top, so uxTaskGetStackHighWaterMark() keeps working.
+ *
+ * Everything runs on one Linux thread and there are no asynchronous
+ * interrupts, so a run is completely repeatable.  The tick is simulated:
+ * the (weak) idle hook raises one tick each time the idle task runs, and
+ * application code may raise further ticks with vPortSimulateTick().
+ *
+ * The host C library provides time(), so unlike the AVR port the tick does
+ * not call the lib_time system_tick().
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <ucontext.h>
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+
+/*-----------------------------------------------------------*/
+
+/* Size of the native (host) stack given to every task.  The host C library
+and the compiler want far more stack than an AVR, so this is unrelated to
+the stack depth passed to xTaskCreate(). */
+#ifndef portNATIVE_STACK_SIZE
+	#define portNATIVE_STACK_SIZE				( ( size_t ) 64 * 1024 )
+#endif
+
+/* The host side of a task.  A pointer to this structure lives in the top slot
+of the stack allocated by the kernel. */
+typedef struct xHOST_TASK_CONTEXT
+{
+	ucontext_t xContext;							/*< The saved host registers and signal mask. */
+	void *pvNativeStack;							/*< The stack the task really runs on. */
+	pdTASK_CODE pxCode;								/*< The task function, called on first switch in. */
+	void *pvParameters;								/*< The parameter passed to pxCode. */
+	unsigned portBASE_TYPE uxCriticalNesting;		/*< Saved critical nesting, playing the part of SREG. */
+} xHostTaskContext;
+
+/*-----------------------------------------------------------*/
+
+/* We require the address of the pxCurrentTCB variable, but don't want to know
+any details of its type. */
+typedef void tskTCB;
+extern volatile tskTCB * volatile pxCurrentTCB;
+
+/* Simulated interrupt enable flag, see portDISABLE_INTERRUPTS(). */
+volatile unsigned portBASE_TYPE uxPortInterruptsDisabled = 1;
+
+/* Critical nesting of the running task.  Saved into, and restored from, the
+host context on each switch. */
+static volatile unsigned portBASE_TYPE uxCriticalNesting = 0;
+
+/* The context of main(), returned to by vPortEndScheduler(). */
+static ucontext_t xSchedulerContext;
+
+/* pdTRUE between xPortStartScheduler() and vPortEndScheduler(). */
+static volatile portBASE_TYPE xPortSchedulerRunning = pdFALSE;
+
+/* Free running count of simulated ticks. */
+static volatile unsigned long long ullSimulatedTicks = 0;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The host context is referenced from the top of stack slot, which is the
+ * first member of the TCB.
+ */
+#define prvGetHostContext( pxTCB )		( ( xHostTaskContext * ) *( *( portSTACK_TYPE ** ) ( pxTCB ) ) )
+
+/*
+ * Entry point of every task's ucontext.
+ */
+static void prvTaskEntry( void );
+
+/*
+ * Swap from the task that was running to the task now held in pxCurrentTCB.
+ */
+static void prvSwitchFrom( xHostTaskContext *pxOldContext );
+/*-----------------------------------------------------------*/
+
+/*
+ * See header file for description.
+ */
+portSTACK_TYPE *pxPortInitialiseStack( portSTACK_TYPE *pxTopOfStack, pdTASK_CODE pxCode, void *pvParameters )
+{
+xHostTaskContext *pxHostContext;
+
+	pxHostContext = ( xHostTaskContext * ) malloc( sizeof( xHostTaskContext ) );
+	configASSERT( pxHostContext );
+
+	pxHostContext->pvNativeStack = malloc( portNATIVE_STACK_SIZE );
+	configASSERT( pxHostContext->pvNativeStack );
+
+	pxHostContext->pxCode = pxCode;
+	pxHostContext->pvParameters = pvParameters;
+
+	/* Start tasks with interrupts enabled. */
+	pxHostContext->uxCriticalNesting = 0;
+
+	( void ) getcontext( &( pxHostContext->xContext ) );
+	pxHostContext->xContext.uc_stack.ss_sp = pxHostContext->pvNativeStack;
+	pxHostContext->xContext.uc_stack.ss_size = portNATIVE_STACK_SIZE;
+	pxHostContext->xContext.uc_link = NULL;
+	makecontext( &( pxHostContext->xContext ), prvTaskEntry, 0 );
+
+	/* The only thing placed on the kernel stack is the host context. */
+	*pxTopOfStack = ( portSTACK_TYPE ) pxHostContext;
+
+	return pxTopOfStack;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xPortStartScheduler( void )
+{
+	uxCriticalNesting = 0;
+	xPortSchedulerRunning = pdTRUE;
+
+	/* Start the first task.  main() resumes here when vPortEndScheduler() is
+	called. */
+	( void ) swapcontext( &xSchedulerContext, &( prvGetHostContext( pxCurrentTCB )->xContext ) );
+
+	return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEndScheduler( void )
+{
+xHostTaskContext *pxHostContext = prvGetHostContext( pxCurrentTCB );
+
+	/* Unlike the AVR port this is genuinely useful, as it lets a benchmark
+	return to main() to report and exit. */
+	xPortSchedulerRunning = pdFALSE;
+	pxHostContext->uxCriticalNesting = uxCriticalNesting;
+
+	( void ) swapcontext( &( pxHostContext->xContext ), &xSchedulerContext );
+}
+/*-----------------------------------------------------------*/
+
+void vPortCleanUpTCB( void *pxTCB )
+{
+xHostTaskContext *pxHostContext = prvGetHostContext( pxTCB );
+
+	/* Only called by the idle task, never for the task that is running, so
+	the native stack is not in use. */
+	free( pxHostContext->pvNativeStack );
+	free( pxHostContext );
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnterCritical( void )
+{
+	portDISABLE_INTERRUPTS();
+	uxCriticalNesting++;
+}
+/*-----------------------------------------------------------*/
+
+void vPortExitCritical( void )
+{
+	configASSERT( uxCriticalNesting );
+
+	if( --uxCriticalNesting == 0 )
+	{
+		portENABLE_INTERRUPTS();
+	}
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Manual context switch.
+ */
+void vPortYield( void )
+{
+xHostTaskContext *pxOldContext = prvGetHostContext( pxCurrentTCB );
+
+	vTaskSwitchContext();
+	prvSwitchFrom( pxOldContext );
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Context switch used by the simulated tick.  The same as the AVR
+ * vPortYieldFromTick(), but without the need to save registers by hand.
+ */
+void vPortSimulateTick( void )
+{
+xHostTaskContext *pxOldContext;
+
+	/* A tick can not be taken while interrupts are disabled.  On the target
+	it would be latched and taken on exit from the critical section; here it
+	is simply the caller's job to raise it again later. */
+	if( ( xPortSchedulerRunning == pdFALSE ) || ( uxCriticalNesting != 0 ) )
+	{
+		return;
+	}
+
+	ullSimulatedTicks++;
+
+	pxOldContext = prvGetHostContext( pxCurrentTCB );
+
+	#if configUSE_PREEMPTION == 1
+	{
+		if( xTaskIncrementTick() != pdFALSE )
+		{
+			vTaskSwitchContext();
+			prvSwitchFrom( pxOldContext );
+		}
+	}
+	#else
+	{
+		( void ) xTaskIncrementTick();
+		( void ) pxOldContext;
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+unsigned long long ullPortGetSimulatedTicks( void )
+{
+	return ullSimulatedTicks;
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * The idle task drives the simulated tick, so time only moves forward when
+ * every other task is blocked or yields.  An application that needs its own
+ * idle hook must call vPortSimulateTick() from it.
+ */
+void vApplicationIdleHook( void ) __attribute__ ( ( weak ) );
+void vApplicationIdleHook( void )
+{
+	vPortSimulateTick();
+}
+/*-----------------------------------------------------------*/
+
+void vPortAssertFailed( const char *pcFile, unsigned long ulLine )
+{
+	fprintf( stderr, "configASSERT failed: %s:%lu\n", pcFile, ulLine );
+	abort();
+}
+/*-----------------------------------------------------------*/
+
+static void prvSwitchFrom( xHostTaskContext *pxOldContext )
+{
+xHostTaskContext *pxNewContext = prvGetHostContext( pxCurrentTCB );
+
+	if( pxNewContext != pxOldContext )
+	{
+		/* The critical nesting belongs to the task, as SREG does. */
+		pxOldContext->uxCriticalNesting = uxCriticalNesting;
+		( void ) swapcontext( &( pxOldContext->xContext ), &( pxNewContext->xContext ) );
+		uxCriticalNesting = pxOldContext->uxCriticalNesting;
+		uxPortInterruptsDisabled = ( uxCriticalNesting != 0 );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTaskEntry( void )
+{
+xHostTaskContext *pxHostContext = prvGetHostContext( pxCurrentTCB );
+
+	uxCriticalNesting = pxHostContext->uxCriticalNesting;
+	portENABLE_INTERRUPTS();
+
+	pxHostContext->pxCode( pxHostContext->pvParameters );
+
+	/* Tasks must not return.  There is no return address to go to on the AVR
+	either, so treat it as fatal. */
+	abort();
+}
+/*-----------------------------------------------------------*/
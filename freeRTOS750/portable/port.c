@@ -65,6 +65,7 @@
 
 #include <stdlib.h>
 #include <avr/interrupt.h>
+#include <avr/sleep.h>
 
 #include <FreeRTOS.h>
 #include <task.h>
@@ -136,6 +137,54 @@
 
 #endif
 
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+
+#if defined( portUSE_TIMER3_STATS )
+/* Hardware constants for the Timer3 run time stats counter. */
+	#if defined( portUSE_TIMER3 )
+		#error "Timer3 is the tick timer. Choose another portUSE_TIMERx_STATS in freeRTOSBoardDefs.h"
+	#endif
+	#define	TIMER_STATS_OVF_ISR						TIMER3_OVF_vect
+	#define portSTATS_PRESCALE_256					( ( unsigned portCHAR ) (1<<CS32) )
+	#define portSTATS_OVERFLOW_INTERRUPT_ENABLE		( ( unsigned portCHAR ) (1<<TOIE3) )
+	#define portSTATS_OVERFLOW_FLAG					( ( unsigned portCHAR ) (1<<TOV3) )
+	#define portSTATS_TCCRa							TCCR3A
+	#define portSTATS_TCCRb							TCCR3B
+	#define portSTATS_TCNT							TCNT3
+	#define portSTATS_TIMSK							TIMSK3
+	#define portSTATS_TIFR							TIFR3
+
+#elif defined( portUSE_TIMER4_STATS )
+/* Hardware constants for the Timer4 run time stats counter. */
+	#define	TIMER_STATS_OVF_ISR						TIMER4_OVF_vect
+	#define portSTATS_PRESCALE_256					( ( unsigned portCHAR ) (1<<CS42) )
+	#define portSTATS_OVERFLOW_INTERRUPT_ENABLE		( ( unsigned portCHAR ) (1<<TOIE4) )
+	#define portSTATS_OVERFLOW_FLAG					( ( unsigned portCHAR ) (1<<TOV4) )
+	#define portSTATS_TCCRa							TCCR4A
+	#define portSTATS_TCCRb							TCCR4B
+	#define portSTATS_TCNT							TCNT4
+	#define portSTATS_TIMSK							TIMSK4
+	#define portSTATS_TIFR							TIFR4
+
+#elif defined( portUSE_TIMER5_STATS )
+/* Hardware constants for the Timer5 run time stats counter. */
+	#define	TIMER_STATS_OVF_ISR						TIMER5_OVF_vect
+	#define portSTATS_PRESCALE_256					( ( unsigned portCHAR ) (1<<CS52) )
+	#define portSTATS_OVERFLOW_INTERRUPT_ENABLE		( ( unsigned portCHAR ) (1<<TOIE5) )
+	#define portSTATS_OVERFLOW_FLAG					( ( unsigned portCHAR ) (1<<TOV5) )
+	#define portSTATS_TCCRa							TCCR5A
+	#define portSTATS_TCCRb							TCCR5B
+	#define portSTATS_TCNT							TCNT5
+	#define portSTATS_TIMSK							TIMSK5
+	#define portSTATS_TIFR							TIFR5
+
+#endif
+
+/* High 16 bits of the run time counter, counted by the overflow interrupt. */
+static volatile unsigned portSHORT usRunTimeCounterHigh = 0;
+
+#endif // configGENERATE_RUN_TIME_STATS
+
 /*-----------------------------------------------------------*/
 
 /* We require the address of the pxCurrentTCB variable, but don't want to know
@@ -149,6 +198,45 @@ static portTickType portTickRateHz;
 /* remaining ticks in each second, decremented to enable the system_tick. */
 static portTickType ticksRemainingInSec;
 
+#if ( configUSE_TICKLESS_IDLE == 1 )
+
+#if !defined( portUSE_TIMER2 )
+	#error "Tickless idle is only implemented for the Timer2 (32,768Hz crystal) tick."
+#endif
+
+/* Timer2 clock select giving exactly one count per tick, or 0 if the tick rate
+has no matching Timer2 prescaler.  See prvSetupTimerInterrupt(). */
+static unsigned portCHAR ucTickPrescaleBits = 0;
+
+/* Set while Timer2 is counting out suppressed ticks.  The next tick interrupt
+clears it and puts the compare match back to one tick. */
+static volatile unsigned portCHAR ucTicklessActive = pdFALSE;
+
+#define portTICKLESS_RESTORE_TICK()					\
+	if( ucTicklessActive != pdFALSE )				\
+	{												\
+		portOCRL = 0x00;							\
+		ucTicklessActive = pdFALSE;					\
+	}
+
+#else
+
+#define portTICKLESS_RESTORE_TICK()
+
+#endif // configUSE_TICKLESS_IDLE
+
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+
+/* Lookup tables for the ready priority bitmap macros in portmacro.h. */
+const unsigned portCHAR ucPortPriorityBit[ 8 ] PROGMEM = { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80 };
+
+/* Highest set bit of a nibble. Entry 0 is never used, as the idle priority always has a ready task. */
+const unsigned portCHAR ucPortHighestBit[ 16 ] PROGMEM = { 0, 0, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3 };
+
+#endif // configUSE_PORT_OPTIMISED_TASK_SELECTION
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -561,6 +649,14 @@ void vPortYield( void ) __attribute__ ( ( naked ) );
 void vPortYield( void )
 {
 	portSAVE_CONTEXT();
+
+	#if ( configUSE_CRITICAL_PROFILER == 1 )
+		/* A task that yields inside a critical section is switched out with
+		interrupts off, and the next task restores its own SREG, so the span
+		ends here. */
+		vPortCriticalProfileEnd();
+	#endif
+
 	vTaskSwitchContext();
 	portRESTORE_CONTEXT();
 
@@ -579,6 +675,8 @@ void vPortYieldFromTick( void )
 {
 	portSAVE_CONTEXT();
 
+	portTICKLESS_RESTORE_TICK();
+
 	if (--ticksRemainingInSec == 0)
 	{
 		system_tick();
@@ -714,6 +812,22 @@ static void prvSetupTimerInterrupt( void )
 	/* initialise first second of ticks */
 	ticksRemainingInSec = portTickRateHz;
 
+#if ( configUSE_TICKLESS_IDLE == 1 )
+	/* For tickless idle Timer2 is prescaled to count whole ticks, with a compare
+	match of 0 giving the normal tick.  A suppressed tick period is then just a
+	larger compare match, and every tick stays exactly usCompareMatch crystal
+	cycles long. */
+	switch( usCompareMatch )
+	{
+		case 8:		ucTickPrescaleBits = _BV(CS21);						break;
+		case 32:	ucTickPrescaleBits = _BV(CS21)|_BV(CS20);			break;
+		case 64:	ucTickPrescaleBits = _BV(CS22);						break;
+		case 128:	ucTickPrescaleBits = _BV(CS22)|_BV(CS20);			break;
+		case 256:	ucTickPrescaleBits = _BV(CS22)|_BV(CS21);			break;
+		default:	ucTickPrescaleBits = 0;								break;	// no prescaler, so no tickless idle
+	}
+#endif
+
 	/* Adjust for correct value. */
 	usCompareMatch -= 1;
 
@@ -723,8 +837,19 @@ static void prvSetupTimerInterrupt( void )
                                   	  	  	  	  	  		// with a second external clock (32,768kHz) driving it.
     portTCNT  = 0x00;				  						// zero out the counter
     portTCCRa = _BV(WGM21);									// mode CTC (clear on counter match)
-	portTCCRb = _BV(CS20);									// divide system clock by 1
-	portOCRL  = usCompareMatch;								// set the counter
+
+#if ( configUSE_TICKLESS_IDLE == 1 )
+	if( ucTickPrescaleBits )
+	{
+		portTCCRb = ucTickPrescaleBits;						// divide the crystal clock down to one count per tick
+		portOCRL  = 0x00;									// and match on every count
+	}
+	else
+#endif
+	{
+		portTCCRb = _BV(CS20);								// divide system clock by 1
+		portOCRL  = usCompareMatch;							// set the counter
+	}
 
     while( ASSR & (_BV(TCN2UB)|_BV(OCR2AUB)|_BV(TCR2AUB))); // Wait until Timer2 update complete
 
@@ -735,6 +860,363 @@ static void prvSetupTimerInterrupt( void )
 
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TICKLESS_IDLE == 1 )
+
+/*
+ * Choose the deepest sleep that won't lose anything.  Power-save stops the
+ * I/O clock, so a USART with characters still queued for transmission keeps
+ * the CPU in idle sleep instead.  Note that the receivers can't wake the CPU
+ * from power-save, so applications expecting serial input while idle should
+ * veto the sleep with configPRE_SLEEP_PROCESSING().
+ */
+static unsigned portCHAR prvTicklessSleepMode( void )
+{
+	if( UCSR0B & _BV(UDRIE0) )
+		return SLEEP_MODE_IDLE;
+
+#if defined(UCSR1B)
+	if( UCSR1B & _BV(UDRIE1) )
+		return SLEEP_MODE_IDLE;
+#endif
+
+	return SLEEP_MODE_PWR_SAVE;
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Suppress the tick for up to xExpectedIdleTime ticks, and sleep.  Called by
+ * the idle task with the scheduler suspended.
+ *
+ * Timer2 counts whole ticks, and the tick compare match is normally 0.  Here
+ * the compare match is set to the number of ticks to sleep, so the crystal
+ * keeps the exact time while the CPU sleeps, and the wall clock (system_tick)
+ * and the tick count are brought up to date on waking.
+ */
+void vPortSuppressTicksAndSleep( portTickType xExpectedIdleTime )
+{
+portTickType xSleepTicks, xSteppedTicks, xTicks;
+unsigned portCHAR ucElapsed;
+
+	if( ucTickPrescaleBits == 0 )
+	{
+		/* The tick rate has no matching Timer2 prescaler, see prvSetupTimerInterrupt(). */
+		return;
+	}
+
+	/* The compare match is only 8 bits. */
+	if( xExpectedIdleTime > 256 )
+	{
+		xExpectedIdleTime = 256;
+	}
+
+	portDISABLE_INTERRUPTS();
+
+	/* The tick ISR may have just written OCR2A.  Let it reach Timer2. */
+	while( ASSR & _BV(OCR2AUB) );
+
+	/* Don't sleep if a task has been readied, or a tick is already pending. */
+	if( ( eTaskConfirmSleepModeStatus() == eAbortSleep ) || ( portTIFR & _BV(OCF2A) ) )
+	{
+		portENABLE_INTERRUPTS();
+		return;
+	}
+
+	/* TCNT2 sits at zero between ticks.  From here it counts the ticks passed,
+	and the compare match fires at the end of the last expected idle tick. */
+	ucTicklessActive = pdTRUE;
+	portOCRL = ( unsigned portCHAR ) ( xExpectedIdleTime - 1 );
+	while( ASSR & _BV(OCR2AUB) );
+
+	if( portTIFR & _BV(OCF2A) )
+	{
+		/* A tick came in before the new compare match reached Timer2.  The ISR
+		will count it and put the one tick compare match back. */
+		portENABLE_INTERRUPTS();
+		return;
+	}
+
+	xSleepTicks = xExpectedIdleTime;
+	configPRE_SLEEP_PROCESSING( xSleepTicks );
+
+	if( xSleepTicks > 0 )
+	{
+		set_sleep_mode( prvTicklessSleepMode() );
+		sleep_enable();
+		portENABLE_INTERRUPTS();
+		sleep_cpu();											// sei, then sleep, executes the sleep before any interrupt
+		sleep_disable();
+		portDISABLE_INTERRUPTS();
+	}
+
+	configPOST_SLEEP_PROCESSING( xSleepTicks );
+
+	if( ucTicklessActive == pdFALSE )
+	{
+		/* Woken by Timer2 at the end of the period.  The tick ISR has already
+		counted the last tick, and restored the one tick compare match. */
+		xSteppedTicks = xExpectedIdleTime - 1;
+	}
+	else
+	{
+		/* Woken early.  After power-save TCNT2 must be resynchronised before it
+		is read, which is done by writing a Timer2 register. */
+		portTCCRa = _BV(WGM21);
+		while( ASSR & _BV(TCR2AUB) );
+
+		ucElapsed = portTCNT;
+
+		if( portTIFR & _BV(OCF2A) )
+		{
+			/* The period ran out after the CPU woke, and the compare match has
+			cleared TCNT2, so whatever was read is not the ticks passed.  Count
+			it as the end of the period, and leave the last tick and the one tick
+			compare match to the pending ISR. */
+			xSteppedTicks = xExpectedIdleTime - 1;
+		}
+		else
+		{
+			/* TCNT2 holds the whole ticks passed.  Match at the next tick, and
+			let that ISR restore the one tick compare match.  If a tick passes
+			before the new compare match reaches Timer2, just try again. */
+			portOCRL = ucElapsed;
+			while( ASSR & _BV(OCR2AUB) );
+
+			while( !( portTIFR & _BV(OCF2A) ) && ( portTCNT != ucElapsed ) )
+			{
+				ucElapsed = portTCNT;
+				portOCRL = ucElapsed;
+				while( ASSR & _BV(OCR2AUB) );
+			}
+
+			xSteppedTicks = ucElapsed;
+		}
+	}
+
+	/* Bring the wall clock up to date, as the tick ISR would have. */
+	xTicks = xSteppedTicks;
+	while( xTicks >= ticksRemainingInSec )
+	{
+		xTicks -= ticksRemainingInSec;
+		system_tick();
+		ticksRemainingInSec = portTickRateHz;
+	}
+	ticksRemainingInSec -= xTicks;
+
+	if( xSteppedTicks > 0 )
+	{
+		vTaskStepTick( xSteppedTicks );
+	}
+
+	portENABLE_INTERRUPTS();
+}
+
+#endif // configUSE_TICKLESS_IDLE
+
+/*-----------------------------------------------------------*/
+
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+
+/*
+ * Start the spare 16 bit timer free running, for the run time stats.
+ * Called by vTaskStartScheduler() with interrupts disabled.
+ */
+void vPortConfigureTimerForRunTimeStats( void )
+{
+	usRunTimeCounterHigh = 0;
+
+	portSTATS_TCCRa = 0x00;										// normal mode, count to 0xffff then overflow
+	portSTATS_TCNT  = 0x0000;
+	portSTATS_TIFR  = portSTATS_OVERFLOW_FLAG;					// clear any pending overflow
+	portSTATS_TIMSK |= portSTATS_OVERFLOW_INTERRUPT_ENABLE;		// interrupt on overflow, to count the high word
+	portSTATS_TCCRb = portSTATS_PRESCALE_256;					// divide system clock by 256, and go
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Read the 32 bit run time counter.  Called from vTaskSwitchContext(), so
+ * usually with interrupts already disabled.  An overflow that has happened
+ * but not yet been counted by the ISR is recognised by the flag still being
+ * set with a small count, and is added here.
+ */
+unsigned portLONG ulPortGetRunTimeCounterValue( void )
+{
+unsigned portSHORT usLow, usHigh;
+unsigned portCHAR ucSREG;
+
+	ucSREG = SREG;
+	portDISABLE_INTERRUPTS();
+
+	usLow = portSTATS_TCNT;
+	usHigh = usRunTimeCounterHigh;
+
+	if( ( portSTATS_TIFR & portSTATS_OVERFLOW_FLAG ) && ( usLow < 0x8000 ) )
+	{
+		++usHigh;
+	}
+
+	SREG = ucSREG;
+
+	return ( ( unsigned portLONG ) usHigh << 16 ) | usLow;
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Extend the run time counter to 32 bits.
+ */
+ISR(TIMER_STATS_OVF_ISR)
+{
+	++usRunTimeCounterHigh;
+}
+
+#endif // configGENERATE_RUN_TIME_STATS
+
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CRITICAL_PROFILER == 1 )
+
+static xPortCriticalStats xCriticalStats;
+
+/* The start of the critical section being timed. */
+static unsigned portSHORT usCriticalStart;
+static void *pvCriticalEnter;
+static unsigned portCHAR ucCriticalActive = pdFALSE;
+
+/*
+ * Called by portENTER_CRITICAL() with interrupts just disabled, if they were
+ * enabled before.  The return address is in the function that entered.
+ */
+void vPortCriticalProfileStart( void ) __attribute__ ( ( noinline ) );
+void vPortCriticalProfileStart( void )
+{
+	usCriticalStart = portSTATS_TCNT;
+	pvCriticalEnter = __builtin_return_address( 0 );
+	ucCriticalActive = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Called by portEXIT_CRITICAL() just before interrupts are enabled again, and
+ * by vPortYield().  A task resumed inside a critical section it entered
+ * before yielding has nothing being timed, and is not counted.
+ */
+void vPortCriticalProfileEnd( void ) __attribute__ ( ( noinline ) );
+void vPortCriticalProfileEnd( void )
+{
+unsigned portSHORT usCount;
+
+	if( ucCriticalActive == pdFALSE )
+	{
+		return;
+	}
+
+	/* The 16 bit counter wraps after a second, much longer than any span. */
+	usCount = portSTATS_TCNT - usCriticalStart;
+	ucCriticalActive = pdFALSE;
+
+	xCriticalStats.ulSpans++;
+	xCriticalStats.ulTotalCount += usCount;
+
+	if( usCount > xCriticalStats.usMaxCount )
+	{
+		xCriticalStats.usMaxCount = usCount;
+		xCriticalStats.pvMaxEnter = pvCriticalEnter;
+		xCriticalStats.pvMaxExit = __builtin_return_address( 0 );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetCriticalStats( xPortCriticalStats *pxStats, signed portBASE_TYPE xReset )
+{
+unsigned portCHAR ucSREG;
+
+	/* Not portENTER_CRITICAL(), which would time itself. */
+	ucSREG = SREG;
+	portDISABLE_INTERRUPTS();
+
+	*pxStats = xCriticalStats;
+
+	if( xReset != pdFALSE )
+	{
+		xCriticalStats.usMaxCount = 0;
+		xCriticalStats.pvMaxEnter = NULL;
+		xCriticalStats.pvMaxExit = NULL;
+		xCriticalStats.ulSpans = 0;
+		xCriticalStats.ulTotalCount = 0;
+		xCriticalStats.ulSince = ulPortGetRunTimeCounterValue();
+	}
+
+	SREG = ucSREG;
+}
+
+#endif // configUSE_CRITICAL_PROFILER
+
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STACK_REPORT == 1 )
+
+/* The free internal SRAM above the variables, from the avr-libc linker
+script.  main() runs on the stack at the top of it, as do interrupts taken
+before the scheduler starts.  After that every interrupt runs on the stack of
+the task it interrupts, and this stack is left as it was. */
+extern unsigned portCHAR _end;
+extern unsigned portCHAR __stack;
+extern char *__brkval;
+
+/* The byte tasks.c fills the task stacks with. */
+#define portSTACK_FILL_BYTE		0xa5
+
+/*
+ * Fill the free SRAM with portSTACK_FILL_BYTE at reset, before anything has
+ * been pushed.  This runs from .init1, before the C runtime has cleared r1,
+ * so it is naked and uses only r24, r25 and Z.
+ */
+void vPortPaintSystemStack( void ) __attribute__ ( ( naked, used, section( ".init1" ) ) );
+void vPortPaintSystemStack( void )
+{
+	asm volatile (	"ldi	r30, lo8(_end)			\n\t"
+					"ldi	r31, hi8(_end)			\n\t"
+					"ldi	r24, %0					\n\t"
+					"ldi	r25, hi8(__stack)		\n\t"
+					"rjmp	2f						\n\t"
+				"1:	st		Z+, r24					\n\t"
+				"2:	cpi		r30, lo8(__stack)		\n\t"
+					"cpc	r31, r25				\n\t"
+					"brlo	1b						\n\t"
+					"breq	1b						\n\t"
+					:: "M" ( portSTACK_FILL_BYTE ) );
+}
+/*-----------------------------------------------------------*/
+
+unsigned portSHORT usPortGetSystemStackSize( void )
+{
+	return ( unsigned portSHORT ) ( &__stack - &_end + 1 );
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Count the painted bytes from the bottom of the free SRAM, or from the top
+ * of the avr-libc malloc() heap if it has been used and is in internal SRAM.
+ */
+unsigned portSHORT usPortGetSystemStackHighWaterMark( void )
+{
+const unsigned portCHAR *pucStart = &_end, *pucByte;
+
+	if( ( ( unsigned portCHAR * ) __brkval > &_end ) && ( ( unsigned portCHAR * ) __brkval <= &__stack ) )
+	{
+		pucStart = ( unsigned portCHAR * ) __brkval;
+	}
+
+	for( pucByte = pucStart; ( pucByte <= &__stack ) && ( *pucByte == portSTACK_FILL_BYTE ); ++pucByte )
+	{
+	}
+
+	return ( unsigned portSHORT ) ( pucByte - pucStart );
+}
+
+#endif // configUSE_STACK_REPORT
+
+/*-----------------------------------------------------------*/
+
 #if configUSE_PREEMPTION == 1
 
 	/*
@@ -759,6 +1241,8 @@ static void prvSetupTimerInterrupt( void )
 	#warning "COOPERATIVE scheduler."
 	ISR(TIMER_COMPA_ISR)
 	{
+		portTICKLESS_RESTORE_TICK();
+
 		if (--ticksRemainingInSec == 0)
 		{
 			system_tick();
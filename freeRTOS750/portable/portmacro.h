@@ -105,6 +105,44 @@ extern "C" {
 /*-----------------------------------------------------------*/
 
 /* Critical section management. */
+#if ( configUSE_CRITICAL_PROFILER == 1 )
+
+/* As below, but the outermost critical section (the one entered with
+interrupts enabled) is timed, along with where it was entered and left.  See
+vPortGetCriticalStats(). */
+typedef struct xPORT_CRITICAL_STATS
+{
+	unsigned portSHORT usMaxCount;			/* The longest time interrupts were off, in run time counter counts. */
+	void *pvMaxEnter;						/* Word address just after the portENTER_CRITICAL() of the longest. */
+	void *pvMaxExit;						/* Word address just after the portEXIT_CRITICAL() of the longest, or in vPortYield(). */
+	unsigned portLONG ulSpans;				/* The number of critical sections timed. */
+	unsigned portLONG ulTotalCount;			/* Their total time, in run time counter counts. */
+	unsigned portLONG ulSince;				/* The run time counter when the statistics were last reset. */
+} xPortCriticalStats;
+
+extern void vPortCriticalProfileStart( void );
+extern void vPortCriticalProfileEnd( void );
+extern void vPortGetCriticalStats( xPortCriticalStats *pxStats, signed portBASE_TYPE xReset );
+
+#define portSREG_I					( ( unsigned portCHAR ) 0x80 )
+
+#define portENTER_CRITICAL()		do {																\
+										unsigned portCHAR ucPortSREG;								\
+										asm volatile ( "in		%0, __SREG__" : "=r" ( ucPortSREG ) );	\
+										asm volatile ( "cli" :: );									\
+										asm volatile ( "push	%0" :: "r" ( ucPortSREG ) );			\
+										if( ucPortSREG & portSREG_I ) vPortCriticalProfileStart();	\
+									} while( 0 )
+
+#define portEXIT_CRITICAL()			do {																\
+										unsigned portCHAR ucPortSREG;								\
+										asm volatile ( "pop		%0" : "=r" ( ucPortSREG ) );			\
+										if( ucPortSREG & portSREG_I ) vPortCriticalProfileEnd();		\
+										asm volatile ( "out		__SREG__, %0" :: "r" ( ucPortSREG ) );	\
+									} while( 0 )
+
+#else
+
 #define portENTER_CRITICAL()		asm volatile ( "in		__tmp_reg__, __SREG__" :: );	\
 									asm volatile ( "cli" :: );								\
 									asm volatile ( "push	__tmp_reg__" :: )
@@ -112,6 +150,8 @@ extern "C" {
 #define portEXIT_CRITICAL()			asm volatile ( "pop		__tmp_reg__" :: );				\
 									asm volatile ( "out		__SREG__, __tmp_reg__" :: )
 
+#endif /* configUSE_CRITICAL_PROFILER */
+
 #define portDISABLE_INTERRUPTS()	asm volatile ( "cli" :: );
 #define portENABLE_INTERRUPTS()		asm volatile ( "sei" :: );
 /*-----------------------------------------------------------*/
@@ -128,6 +168,88 @@ extern void vPortYield( void ) __attribute__ ( ( naked ) );
 #define portYIELD()					vPortYield()
 /*-----------------------------------------------------------*/
 
+/* Tickless idle, for the Timer2 (32,768Hz crystal) tick only. */
+#if ( configUSE_TICKLESS_IDLE == 1 )
+	extern void vPortSuppressTicksAndSleep( portTickType xExpectedIdleTime );
+	#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )	vPortSuppressTicksAndSleep( xExpectedIdleTime )
+#endif
+/*-----------------------------------------------------------*/
+
+/* Port optimised task selection.  uxTopReadyPriority is used as a bitmap,
+with one bit set for each priority that has a ready task, so choosing the
+next task takes the same time whatever configMAX_PRIORITIES is.  The bit for
+a priority, and the highest set bit of each nibble, come from small tables in
+flash, to avoid the AVR shift loop. */
+#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+
+	/* The bitmap is one unsigned portBASE_TYPE, which is 8 bits. */
+	#if( configMAX_PRIORITIES > 8 )
+		#error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 8.
+	#endif
+
+	#include <avr/pgmspace.h>
+
+	extern const unsigned portCHAR ucPortPriorityBit[ 8 ] PROGMEM;
+	extern const unsigned portCHAR ucPortHighestBit[ 16 ] PROGMEM;
+
+	/* Store/clear the ready priorities in a bit map. */
+	#define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities )	( uxReadyPriorities ) |= pgm_read_byte( &ucPortPriorityBit[ ( uxPriority ) ] )
+	#define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities )	( uxReadyPriorities ) &= ~pgm_read_byte( &ucPortPriorityBit[ ( uxPriority ) ] )
+
+	/* Highest set bit, looked up in the top nibble if it has any bits set and in the bottom nibble otherwise. */
+	static inline unsigned portBASE_TYPE ucPortGetHighestPriority( unsigned portBASE_TYPE uxReadyPriorities )
+	{
+		if( uxReadyPriorities & 0xf0 )
+		{
+			return ( unsigned portBASE_TYPE ) ( 4 + pgm_read_byte( &ucPortHighestBit[ ( uxReadyPriorities >> 4 ) & 0x0f ] ) );
+		}
+		return ( unsigned portBASE_TYPE ) pgm_read_byte( &ucPortHighestBit[ uxReadyPriorities & 0x0f ] );
+	}
+
+	#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities )	uxTopPriority = ucPortGetHighestPriority( uxReadyPriorities )
+
+#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+/*-----------------------------------------------------------*/
+
+/* Run time stats. A spare 16 bit Timer, chosen in freeRTOSBoardDefs.h, runs
+at configCPU_CLOCK_HZ / 256 and is extended to 32 bits by its overflow
+interrupt.  At 16MHz it counts 16us, and wraps after 19 hours. */
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+	#define portRUN_TIME_COUNTER_PRESCALER			( ( unsigned portLONG ) 256 )
+	#define portRUN_TIME_COUNTER_HZ					( ( unsigned portLONG ) configCPU_CLOCK_HZ / portRUN_TIME_COUNTER_PRESCALER )
+
+	extern void vPortConfigureTimerForRunTimeStats( void );
+	extern unsigned portLONG ulPortGetRunTimeCounterValue( void );
+
+	#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()	vPortConfigureTimerForRunTimeStats()
+	#define portGET_RUN_TIME_COUNTER_VALUE()			ulPortGetRunTimeCounterValue()
+#endif
+/*-----------------------------------------------------------*/
+
+/* Per task XRAM banks.  The kernel calls this between saving the context of
+one task and restoring the next, to select the bank given to the next task by
+vTaskSetMemoryBank(), along with the avr-libc malloc() state of that bank.
+setMemoryBank() in ext_ram.c knows how the banks are wired, and returns at
+once if the bank is already selected. */
+#if ( configUSE_TASK_MEMORY_BANKS == 1 )
+	#include <stdint.h>
+	#include <stdbool.h>
+
+	extern void setMemoryBank( uint8_t bank_, bool switchHeap_ );
+
+	#define portSWITCH_MEMORY_BANK( ucBank )			setMemoryBank( ( ucBank ), true )
+#endif
+/*-----------------------------------------------------------*/
+
+/* Stack report.  The free internal SRAM above the variables is painted at
+reset, so the unused part of the stack main() ran on (along with the interrupts
+taken before the scheduler started) can be measured like a task stack. */
+#if ( configUSE_STACK_REPORT == 1 )
+	extern unsigned portSHORT usPortGetSystemStackSize( void );
+	extern unsigned portSHORT usPortGetSystemStackHighWaterMark( void );
+#endif
+/*-----------------------------------------------------------*/
+
 #if defined(__AVR_ATmega640__) || defined(__AVR_ATmega1280__) || defined(__AVR_ATmega1281__) || defined(__AVR_ATmega2560__) || defined(__AVR_ATmega2561__)
 /* Task function macros as described on the FreeRTOS.org WEB site. */
 // This changed to add .task tag for the linker for ATmega2560 etc. To make sure they are loaded in low memory.
@@ -146,6 +146,15 @@ typedef struct QueueDefinition
 		struct QueueDefinition *pxQueueSetContainer;
 	#endif
 
+	#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+		unsigned char ucReserved;			/*< Set while the slot at pcWriteTo is reserved by pvQueueReserve() and not yet committed. */
+		unsigned char ucHeld;				/*< Set while the item at the head of the queue is held by pvQueuePeekInPlace() and not yet released. */
+	#endif
+
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		unsigned char ucStaticallyAllocated;/*< Set to pdTRUE if the structure and storage area were supplied by xQueueGenericCreateStatic(), so must not be freed. */
+	#endif
+
 } xQUEUE;
 /*-----------------------------------------------------------*/
 
@@ -181,6 +190,13 @@ typedef struct QueueDefinition
  */
 static void prvUnlockQueue( xQUEUE *pxQueue ) PRIVILEGED_FUNCTION;
 
+/*
+ * Sets up a queue whose structure and storage area have been allocated, either
+ * from the heap by xQueueGenericCreate() or by the caller of
+ * xQueueGenericCreateStatic().
+ */
+static void prvInitialiseNewQueue( xQUEUE *pxNewQueue, unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, unsigned char ucQueueType ) PRIVILEGED_FUNCTION;
+
 /*
  * Uses a critical section to determine if there is any data in a queue.
  *
@@ -214,6 +230,21 @@ static void prvCopyDataFromQueue( xQUEUE * const pxQueue, const void * const pvB
 	static portBASE_TYPE prvNotifyQueueSetContainer( const xQUEUE * const pxQueue, portBASE_TYPE xCopyPosition ) PRIVILEGED_FUNCTION;
 #endif
 
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+	/*
+	 * Blocks in the same way as xQueueGenericSend() (xReserving == pdTRUE) or
+	 * xQueueGenericReceive() (xReserving == pdFALSE), until a slot can be
+	 * reserved or there is an item to read in place.  Returns a pointer to the
+	 * slot or item, or NULL if the block time expired.
+	 */
+	static void *prvQueueWaitInPlace( xQUEUE * const pxQueue, portTickType xTicksToWait, portBASE_TYPE xReserving ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Makes the reserved slot the newest item in the queue.
+	 */
+	static void prvQueueCommitReserved( xQUEUE * const pxQueue ) PRIVILEGED_FUNCTION;
+#endif
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -235,6 +266,39 @@ static void prvCopyDataFromQueue( xQUEUE * const pxQueue, const void * const pvB
 	taskEXIT_CRITICAL()
 /*-----------------------------------------------------------*/
 
+/*
+ * Macro to test for space in a queue.  A slot reserved by pvQueueReserve() is
+ * held at pcWriteTo until it is committed, so until then the queue is full to
+ * every other sender.
+ */
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+	#define prvQueueHasSpace( pxQueue )		( ( ( pxQueue )->uxMessagesWaiting < ( pxQueue )->uxLength ) && ( ( pxQueue )->ucReserved == pdFALSE ) )
+#else
+	#define prvQueueHasSpace( pxQueue )		( ( pxQueue )->uxMessagesWaiting < ( pxQueue )->uxLength )
+#endif
+
+/*
+ * Macro to test whether a send must wait for an item held by
+ * pvQueuePeekInPlace(), or a slot reserved by pvQueueReserve().  Sending to
+ * the front of the queue would move pcReadFrom so xQueueRelease() removed the
+ * wrong item.  Overwriting ignores the space test that holds off other senders
+ * while a slot is reserved, and on a queue of one item writes where the held
+ * item or the reserved slot is.  So those wait until the item is released or
+ * the slot is committed.
+ */
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+	#define prvQueueIsInPlace( pxQueue, xCopyPosition )		( ( ( ( pxQueue )->ucHeld != pdFALSE ) || ( ( pxQueue )->ucReserved != pdFALSE ) ) && ( ( xCopyPosition ) != queueSEND_TO_BACK ) )
+#else
+	#define prvQueueIsInPlace( pxQueue, xCopyPosition )		( pdFALSE )
+#endif
+
+/*
+ * Macro giving the position of the item at the head of the queue, which is
+ * the next place a queued item will be read from.
+ */
+#define prvQueueNextReadFrom( pxQueue )		( ( ( ( pxQueue )->u.pcReadFrom + ( pxQueue )->uxItemSize ) >= ( pxQueue )->pcTail ) ? ( pxQueue )->pcHead : ( ( pxQueue )->u.pcReadFrom + ( pxQueue )->uxItemSize ) )
+/*-----------------------------------------------------------*/
+
 portBASE_TYPE xQueueGenericReset( xQueueHandle xQueue, portBASE_TYPE xNewQueue )
 {
 xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
@@ -250,6 +314,13 @@ xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
 		pxQueue->xRxLock = queueUNLOCKED;
 		pxQueue->xTxLock = queueUNLOCKED;
 
+		#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+		{
+			pxQueue->ucReserved = pdFALSE;
+			pxQueue->ucHeld = pdFALSE;
+		}
+		#endif
+
 		if( xNewQueue == pdFALSE )
 		{
 			/* If there are tasks blocked waiting to read from the queue, then
@@ -303,25 +374,13 @@ xQueueHandle xReturn = NULL;
 			pxNewQueue->pcHead = ( signed char * ) pvPortMalloc( xQueueSizeInBytes );
 			if( pxNewQueue->pcHead != NULL )
 			{
-				/* Initialise the queue members as described above where the
-				queue type is defined. */
-				pxNewQueue->uxLength = uxQueueLength;
-				pxNewQueue->uxItemSize = uxItemSize;
-				( void ) xQueueGenericReset( pxNewQueue, pdTRUE );
-
-				#if ( configUSE_TRACE_FACILITY == 1 )
+				#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
 				{
-					pxNewQueue->ucQueueType = ucQueueType;
+					pxNewQueue->ucStaticallyAllocated = pdFALSE;
 				}
-				#endif /* configUSE_TRACE_FACILITY */
-
-				#if( configUSE_QUEUE_SETS == 1 )
-				{
-					pxNewQueue->pxQueueSetContainer = NULL;
-				}
-				#endif /* configUSE_QUEUE_SETS */
+				#endif
 
-				traceQUEUE_CREATE( pxNewQueue );
+				prvInitialiseNewQueue( pxNewQueue, uxQueueLength, uxItemSize, ucQueueType );
 				xReturn = pxNewQueue;
 			}
 			else
@@ -338,6 +397,82 @@ xQueueHandle xReturn = NULL;
 }
 /*-----------------------------------------------------------*/
 
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	xQueueHandle xQueueGenericCreateStatic( unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, unsigned char *pucQueueStorage, xStaticQueue *pxStaticQueue, unsigned char ucQueueType )
+	{
+	xQUEUE *pxNewQueue = ( xQUEUE * ) pxStaticQueue;
+
+		/* xStaticQueue is a public copy of the xQUEUE layout.  If this fails
+		the two have got out of step. */
+		configASSERT( sizeof( xStaticQueue ) == sizeof( xQUEUE ) );
+		configASSERT( uxQueueLength > ( unsigned portBASE_TYPE ) 0 );
+		configASSERT( pxStaticQueue );
+
+		/* There must be a storage area if, and only if, items are copied. */
+		configASSERT( !( ( pucQueueStorage != NULL ) && ( uxItemSize == 0 ) ) );
+		configASSERT( !( ( pucQueueStorage == NULL ) && ( uxItemSize != 0 ) ) );
+
+		if( ( pxNewQueue != NULL ) && ( uxQueueLength > ( unsigned portBASE_TYPE ) 0 ) )
+		{
+			if( uxItemSize == ( unsigned portBASE_TYPE ) 0 )
+			{
+				/* A NULL pcHead marks a mutex, so a semaphore, which has no
+				storage area, points pcHead at the structure itself.  Nothing
+				is ever copied to or from it. */
+				pxNewQueue->pcHead = ( signed char * ) pxNewQueue;
+			}
+			else
+			{
+				/* The byte xQueueGenericCreate() allocates past the end of
+				the storage area is only ever used as an address, so is not
+				needed here. */
+				pxNewQueue->pcHead = ( signed char * ) pucQueueStorage;
+			}
+
+			pxNewQueue->ucStaticallyAllocated = pdTRUE;
+			prvInitialiseNewQueue( pxNewQueue, uxQueueLength, uxItemSize, ucQueueType );
+		}
+		else
+		{
+			traceQUEUE_CREATE_FAILED( ucQueueType );
+			pxNewQueue = NULL;
+		}
+
+		return pxNewQueue;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewQueue( xQUEUE *pxNewQueue, unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, unsigned char ucQueueType )
+{
+	/* Remove compiler warnings about unused parameters should
+	configUSE_TRACE_FACILITY not be set to 1. */
+	( void ) ucQueueType;
+
+	/* Initialise the queue members as described above where the
+	queue type is defined. */
+	pxNewQueue->uxLength = uxQueueLength;
+	pxNewQueue->uxItemSize = uxItemSize;
+	( void ) xQueueGenericReset( pxNewQueue, pdTRUE );
+
+	#if ( configUSE_TRACE_FACILITY == 1 )
+	{
+		pxNewQueue->ucQueueType = ucQueueType;
+	}
+	#endif /* configUSE_TRACE_FACILITY */
+
+	#if( configUSE_QUEUE_SETS == 1 )
+	{
+		pxNewQueue->pxQueueSetContainer = NULL;
+	}
+	#endif /* configUSE_QUEUE_SETS */
+
+	traceQUEUE_CREATE( pxNewQueue );
+}
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_MUTEXES == 1 )
 
 	xQueueHandle xQueueCreateMutex( unsigned char ucQueueType )
@@ -382,6 +517,19 @@ xQueueHandle xReturn = NULL;
 			}
 			#endif
 
+			#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+			{
+				pxNewQueue->ucReserved = pdFALSE;
+				pxNewQueue->ucHeld = pdFALSE;
+			}
+			#endif
+
+			#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				pxNewQueue->ucStaticallyAllocated = pdFALSE;
+			}
+			#endif
+
 			/* Ensure the event queues start with the correct state. */
 			vListInitialise( &( pxNewQueue->xTasksWaitingToSend ) );
 			vListInitialise( &( pxNewQueue->xTasksWaitingToReceive ) );
@@ -571,7 +719,7 @@ xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
 			the highest priority task wanting to access the queue.  If
 			the head item in the queue is to be overwritten then it does
 			not matter if the queue is full. */
-			if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
+			if( ( prvQueueHasSpace( pxQueue ) || ( xCopyPosition == queueOVERWRITE ) ) && ( prvQueueIsInPlace( pxQueue, xCopyPosition ) == pdFALSE ) )
 			{
 				traceQUEUE_SEND( pxQueue );
 				prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition );
@@ -666,7 +814,7 @@ xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
 		/* Update the timeout state to see if it has expired yet. */
 		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
 		{
-			if( prvIsQueueFull( pxQueue ) != pdFALSE )
+			if( ( prvIsQueueFull( pxQueue ) != pdFALSE ) || ( prvQueueIsInPlace( pxQueue, xCopyPosition ) != pdFALSE ) )
 			{
 				traceBLOCKING_ON_QUEUE_SEND( pxQueue );
 				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
@@ -727,7 +875,7 @@ xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
 			{
 				/* Is there room on the queue now?  To be running we must be
 				the highest priority task wanting to access the queue. */
-				if( pxQueue->uxMessagesWaiting < pxQueue->uxLength )
+				if( prvQueueHasSpace( pxQueue ) && ( prvQueueIsInPlace( pxQueue, xCopyPosition ) == pdFALSE ) )
 				{
 					traceQUEUE_SEND( pxQueue );
 					prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition );
@@ -767,7 +915,7 @@ xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
 			{
 				if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
 				{
-					if( prvIsQueueFull( pxQueue ) != pdFALSE )
+					if( ( prvIsQueueFull( pxQueue ) != pdFALSE ) || ( prvQueueIsInPlace( pxQueue, xCopyPosition ) != pdFALSE ) )
 					{
 						traceBLOCKING_ON_QUEUE_SEND( pxQueue );
 						vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
@@ -953,7 +1101,7 @@ xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
 	by this	post). */
 	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
 	{
-		if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
+		if( ( prvQueueHasSpace( pxQueue ) || ( xCopyPosition == queueOVERWRITE ) ) && ( prvQueueIsInPlace( pxQueue, xCopyPosition ) == pdFALSE ) )
 		{
 			traceQUEUE_SEND_FROM_ISR( pxQueue );
 
@@ -1315,6 +1463,371 @@ xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+	void *pvQueueReserve( xQueueHandle xQueue, portTickType xTicksToWait )
+	{
+	xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
+
+		configASSERT( pxQueue );
+		configASSERT( pxQueue->uxItemSize != ( unsigned portBASE_TYPE ) 0U );
+
+		return prvQueueWaitInPlace( pxQueue, xTicksToWait, pdTRUE );
+	}
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+	signed portBASE_TYPE xQueueCommit( xQueueHandle xQueue )
+	{
+	signed portBASE_TYPE xReturn = pdFAIL;
+	xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
+
+		configASSERT( pxQueue );
+
+		taskENTER_CRITICAL();
+		{
+			configASSERT( pxQueue->ucReserved != pdFALSE );
+
+			if( pxQueue->ucReserved != pdFALSE )
+			{
+				traceQUEUE_SEND( pxQueue );
+				prvQueueCommitReserved( pxQueue );
+
+				#if ( configUSE_QUEUE_SETS == 1 )
+				{
+					if( pxQueue->pxQueueSetContainer != NULL )
+					{
+						if( prvNotifyQueueSetContainer( pxQueue, queueSEND_TO_BACK ) == pdTRUE )
+						{
+							portYIELD_WITHIN_API();
+						}
+					}
+					else if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+					{
+						if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) == pdTRUE )
+						{
+							portYIELD_WITHIN_API();
+						}
+					}
+				}
+				#else /* configUSE_QUEUE_SETS */
+				{
+					/* If there was a task waiting for data to arrive on the
+					queue then unblock it now. */
+					if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+					{
+						if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) == pdTRUE )
+						{
+							portYIELD_WITHIN_API();
+						}
+					}
+				}
+				#endif /* configUSE_QUEUE_SETS */
+
+				/* A sender may have blocked only because the slot was reserved,
+				so let one try again if there is still space. */
+				if( ( prvQueueHasSpace( pxQueue ) ) && ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE ) )
+				{
+					if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) == pdTRUE )
+					{
+						portYIELD_WITHIN_API();
+					}
+				}
+
+				xReturn = pdPASS;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+	void *pvQueuePeekInPlace( xQueueHandle xQueue, portTickType xTicksToWait )
+	{
+	xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
+
+		configASSERT( pxQueue );
+		configASSERT( pxQueue->uxItemSize != ( unsigned portBASE_TYPE ) 0U );
+
+		return prvQueueWaitInPlace( pxQueue, xTicksToWait, pdFALSE );
+	}
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+	signed portBASE_TYPE xQueueRelease( xQueueHandle xQueue )
+	{
+	signed portBASE_TYPE xReturn = pdFAIL;
+	xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
+
+		configASSERT( pxQueue );
+
+		taskENTER_CRITICAL();
+		{
+			configASSERT( pxQueue->uxMessagesWaiting > ( unsigned portBASE_TYPE ) 0 );
+
+			if( pxQueue->uxMessagesWaiting > ( unsigned portBASE_TYPE ) 0 )
+			{
+				traceQUEUE_RECEIVE( pxQueue );
+
+				/* The item was read in place, so all that is left is to
+				remove it. */
+				pxQueue->u.pcReadFrom = prvQueueNextReadFrom( pxQueue );
+				--( pxQueue->uxMessagesWaiting );
+				pxQueue->ucHeld = pdFALSE;
+
+				if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+				{
+					if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) == pdTRUE )
+					{
+						portYIELD_WITHIN_API();
+					}
+				}
+
+				xReturn = pdPASS;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+	void *pvQueueReserveFromISR( xQueueHandle xQueue )
+	{
+	void *pvReturn = NULL;
+	unsigned portBASE_TYPE uxSavedInterruptStatus;
+	xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
+
+		configASSERT( pxQueue );
+		configASSERT( pxQueue->uxItemSize != ( unsigned portBASE_TYPE ) 0U );
+
+		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			if( prvQueueHasSpace( pxQueue ) )
+			{
+				pxQueue->ucReserved = pdTRUE;
+				pvReturn = ( void * ) pxQueue->pcWriteTo;
+			}
+			else
+			{
+				traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		return pvReturn;
+	}
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+	signed portBASE_TYPE xQueueCommitFromISR( xQueueHandle xQueue, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+	{
+	signed portBASE_TYPE xReturn = pdFAIL;
+	unsigned portBASE_TYPE uxSavedInterruptStatus;
+	xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
+
+		configASSERT( pxQueue );
+
+		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			configASSERT( pxQueue->ucReserved != pdFALSE );
+
+			if( pxQueue->ucReserved != pdFALSE )
+			{
+				traceQUEUE_SEND_FROM_ISR( pxQueue );
+				prvQueueCommitReserved( pxQueue );
+
+				/* As xQueueGenericSendFromISR(), if the queue is locked the
+				event lists are left for the task that unlocks it. */
+				if( pxQueue->xTxLock == queueUNLOCKED )
+				{
+					#if ( configUSE_QUEUE_SETS == 1 )
+					{
+						if( pxQueue->pxQueueSetContainer != NULL )
+						{
+							if( prvNotifyQueueSetContainer( pxQueue, queueSEND_TO_BACK ) == pdTRUE )
+							{
+								if( pxHigherPriorityTaskWoken != NULL )
+								{
+									*pxHigherPriorityTaskWoken = pdTRUE;
+								}
+							}
+						}
+						else if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+						{
+							if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+							{
+								if( pxHigherPriorityTaskWoken != NULL )
+								{
+									*pxHigherPriorityTaskWoken = pdTRUE;
+								}
+							}
+						}
+					}
+					#else /* configUSE_QUEUE_SETS */
+					{
+						if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+						{
+							if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+							{
+								if( pxHigherPriorityTaskWoken != NULL )
+								{
+									*pxHigherPriorityTaskWoken = pdTRUE;
+								}
+							}
+						}
+					}
+					#endif /* configUSE_QUEUE_SETS */
+				}
+				else
+				{
+					++( pxQueue->xTxLock );
+				}
+
+				/* Let a sender held off by the reservation try again. */
+				if( prvQueueHasSpace( pxQueue ) )
+				{
+					if( pxQueue->xRxLock == queueUNLOCKED )
+					{
+						if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+						{
+							if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+							{
+								if( pxHigherPriorityTaskWoken != NULL )
+								{
+									*pxHigherPriorityTaskWoken = pdTRUE;
+								}
+							}
+						}
+					}
+					else
+					{
+						++( pxQueue->xRxLock );
+					}
+				}
+
+				xReturn = pdPASS;
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		return xReturn;
+	}
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+	void *pvQueuePeekInPlaceFromISR( xQueueHandle xQueue )
+	{
+	void *pvReturn = NULL;
+	unsigned portBASE_TYPE uxSavedInterruptStatus;
+	xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
+
+		configASSERT( pxQueue );
+		configASSERT( pxQueue->uxItemSize != ( unsigned portBASE_TYPE ) 0U );
+
+		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			if( pxQueue->uxMessagesWaiting > ( unsigned portBASE_TYPE ) 0 )
+			{
+				traceQUEUE_PEEK_FROM_ISR( pxQueue );
+				pxQueue->ucHeld = pdTRUE;
+				pvReturn = ( void * ) prvQueueNextReadFrom( pxQueue );
+			}
+			else
+			{
+				traceQUEUE_PEEK_FROM_ISR_FAILED( pxQueue );
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		return pvReturn;
+	}
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+	signed portBASE_TYPE xQueueReleaseFromISR( xQueueHandle xQueue, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+	{
+	signed portBASE_TYPE xReturn = pdFAIL;
+	unsigned portBASE_TYPE uxSavedInterruptStatus;
+	xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
+
+		configASSERT( pxQueue );
+
+		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			configASSERT( pxQueue->uxMessagesWaiting > ( unsigned portBASE_TYPE ) 0 );
+
+			if( pxQueue->uxMessagesWaiting > ( unsigned portBASE_TYPE ) 0 )
+			{
+				traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+
+				pxQueue->u.pcReadFrom = prvQueueNextReadFrom( pxQueue );
+				--( pxQueue->uxMessagesWaiting );
+				pxQueue->ucHeld = pdFALSE;
+
+				/* As xQueueReceiveFromISR(), if the queue is locked the event
+				list is left for the task that unlocks it. */
+				if( pxQueue->xRxLock == queueUNLOCKED )
+				{
+					if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+					{
+						if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+						{
+							if( pxHigherPriorityTaskWoken != NULL )
+							{
+								*pxHigherPriorityTaskWoken = pdTRUE;
+							}
+						}
+					}
+				}
+				else
+				{
+					++( pxQueue->xRxLock );
+				}
+
+				xReturn = pdPASS;
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		return xReturn;
+	}
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
 unsigned portBASE_TYPE uxQueueMessagesWaiting( const xQueueHandle xQueue )
 {
 unsigned portBASE_TYPE uxReturn;
@@ -1353,6 +1866,17 @@ xQUEUE * const pxQueue = ( xQUEUE * ) xQueue;
 		vQueueUnregisterQueue( pxQueue );
 	}
 	#endif
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	{
+		/* The caller owns the memory of a queue created with
+		xQueueGenericCreateStatic(). */
+		if( pxQueue->ucStaticallyAllocated != pdFALSE )
+		{
+			return;
+		}
+	}
+	#endif
+
 	vPortFree( pxQueue->pcHead );
 	vPortFree( pxQueue );
 }
@@ -1452,6 +1976,127 @@ static void prvCopyDataFromQueue( xQUEUE * const pxQueue, const void * const pvB
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+	static void prvQueueCommitReserved( xQUEUE * const pxQueue )
+	{
+		/* The item is already in place at pcWriteTo, so this is
+		prvCopyDataToQueue() without the memcpy(). */
+		pxQueue->ucReserved = pdFALSE;
+
+		pxQueue->pcWriteTo += pxQueue->uxItemSize;
+		if( pxQueue->pcWriteTo >= pxQueue->pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+		{
+			pxQueue->pcWriteTo = pxQueue->pcHead;
+		}
+
+		++( pxQueue->uxMessagesWaiting );
+	}
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+	static void *prvQueueWaitInPlace( xQUEUE * const pxQueue, portTickType xTicksToWait, portBASE_TYPE xReserving )
+	{
+	signed portBASE_TYPE xEntryTimeSet = pdFALSE;
+	xTimeOutType xTimeOut;
+	void *pvReturn;
+
+		for( ;; )
+		{
+			taskENTER_CRITICAL();
+			{
+				pvReturn = NULL;
+
+				if( xReserving != pdFALSE )
+				{
+					/* Hold the slot at pcWriteTo until it is committed. */
+					if( prvQueueHasSpace( pxQueue ) )
+					{
+						pxQueue->ucReserved = pdTRUE;
+						pvReturn = ( void * ) pxQueue->pcWriteTo;
+					}
+				}
+				else if( pxQueue->uxMessagesWaiting > ( unsigned portBASE_TYPE ) 0 )
+				{
+					/* The item stays counted in the queue, so it cannot be
+					overwritten, until it is released. */
+					traceQUEUE_PEEK( pxQueue );
+					pxQueue->ucHeld = pdTRUE;
+					pvReturn = ( void * ) prvQueueNextReadFrom( pxQueue );
+				}
+
+				if( pvReturn != NULL )
+				{
+					taskEXIT_CRITICAL();
+					return pvReturn;
+				}
+				else if( xTicksToWait == ( portTickType ) 0 )
+				{
+					taskEXIT_CRITICAL();
+					return NULL;
+				}
+				else if( xEntryTimeSet == pdFALSE )
+				{
+					vTaskSetTimeOutState( &xTimeOut );
+					xEntryTimeSet = pdTRUE;
+				}
+				else
+				{
+					/* Entry time was already set. */
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			/* From here this is the blocking half of xQueueGenericSend() or
+			xQueueGenericReceive(). */
+			vTaskSuspendAll();
+			prvLockQueue( pxQueue );
+
+			if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+			{
+				if( ( xReserving != pdFALSE ) && ( prvIsQueueFull( pxQueue ) != pdFALSE ) )
+				{
+					traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+					vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+					prvUnlockQueue( pxQueue );
+					if( xTaskResumeAll() == pdFALSE )
+					{
+						portYIELD_WITHIN_API();
+					}
+				}
+				else if( ( xReserving == pdFALSE ) && ( prvIsQueueEmpty( pxQueue ) != pdFALSE ) )
+				{
+					traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+					vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+					prvUnlockQueue( pxQueue );
+					if( xTaskResumeAll() == pdFALSE )
+					{
+						portYIELD_WITHIN_API();
+					}
+				}
+				else
+				{
+					/* Try again. */
+					prvUnlockQueue( pxQueue );
+					( void ) xTaskResumeAll();
+				}
+			}
+			else
+			{
+				/* The timeout has expired. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+				return NULL;
+			}
+		}
+	}
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
 static void prvUnlockQueue( xQUEUE *pxQueue )
 {
 	/* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED. */
@@ -1596,7 +2241,7 @@ signed portBASE_TYPE xReturn;
 
 	taskENTER_CRITICAL();
 	{
-		if( pxQueue->uxMessagesWaiting == pxQueue->uxLength )
+		if( prvQueueHasSpace( pxQueue ) == pdFALSE )
 		{
 			xReturn = pdTRUE;
 		}
@@ -1616,7 +2261,7 @@ signed portBASE_TYPE xQueueIsQueueFullFromISR( const xQueueHandle xQueue )
 signed portBASE_TYPE xReturn;
 
 	configASSERT( xQueue );
-	if( ( ( xQUEUE * ) xQueue )->uxMessagesWaiting == ( ( xQUEUE * ) xQueue )->uxLength )
+	if( prvQueueHasSpace( ( xQUEUE * ) xQueue ) == pdFALSE )
 	{
 		xReturn = pdTRUE;
 	}
@@ -0,0 +1,611 @@
+/*
+    FreeRTOS V7.5.0 - Copyright (C) 2013 Real Time Engineers Ltd.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "stream_buffer.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* Values for the ucWaiting structure member. */
+#define sbWAITING_NONE					( ( unsigned char ) 0 )
+#define sbWAITING_RECEIVER				( ( unsigned char ) 1 )
+#define sbWAITING_SENDER				( ( unsigned char ) 2 )
+
+/* Each message in a message buffer is stored after its length. */
+#define sbMESSAGE_LENGTH_BYTES			( sizeof( size_t ) )
+
+/* A task loads or stores an index that an interrupt may be using in a critical
+section, as a 16 bit access can be split by an interrupt.  AVR interrupts do
+not nest, so an ISR accesses the indices directly. */
+#define sbTASK_LOAD_INDEX( xValue, xIndex )		{ taskENTER_CRITICAL(); ( xValue ) = ( xIndex ); taskEXIT_CRITICAL(); }
+#define sbTASK_STORE_INDEX( xIndex, xValue )	{ taskENTER_CRITICAL(); ( xIndex ) = ( xValue ); taskEXIT_CRITICAL(); }
+
+/*
+ * Definition of a stream buffer.  The storage area follows the structure, in
+ * the same allocation.
+ */
+typedef struct StreamBufferDefinition
+{
+	volatile size_t xHead;					/*< Index of the next byte to write.  Only changed by the sender. */
+	volatile size_t xTail;					/*< Index of the next byte to read.  Only changed by the receiver. */
+	size_t xLength;							/*< Size of the storage area.  One byte is always left free, so the buffer holds xLength - 1 bytes. */
+	size_t xTriggerLevelBytes;				/*< Bytes that must be in the buffer before a blocked receiver is unblocked. */
+	xSemaphoreHandle xWaitSemaphore;		/*< Given to unblock the waiting task. */
+	volatile unsigned char ucWaiting;		/*< Which end, if either, is blocked on xWaitSemaphore. */
+	unsigned char ucIsMessageBuffer;		/*< pdTRUE if the buffer carries messages, not a stream of bytes. */
+	unsigned char *pucBuffer;				/*< Points to the storage area. */
+} xSTREAM_BUFFER;
+
+/*
+ * Only one end can ever be blocked at a time.  A receiver only blocks when the
+ * buffer is (nearly) empty, and a sender only blocks when it is (nearly) full,
+ * so one semaphore and the ucWaiting flag serve both ends.
+ */
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The number of bytes in the buffer for the given head and tail indices.
+ */
+static size_t prvBytesInBuffer( const xSTREAM_BUFFER * const pxStreamBuffer, size_t xHead, size_t xTail ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copy bytes into and out of the storage area, wrapping at the end.  Return
+ * the index after the last byte copied.
+ */
+static size_t prvCopyToBuffer( xSTREAM_BUFFER * const pxStreamBuffer, size_t xHead, const unsigned char *pucData, size_t xCount ) PRIVILEGED_FUNCTION;
+static size_t prvCopyFromBuffer( const xSTREAM_BUFFER * const pxStreamBuffer, size_t xTail, unsigned char *pucData, size_t xCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Write as much of the data as the send rules allow, given a snapshot of the
+ * receiver's tail index.  *pxHead is moved on past the bytes written, but the
+ * head in the structure is left for the caller to publish.  Returns the number
+ * of data bytes written.
+ */
+static size_t prvWriteToBuffer( xSTREAM_BUFFER * const pxStreamBuffer, const unsigned char *pucTxData, size_t xDataLengthBytes, size_t *pxHead, size_t xTail ) PRIVILEGED_FUNCTION;
+
+/*
+ * The read equivalent of prvWriteToBuffer().
+ */
+static size_t prvReadFromBuffer( xSTREAM_BUFFER * const pxStreamBuffer, unsigned char *pucRxData, size_t xBufferLengthBytes, size_t xHead, size_t *pxTail ) PRIVILEGED_FUNCTION;
+
+/*
+ * Block the calling task until the other end has made xNeeded bytes (receiver)
+ * or xNeeded spaces (sender) available, or the block time expires.  Returns
+ * pdFALSE if the block time has expired.
+ */
+static portBASE_TYPE prvWaitForOtherEnd( xSTREAM_BUFFER * const pxStreamBuffer, unsigned char ucWaiting, size_t xNeeded, xTimeOutType * const pxTimeOut, portTickType * const pxTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE, and clears the flag, if ucWaiting is the end that is
+ * blocked.  The caller then gives the semaphore.
+ */
+static portBASE_TYPE prvIsWaiting( xSTREAM_BUFFER * const pxStreamBuffer, unsigned char ucWaiting ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+xStreamBufferHandle xStreamBufferGenericCreate( size_t xBufferSizeBytes, size_t xTriggerLevelBytes, portBASE_TYPE xIsMessageBuffer )
+{
+xSTREAM_BUFFER *pxStreamBuffer;
+
+	configASSERT( xBufferSizeBytes > ( size_t ) 1 );
+	configASSERT( !( ( xIsMessageBuffer != pdFALSE ) && ( xBufferSizeBytes <= ( sbMESSAGE_LENGTH_BYTES + ( size_t ) 1 ) ) ) );
+
+	if( xTriggerLevelBytes == ( size_t ) 0 )
+	{
+		xTriggerLevelBytes = ( size_t ) 1;
+	}
+
+	if( xTriggerLevelBytes >= xBufferSizeBytes )
+	{
+		xTriggerLevelBytes = xBufferSizeBytes - ( size_t ) 1;
+	}
+
+	pxStreamBuffer = ( xSTREAM_BUFFER * ) pvPortMalloc( sizeof( xSTREAM_BUFFER ) + xBufferSizeBytes );
+
+	if( pxStreamBuffer != NULL )
+	{
+		vSemaphoreCreateBinary( pxStreamBuffer->xWaitSemaphore );
+
+		if( pxStreamBuffer->xWaitSemaphore != NULL )
+		{
+			/* A binary semaphore is created available, but nothing is ready to
+			be waited for yet. */
+			( void ) xSemaphoreTake( pxStreamBuffer->xWaitSemaphore, ( portTickType ) 0 );
+
+			pxStreamBuffer->xHead = ( size_t ) 0;
+			pxStreamBuffer->xTail = ( size_t ) 0;
+			pxStreamBuffer->xLength = xBufferSizeBytes;
+			pxStreamBuffer->xTriggerLevelBytes = xTriggerLevelBytes;
+			pxStreamBuffer->ucWaiting = sbWAITING_NONE;
+			pxStreamBuffer->ucIsMessageBuffer = ( unsigned char ) ( ( xIsMessageBuffer != pdFALSE ) ? pdTRUE : pdFALSE );
+			pxStreamBuffer->pucBuffer = ( unsigned char * ) ( pxStreamBuffer + 1 );
+		}
+		else
+		{
+			vPortFree( pxStreamBuffer );
+			pxStreamBuffer = NULL;
+		}
+	}
+
+	configASSERT( pxStreamBuffer );
+
+	return ( xStreamBufferHandle ) pxStreamBuffer;
+}
+/*-----------------------------------------------------------*/
+
+void vStreamBufferDelete( xStreamBufferHandle xStreamBuffer )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+
+	configASSERT( pxStreamBuffer );
+
+	vSemaphoreDelete( pxStreamBuffer->xWaitSemaphore );
+	vPortFree( pxStreamBuffer );
+}
+/*-----------------------------------------------------------*/
+
+void vStreamBufferReset( xStreamBufferHandle xStreamBuffer )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+
+	configASSERT( pxStreamBuffer );
+
+	taskENTER_CRITICAL();
+	{
+		pxStreamBuffer->xHead = ( size_t ) 0;
+		pxStreamBuffer->xTail = ( size_t ) 0;
+		pxStreamBuffer->ucWaiting = sbWAITING_NONE;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xStreamBufferSetTriggerLevel( xStreamBufferHandle xStreamBuffer, size_t xTriggerLevelBytes )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+portBASE_TYPE xReturn;
+
+	configASSERT( pxStreamBuffer );
+
+	if( xTriggerLevelBytes == ( size_t ) 0 )
+	{
+		xTriggerLevelBytes = ( size_t ) 1;
+	}
+
+	if( xTriggerLevelBytes < pxStreamBuffer->xLength )
+	{
+		pxStreamBuffer->xTriggerLevelBytes = xTriggerLevelBytes;
+		xReturn = pdPASS;
+	}
+	else
+	{
+		xReturn = pdFAIL;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferBytesAvailable( xStreamBufferHandle xStreamBuffer )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+size_t xHead, xTail;
+
+	configASSERT( pxStreamBuffer );
+
+	taskENTER_CRITICAL();
+	{
+		xHead = pxStreamBuffer->xHead;
+		xTail = pxStreamBuffer->xTail;
+	}
+	taskEXIT_CRITICAL();
+
+	return prvBytesInBuffer( pxStreamBuffer, xHead, xTail );
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSpacesAvailable( xStreamBufferHandle xStreamBuffer )
+{
+	return ( ( ( xSTREAM_BUFFER * ) xStreamBuffer )->xLength - ( size_t ) 1 ) - xStreamBufferBytesAvailable( xStreamBuffer );
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSend( xStreamBufferHandle xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, portTickType xTicksToWait )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+const unsigned char *pucTxData = ( const unsigned char * ) pvTxData;
+size_t xSent = ( size_t ) 0, xWritten, xNeeded, xHead, xTail;
+xTimeOutType xTimeOut;
+
+	configASSERT( pxStreamBuffer );
+	configASSERT( !( ( pvTxData == NULL ) && ( xDataLengthBytes != ( size_t ) 0 ) ) );
+
+	if( pxStreamBuffer->ucIsMessageBuffer != pdFALSE )
+	{
+		/* A message that can never fit would block forever. */
+		xNeeded = xDataLengthBytes + sbMESSAGE_LENGTH_BYTES;
+		configASSERT( xNeeded < pxStreamBuffer->xLength );
+	}
+	else
+	{
+		xNeeded = ( size_t ) 1;
+	}
+
+	vTaskSetTimeOutState( &xTimeOut );
+
+	while( xSent < xDataLengthBytes )
+	{
+		sbTASK_LOAD_INDEX( xTail, pxStreamBuffer->xTail );
+		xHead = pxStreamBuffer->xHead;
+
+		xWritten = prvWriteToBuffer( pxStreamBuffer, &( pucTxData[ xSent ] ), xDataLengthBytes - xSent, &xHead, xTail );
+
+		if( xWritten != ( size_t ) 0 )
+		{
+			sbTASK_STORE_INDEX( pxStreamBuffer->xHead, xHead );
+			xSent += xWritten;
+
+			if( prvBytesInBuffer( pxStreamBuffer, xHead, xTail ) >= pxStreamBuffer->xTriggerLevelBytes )
+			{
+				if( prvIsWaiting( pxStreamBuffer, sbWAITING_RECEIVER ) != pdFALSE )
+				{
+					( void ) xSemaphoreGive( pxStreamBuffer->xWaitSemaphore );
+				}
+			}
+		}
+		else if( xTicksToWait == ( portTickType ) 0 )
+		{
+			break;
+		}
+		else if( prvWaitForOtherEnd( pxStreamBuffer, sbWAITING_SENDER, xNeeded, &xTimeOut, &xTicksToWait ) == pdFALSE )
+		{
+			break;
+		}
+		else
+		{
+			/* Try again. */
+		}
+	}
+
+	return xSent;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSendFromISR( xStreamBufferHandle xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+size_t xWritten, xHead, xTail;
+
+	configASSERT( pxStreamBuffer );
+	configASSERT( !( ( pvTxData == NULL ) && ( xDataLengthBytes != ( size_t ) 0 ) ) );
+
+	xTail = pxStreamBuffer->xTail;
+	xHead = pxStreamBuffer->xHead;
+
+	xWritten = prvWriteToBuffer( pxStreamBuffer, ( const unsigned char * ) pvTxData, xDataLengthBytes, &xHead, xTail );
+
+	if( xWritten != ( size_t ) 0 )
+	{
+		pxStreamBuffer->xHead = xHead;
+
+		if( prvBytesInBuffer( pxStreamBuffer, xHead, xTail ) >= pxStreamBuffer->xTriggerLevelBytes )
+		{
+			if( prvIsWaiting( pxStreamBuffer, sbWAITING_RECEIVER ) != pdFALSE )
+			{
+				( void ) xSemaphoreGiveFromISR( pxStreamBuffer->xWaitSemaphore, pxHigherPriorityTaskWoken );
+			}
+		}
+	}
+
+	return xWritten;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReceive( xStreamBufferHandle xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, portTickType xTicksToWait )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+size_t xReceived = ( size_t ) 0, xHead, xTail;
+xTimeOutType xTimeOut;
+
+	configASSERT( pxStreamBuffer );
+	configASSERT( !( ( pvRxData == NULL ) && ( xBufferLengthBytes != ( size_t ) 0 ) ) );
+
+	vTaskSetTimeOutState( &xTimeOut );
+
+	for( ;; )
+	{
+		sbTASK_LOAD_INDEX( xHead, pxStreamBuffer->xHead );
+		xTail = pxStreamBuffer->xTail;
+
+		if( prvBytesInBuffer( pxStreamBuffer, xHead, xTail ) != ( size_t ) 0 )
+		{
+			/* A message too big for pvRxData is left in the buffer, and 0
+			returned. */
+			xReceived = prvReadFromBuffer( pxStreamBuffer, ( unsigned char * ) pvRxData, xBufferLengthBytes, xHead, &xTail );
+
+			if( xReceived != ( size_t ) 0 )
+			{
+				sbTASK_STORE_INDEX( pxStreamBuffer->xTail, xTail );
+
+				if( prvIsWaiting( pxStreamBuffer, sbWAITING_SENDER ) != pdFALSE )
+				{
+					( void ) xSemaphoreGive( pxStreamBuffer->xWaitSemaphore );
+				}
+			}
+			break;
+		}
+		else if( xTicksToWait == ( portTickType ) 0 )
+		{
+			break;
+		}
+		else if( prvWaitForOtherEnd( pxStreamBuffer, sbWAITING_RECEIVER, pxStreamBuffer->xTriggerLevelBytes, &xTimeOut, &xTicksToWait ) == pdFALSE )
+		{
+			break;
+		}
+		else
+		{
+			/* Try again. */
+		}
+	}
+
+	return xReceived;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReceiveFromISR( xStreamBufferHandle xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+size_t xReceived, xHead, xTail;
+
+	configASSERT( pxStreamBuffer );
+	configASSERT( !( ( pvRxData == NULL ) && ( xBufferLengthBytes != ( size_t ) 0 ) ) );
+
+	xHead = pxStreamBuffer->xHead;
+	xTail = pxStreamBuffer->xTail;
+
+	xReceived = prvReadFromBuffer( pxStreamBuffer, ( unsigned char * ) pvRxData, xBufferLengthBytes, xHead, &xTail );
+
+	if( xReceived != ( size_t ) 0 )
+	{
+		pxStreamBuffer->xTail = xTail;
+
+		if( prvIsWaiting( pxStreamBuffer, sbWAITING_SENDER ) != pdFALSE )
+		{
+			( void ) xSemaphoreGiveFromISR( pxStreamBuffer->xWaitSemaphore, pxHigherPriorityTaskWoken );
+		}
+	}
+
+	return xReceived;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvBytesInBuffer( const xSTREAM_BUFFER * const pxStreamBuffer, size_t xHead, size_t xTail )
+{
+size_t xCount;
+
+	if( xHead >= xTail )
+	{
+		xCount = xHead - xTail;
+	}
+	else
+	{
+		xCount = ( pxStreamBuffer->xLength - xTail ) + xHead;
+	}
+
+	return xCount;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvCopyToBuffer( xSTREAM_BUFFER * const pxStreamBuffer, size_t xHead, const unsigned char *pucData, size_t xCount )
+{
+size_t xFirst;
+
+	/* Copy up to the end of the storage area, then the rest from the start. */
+	xFirst = pxStreamBuffer->xLength - xHead;
+	if( xFirst > xCount )
+	{
+		xFirst = xCount;
+	}
+
+	( void ) memcpy( ( void * ) &( pxStreamBuffer->pucBuffer[ xHead ] ), ( const void * ) pucData, xFirst );
+
+	if( xCount > xFirst )
+	{
+		( void ) memcpy( ( void * ) pxStreamBuffer->pucBuffer, ( const void * ) &( pucData[ xFirst ] ), xCount - xFirst );
+	}
+
+	xHead += xCount;
+	if( xHead >= pxStreamBuffer->xLength )
+	{
+		xHead -= pxStreamBuffer->xLength;
+	}
+
+	return xHead;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvCopyFromBuffer( const xSTREAM_BUFFER * const pxStreamBuffer, size_t xTail, unsigned char *pucData, size_t xCount )
+{
+size_t xFirst;
+
+	xFirst = pxStreamBuffer->xLength - xTail;
+	if( xFirst > xCount )
+	{
+		xFirst = xCount;
+	}
+
+	( void ) memcpy( ( void * ) pucData, ( const void * ) &( pxStreamBuffer->pucBuffer[ xTail ] ), xFirst );
+
+	if( xCount > xFirst )
+	{
+		( void ) memcpy( ( void * ) &( pucData[ xFirst ] ), ( const void * ) pxStreamBuffer->pucBuffer, xCount - xFirst );
+	}
+
+	xTail += xCount;
+	if( xTail >= pxStreamBuffer->xLength )
+	{
+		xTail -= pxStreamBuffer->xLength;
+	}
+
+	return xTail;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvWriteToBuffer( xSTREAM_BUFFER * const pxStreamBuffer, const unsigned char *pucTxData, size_t xDataLengthBytes, size_t *pxHead, size_t xTail )
+{
+size_t xSpace, xWritten;
+
+	xSpace = ( pxStreamBuffer->xLength - ( size_t ) 1 ) - prvBytesInBuffer( pxStreamBuffer, *pxHead, xTail );
+
+	if( pxStreamBuffer->ucIsMessageBuffer != pdFALSE )
+	{
+		/* All of the message and its length, or nothing. */
+		if( ( xDataLengthBytes != ( size_t ) 0 ) && ( xSpace >= ( xDataLengthBytes + sbMESSAGE_LENGTH_BYTES ) ) )
+		{
+			*pxHead = prvCopyToBuffer( pxStreamBuffer, *pxHead, ( const unsigned char * ) &xDataLengthBytes, sbMESSAGE_LENGTH_BYTES );
+			xWritten = xDataLengthBytes;
+		}
+		else
+		{
+			xWritten = ( size_t ) 0;
+		}
+	}
+	else
+	{
+		/* As much of the stream as will fit. */
+		xWritten = ( xDataLengthBytes < xSpace ) ? xDataLengthBytes : xSpace;
+	}
+
+	if( xWritten != ( size_t ) 0 )
+	{
+		*pxHead = prvCopyToBuffer( pxStreamBuffer, *pxHead, pucTxData, xWritten );
+	}
+
+	return xWritten;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvReadFromBuffer( xSTREAM_BUFFER * const pxStreamBuffer, unsigned char *pucRxData, size_t xBufferLengthBytes, size_t xHead, size_t *pxTail )
+{
+size_t xAvailable, xRead, xMessageLength;
+
+	xAvailable = prvBytesInBuffer( pxStreamBuffer, xHead, *pxTail );
+
+	if( pxStreamBuffer->ucIsMessageBuffer != pdFALSE )
+	{
+		xRead = ( size_t ) 0;
+
+		/* A message is published with its length in one step, so if the
+		length is there the whole message is. */
+		if( xAvailable >= sbMESSAGE_LENGTH_BYTES )
+		{
+			( void ) prvCopyFromBuffer( pxStreamBuffer, *pxTail, ( unsigned char * ) &xMessageLength, sbMESSAGE_LENGTH_BYTES );
+
+			if( xMessageLength <= xBufferLengthBytes )
+			{
+				*pxTail = prvCopyFromBuffer( pxStreamBuffer, *pxTail, ( unsigned char * ) &xMessageLength, sbMESSAGE_LENGTH_BYTES );
+				xRead = xMessageLength;
+			}
+		}
+	}
+	else
+	{
+		xRead = ( xBufferLengthBytes < xAvailable ) ? xBufferLengthBytes : xAvailable;
+	}
+
+	if( xRead != ( size_t ) 0 )
+	{
+		*pxTail = prvCopyFromBuffer( pxStreamBuffer, *pxTail, pucRxData, xRead );
+	}
+
+	return xRead;
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvWaitForOtherEnd( xSTREAM_BUFFER * const pxStreamBuffer, unsigned char ucWaiting, size_t xNeeded, xTimeOutType * const pxTimeOut, portTickType * const pxTicksToWait )
+{
+size_t xHead, xTail, xAvailable;
+
+	pxStreamBuffer->ucWaiting = ucWaiting;
+
+	/* Look again now the flag is set, as the other end may have moved its
+	index after this end last looked but before it could see the flag. */
+	taskENTER_CRITICAL();
+	{
+		xHead = pxStreamBuffer->xHead;
+		xTail = pxStreamBuffer->xTail;
+	}
+	taskEXIT_CRITICAL();
+
+	xAvailable = prvBytesInBuffer( pxStreamBuffer, xHead, xTail );
+
+	if( ucWaiting == sbWAITING_SENDER )
+	{
+		xAvailable = ( pxStreamBuffer->xLength - ( size_t ) 1 ) - xAvailable;
+	}
+
+	if( xAvailable >= xNeeded )
+	{
+		pxStreamBuffer->ucWaiting = sbWAITING_NONE;
+		return pdTRUE;
+	}
+
+	if( xTaskCheckForTimeOut( pxTimeOut, pxTicksToWait ) != pdFALSE )
+	{
+		pxStreamBuffer->ucWaiting = sbWAITING_NONE;
+		return pdFALSE;
+	}
+
+	/* A give left over from an earlier wait just means one more time round
+	the caller's loop. */
+	( void ) xSemaphoreTake( pxStreamBuffer->xWaitSemaphore, *pxTicksToWait );
+	pxStreamBuffer->ucWaiting = sbWAITING_NONE;
+
+	return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvIsWaiting( xSTREAM_BUFFER * const pxStreamBuffer, unsigned char ucWaiting )
+{
+portBASE_TYPE xReturn = pdFALSE;
+
+	if( pxStreamBuffer->ucWaiting == ucWaiting )
+	{
+		pxStreamBuffer->ucWaiting = sbWAITING_NONE;
+		xReturn = pdTRUE;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
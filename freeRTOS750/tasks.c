@@ -77,6 +77,10 @@ task.h is included from an application file. */
 #include "timers.h"
 #include "StackMacros.h"
 
+#if ( configUSE_CO_ROUTINES == 1 )
+	#include "croutine.h"
+#endif
+
 /* Lint e961 and e750 are suppressed as a MISRA exception justified because the
 MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
 header files above, but not in this file, in order to generate the correct
@@ -99,9 +103,14 @@ privileged Vs unprivileged linkage and placement. */
 #endif /* configUSE_TICKLESS_IDLE */
 
 /*
- * Defines the size, in words, of the stack allocated to the idle task.
+ * Defines the size, in words, of the stack allocated to the idle task.  The
+ * idle task runs the co-routines, if there are any, and they share its stack.
  */
-#define tskIDLE_STACK_SIZE	configMINIMAL_STACK_SIZE
+#if ( configUSE_CO_ROUTINES == 1 )
+	#define tskIDLE_STACK_SIZE	configCO_ROUTINE_STACK_DEPTH
+#else
+	#define tskIDLE_STACK_SIZE	configMINIMAL_STACK_SIZE
+#endif
 
 /*
  * Task control block.  A task control block (TCB) is allocated for each task,
@@ -122,8 +131,8 @@ typedef struct tskTaskControlBlock
 	portSTACK_TYPE			*pxStack;			/*< Points to the start of the stack. */
 	signed char				pcTaskName[ configMAX_TASK_NAME_LEN ];/*< Descriptive name given to the task when created.  Facilitates debugging only. */
 
-	#if ( portSTACK_GROWTH > 0 )
-		portSTACK_TYPE *pxEndOfStack;			/*< Points to the end of the stack on architectures where the stack grows up from low memory. */
+	#if ( ( portSTACK_GROWTH > 0 ) || ( configUSE_STACK_REPORT == 1 ) )
+		portSTACK_TYPE *pxEndOfStack;			/*< Points to the high address end of the stack, on architectures where the stack grows up from low memory, or for the stack report. */
 	#endif
 
 	#if ( portCRITICAL_NESTING_IN_TCB == 1 )
@@ -147,6 +156,19 @@ typedef struct tskTaskControlBlock
 		unsigned long ulRunTimeCounter;			/*< Stores the amount of time the task has spent in the Running state. */
 	#endif
 
+	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+		volatile unsigned long ulNotifiedValue;	/*< The value last sent to the task by xTaskNotify() and friends. */
+		volatile unsigned char ucNotifyState;	/*< One of the taskNOTIFICATION states below. */
+	#endif
+
+	#if ( configUSE_TASK_MEMORY_BANKS == 1 )
+		unsigned char ucMemoryBank;				/*< The external memory bank selected while the task runs. */
+	#endif
+
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		unsigned char ucStaticallyAllocated;	/*< Set to pdTRUE if the TCB and stack were supplied by xTaskCreateStatic(), so must not be freed. */
+	#endif
+
 	#if ( configUSE_NEWLIB_REENTRANT == 1 )
 		/* Allocate a Newlib reent structure that is specific to this task.
 		Note Newlib support has been included by popular demand, but is not
@@ -176,10 +198,20 @@ PRIVILEGED_DATA tskTCB * volatile pxCurrentTCB = NULL;
 
 /* Lists for ready and blocked tasks. --------------------*/
 PRIVILEGED_DATA static xList pxReadyTasksLists[ configMAX_PRIORITIES ];	/*< Prioritised ready tasks. */
-PRIVILEGED_DATA static xList xDelayedTaskList1;							/*< Delayed tasks. */
-PRIVILEGED_DATA static xList xDelayedTaskList2;							/*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
-PRIVILEGED_DATA static xList * volatile pxDelayedTaskList;				/*< Points to the delayed task list currently being used. */
-PRIVILEGED_DATA static xList * volatile pxOverflowDelayedTaskList;		/*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+
+#if ( configUSE_TIMING_WHEEL == 1 )
+
+	PRIVILEGED_DATA static xList xDelayedTaskWheel[ configTIMING_WHEEL_SLOTS ];	/*< Delayed tasks, each in the slot of its wake time modulo configTIMING_WHEEL_SLOTS.  The slots are not sorted. */
+
+#else
+
+	PRIVILEGED_DATA static xList xDelayedTaskList1;						/*< Delayed tasks. */
+	PRIVILEGED_DATA static xList xDelayedTaskList2;						/*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
+	PRIVILEGED_DATA static xList * volatile pxDelayedTaskList;			/*< Points to the delayed task list currently being used. */
+	PRIVILEGED_DATA static xList * volatile pxOverflowDelayedTaskList;	/*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+
+#endif
+
 PRIVILEGED_DATA static xList xPendingReadyList;							/*< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready list when the scheduler is resumed. */
 
 #if ( INCLUDE_vTaskDelete == 1 )
@@ -238,6 +270,24 @@ PRIVILEGED_DATA static volatile portTickType xNextTaskUnblockTime				= portMAX_D
 #define tskDELETED_CHAR		( ( signed char ) 'D' )
 #define tskSUSPENDED_CHAR	( ( signed char ) 'S' )
 
+/*
+ * Values for the ucNotifyState member of the TCB.
+ */
+#define taskNOT_WAITING_NOTIFICATION	( ( unsigned char ) 0 )
+#define taskWAITING_NOTIFICATION		( ( unsigned char ) 1 )
+#define taskNOTIFICATION_RECEIVED		( ( unsigned char ) 2 )
+
+/*
+ * Set in the event list item value of a task blocked on an event group, while
+ * the value holds event bits rather than the task priority, so that a priority
+ * change leaves it alone.  The event groups never use this bit themselves.
+ */
+#if configUSE_16_BIT_TICKS == 1
+	#define taskEVENT_LIST_ITEM_VALUE_IN_USE	0x8000U
+#else
+	#define taskEVENT_LIST_ITEM_VALUE_IN_USE	0x80000000UL
+#endif
+
 /*-----------------------------------------------------------*/
 
 #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
@@ -318,6 +368,21 @@ PRIVILEGED_DATA static volatile portTickType xNextTaskUnblockTime				= portMAX_D
 
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TIMING_WHEEL == 1 )
+
+/* A task's slot in the timing wheel depends only on the low bits of its wake
+time, and a task is woken when the tick count equals its wake time, so the
+wheel needs nothing doing when the tick count overflows. */
+#define taskSWITCH_DELAYED_LISTS()	xNumOfOverflows++
+
+#define taskDELAYED_LIST_FOR_TIME( xTime )	( &( xDelayedTaskWheel[ ( xTime ) & ( portTickType ) ( configTIMING_WHEEL_SLOTS - 1 ) ] ) )
+
+#define taskIS_DELAYED_LIST( pxList )	( ( ( pxList ) >= &( xDelayedTaskWheel[ 0 ] ) ) && ( ( pxList ) < &( xDelayedTaskWheel[ configTIMING_WHEEL_SLOTS ] ) ) )
+
+#else
+
+#define taskIS_DELAYED_LIST( pxList )	( ( ( pxList ) == pxDelayedTaskList ) || ( ( pxList ) == pxOverflowDelayedTaskList ) )
+
 /* pxDelayedTaskList and pxOverflowDelayedTaskList are switched when the tick
 count overflows. */
 #define taskSWITCH_DELAYED_LISTS()																	\
@@ -352,6 +417,8 @@ count overflows. */
 	}																								\
 }
 
+#endif /* configUSE_TIMING_WHEEL */
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -429,11 +496,52 @@ static void prvCheckTasksWaitingTermination( void ) PRIVILEGED_FUNCTION;
  */
 static void prvAddCurrentTaskToDelayedList( portTickType xTimeToWake ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_TIMING_WHEEL == 1 )
+
+	/*
+	 * Called from the tick interrupt.  Moves the tasks whose wake time is
+	 * xConstTickCount from the timing wheel to the ready lists, returning
+	 * pdTRUE if one of them should preempt the running task.  Only the slot
+	 * for this tick is looked at.
+	 */
+	static portBASE_TYPE prvCheckDelayedTaskWheel( const portTickType xConstTickCount ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Returns the earliest wake time of the tasks in the timing wheel, or
+	 * portMAX_DELAY if it is empty.  Looks at every delayed task, so is only
+	 * used by tickless idle, with the scheduler suspended.
+	 */
+	#if ( configUSE_TICKLESS_IDLE != 0 )
+
+		static portTickType prvDelayedTaskWheelNextUnblockTime( void ) PRIVILEGED_FUNCTION;
+
+	#endif
+
+#endif
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	/*
+	 * The currently executing task is blocking to wait for a notification.
+	 * Move it from its ready list to the delayed task list, or to the
+	 * suspended task list if it is to wait indefinitely.  Must be called from
+	 * a critical section.
+	 */
+	static void prvBlockCurrentTaskForNotification( portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Allocates memory from the heap for a TCB and associated stack.  Checks the
- * allocation was successful.
+ * allocation was successful.  If pxTaskBuffer is not NULL the TCB and stack
+ * are the caller's buffers and nothing is allocated.
+ */
+static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TYPE *puxStackBuffer, tskTCB *pxTaskBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * The body of xTaskGenericCreate() and xTaskCreateStatic().
  */
-static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TYPE *puxStackBuffer ) PRIVILEGED_FUNCTION;
+static signed portBASE_TYPE prvTaskGenericCreate( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, xTaskHandle *pxCreatedTask, portSTACK_TYPE *puxStackBuffer, const xMemoryRegion * const xRegions, tskTCB *pxTaskBuffer ) PRIVILEGED_FUNCTION;
 
 /*
  * Fills an xTaskStatusType structure with information on each task that is
@@ -476,6 +584,35 @@ static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TY
 #endif
 
 signed portBASE_TYPE xTaskGenericCreate( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, xTaskHandle *pxCreatedTask, portSTACK_TYPE *puxStackBuffer, const xMemoryRegion * const xRegions )
+{
+	return prvTaskGenericCreate( pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask, puxStackBuffer, xRegions, NULL );
+}
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	xTaskHandle xTaskCreateStatic( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, portSTACK_TYPE *puxStackBuffer, xStaticTask *pxTaskBuffer )
+	{
+	xTaskHandle xReturn = NULL;
+
+		/* xStaticTask is a public copy of the TCB layout.  If this fails the
+		two have got out of step. */
+		configASSERT( sizeof( xStaticTask ) == sizeof( tskTCB ) );
+		configASSERT( puxStackBuffer );
+		configASSERT( pxTaskBuffer );
+
+		if( ( puxStackBuffer != NULL ) && ( pxTaskBuffer != NULL ) )
+		{
+			( void ) prvTaskGenericCreate( pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, &xReturn, puxStackBuffer, NULL, ( tskTCB * ) pxTaskBuffer );
+		}
+
+		return xReturn;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+static signed portBASE_TYPE prvTaskGenericCreate( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, xTaskHandle *pxCreatedTask, portSTACK_TYPE *puxStackBuffer, const xMemoryRegion * const xRegions, tskTCB *pxTaskBuffer )
 {
 signed portBASE_TYPE xReturn;
 tskTCB * pxNewTCB;
@@ -485,7 +622,7 @@ tskTCB * pxNewTCB;
 
 	/* Allocate the memory required by the TCB and stack for the new task,
 	checking that the allocation was successful. */
-	pxNewTCB = prvAllocateTCBAndStack( usStackDepth, puxStackBuffer );
+	pxNewTCB = prvAllocateTCBAndStack( usStackDepth, puxStackBuffer, pxTaskBuffer );
 
 	if( pxNewTCB != NULL )
 	{
@@ -516,6 +653,14 @@ tskTCB * pxNewTCB;
 
 			/* Check the alignment of the calculated top of stack is correct. */
 			configASSERT( ( ( ( unsigned long ) pxTopOfStack & ( unsigned long ) portBYTE_ALIGNMENT_MASK ) == 0UL ) );
+
+			#if ( configUSE_STACK_REPORT == 1 )
+			{
+				/* Keep the other extreme of the stack, so uxTaskGetSystemState()
+				can report the size of the stack. */
+				pxNewTCB->pxEndOfStack = pxTopOfStack;
+			}
+			#endif
 		}
 		#else /* portSTACK_GROWTH */
 		{
@@ -832,7 +977,7 @@ tskTCB * pxNewTCB;
 			}
 			taskEXIT_CRITICAL();
 
-			if( ( pxStateList == pxDelayedTaskList ) || ( pxStateList == pxOverflowDelayedTaskList ) )
+			if( taskIS_DELAYED_LIST( pxStateList ) )
 			{
 				/* The task being queried is referenced from one of the Blocked
 				lists. */
@@ -987,7 +1132,12 @@ tskTCB * pxNewTCB;
 				}
 				#endif
 
-				listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( ( portTickType ) configMAX_PRIORITIES - ( portTickType ) uxNewPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+				/* Only reset the event list item value if it is not holding
+				event group bits. */
+				if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0 )
+				{
+					listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( ( portTickType ) configMAX_PRIORITIES - ( portTickType ) uxNewPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+				}
 
 				/* If the task is in the blocked or suspended list we need do
 				nothing more than change it's priority variable. However, if
@@ -1259,6 +1409,14 @@ portBASE_TYPE xReturn;
 		xSchedulerRunning = pdTRUE;
 		xTickCount = ( portTickType ) 0U;
 
+		#if ( configUSE_TASK_MEMORY_BANKS == 1 )
+		{
+			/* The first task is started without a call to
+			vTaskSwitchContext(), so select its bank here. */
+			portSWITCH_MEMORY_BANK( pxCurrentTCB->ucMemoryBank );
+		}
+		#endif /* configUSE_TASK_MEMORY_BANKS */
+
 		/* If configGENERATE_RUN_TIME_STATS is defined then the following
 		macro must be defined to configure the timer/counter used to generate
 		the run time counter time base. */
@@ -1324,6 +1482,15 @@ void vTaskSuspendAll( void )
 		}
 		else
 		{
+			#if ( configUSE_TIMING_WHEEL == 1 )
+			{
+				if( uxSchedulerSuspended != ( unsigned portBASE_TYPE ) pdFALSE )
+				{
+					xNextTaskUnblockTime = prvDelayedTaskWheelNextUnblockTime();
+				}
+			}
+			#endif /* configUSE_TIMING_WHEEL */
+
 			xReturn = xNextTaskUnblockTime - xTickCount;
 		}
 
@@ -1492,8 +1659,19 @@ unsigned portBASE_TYPE uxTaskGetNumberOfTasks( void )
 
 				/* Fill in an xTaskStatusType structure with information on each
 				task in the Blocked state. */
-				uxTask += prvListTaskWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( xList * ) pxDelayedTaskList, eBlocked );
-				uxTask += prvListTaskWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( xList * ) pxOverflowDelayedTaskList, eBlocked );
+				#if ( configUSE_TIMING_WHEEL == 1 )
+				{
+					for( uxQueue = 0; uxQueue < ( unsigned portBASE_TYPE ) configTIMING_WHEEL_SLOTS; uxQueue++ )
+					{
+						uxTask += prvListTaskWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( xDelayedTaskWheel[ uxQueue ] ), eBlocked );
+					}
+				}
+				#else
+				{
+					uxTask += prvListTaskWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( xList * ) pxDelayedTaskList, eBlocked );
+					uxTask += prvListTaskWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( xList * ) pxOverflowDelayedTaskList, eBlocked );
+				}
+				#endif /* configUSE_TIMING_WHEEL */
 
 				#if( INCLUDE_vTaskDelete == 1 )
 				{
@@ -1570,8 +1748,10 @@ implementations require configUSE_TICKLESS_IDLE to be set to a value other than
 
 portBASE_TYPE xTaskIncrementTick( void )
 {
+#if ( configUSE_TIMING_WHEEL == 0 )
 tskTCB * pxTCB;
 portTickType xItemValue;
+#endif
 portBASE_TYPE xSwitchRequired = pdFALSE;
 
 	/* Called by the portable layer each time a tick interrupt occurs.
@@ -1594,6 +1774,14 @@ portBASE_TYPE xSwitchRequired = pdFALSE;
 				taskSWITCH_DELAYED_LISTS();
 			}
 
+			#if ( configUSE_TIMING_WHEEL == 1 )
+			{
+				if( prvCheckDelayedTaskWheel( xConstTickCount ) != pdFALSE )
+				{
+					xSwitchRequired = pdTRUE;
+				}
+			}
+			#else
 			/* See if this tick has made a timeout expire.  Tasks are stored in the
 			queue in the order of their wake time - meaning once one tasks has been
 			found whose block time has not expired there is no need not look any
@@ -1661,6 +1849,7 @@ portBASE_TYPE xSwitchRequired = pdFALSE;
 					}
 				}
 			}
+			#endif /* configUSE_TIMING_WHEEL */
 		}
 
 		/* Tasks of equal priority to the currently running task will share
@@ -1729,6 +1918,44 @@ portBASE_TYPE xSwitchRequired = pdFALSE;
 #endif /* configUSE_APPLICATION_TASK_TAG */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TASK_MEMORY_BANKS == 1 )
+
+	void vTaskSetMemoryBank( xTaskHandle xTask, unsigned char ucBank )
+	{
+	tskTCB *pxTCB;
+
+		taskENTER_CRITICAL();
+		{
+			/* If null is passed in here then we are setting our own bank. */
+			pxTCB = prvGetTCBFromHandle( xTask );
+			pxTCB->ucMemoryBank = ucBank;
+
+			/* Any other task picks up the bank when it is next switched in,
+			but the running task has to switch now. */
+			if( pxTCB == pxCurrentTCB )
+			{
+				portSWITCH_MEMORY_BANK( ucBank );
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_TASK_MEMORY_BANKS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_MEMORY_BANKS == 1 )
+
+	unsigned char ucTaskGetMemoryBank( xTaskHandle xTask )
+	{
+	tskTCB *pxTCB;
+
+		pxTCB = prvGetTCBFromHandle( xTask );
+		return pxTCB->ucMemoryBank;
+	}
+
+#endif /* configUSE_TASK_MEMORY_BANKS */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_APPLICATION_TASK_TAG == 1 )
 
 	pdTASK_HOOK_CODE xTaskGetApplicationTaskTag( xTaskHandle xTask )
@@ -1832,6 +2059,14 @@ void vTaskSwitchContext( void )
 
 		traceTASK_SWITCHED_IN();
 
+		#if ( configUSE_TASK_MEMORY_BANKS == 1 )
+		{
+			/* The context of the previous task has been saved, and that of
+			the next is not yet restored, so its bank can be selected now. */
+			portSWITCH_MEMORY_BANK( pxCurrentTCB->ucMemoryBank );
+		}
+		#endif /* configUSE_TASK_MEMORY_BANKS */
+
 		#if ( configUSE_NEWLIB_REENTRANT == 1 )
 		{
 			/* Switch Newlib's _impure_ptr variable to point to the _reent
@@ -1987,6 +2222,115 @@ portBASE_TYPE xReturn;
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_EVENT_GROUPS == 1 )
+
+	void vTaskPlaceOnUnorderedEventList( xList * pxEventList, portTickType xItemValue, portTickType xTicksToWait )
+	{
+	portTickType xTimeToWake;
+
+		configASSERT( pxEventList );
+
+		/* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is
+		used by the event groups. */
+		configASSERT( uxSchedulerSuspended != 0 );
+
+		/* Store the bits the task is waiting for in its event list item, in
+		place of its priority.  The list is not in priority order, as each
+		task it holds is unblocked by a different combination of bits, so the
+		item is just added to the end. */
+		listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+		vListInsertEnd( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+
+		/* The rest is as vTaskPlaceOnEventList().  The scheduler is suspended,
+		so interrupts do not touch the ready or delayed lists. */
+		if( uxListRemove( &( pxCurrentTCB->xGenericListItem ) ) == ( unsigned portBASE_TYPE ) 0 )
+		{
+			portRESET_READY_PRIORITY( pxCurrentTCB->uxPriority, uxTopReadyPriority );
+		}
+
+		#if ( INCLUDE_vTaskSuspend == 1 )
+		{
+			if( xTicksToWait == portMAX_DELAY )
+			{
+				vListInsertEnd( &xSuspendedTaskList, &( pxCurrentTCB->xGenericListItem ) );
+			}
+			else
+			{
+				xTimeToWake = xTickCount + xTicksToWait;
+				prvAddCurrentTaskToDelayedList( xTimeToWake );
+			}
+		}
+		#else /* INCLUDE_vTaskSuspend */
+		{
+			xTimeToWake = xTickCount + xTicksToWait;
+			prvAddCurrentTaskToDelayedList( xTimeToWake );
+		}
+		#endif /* INCLUDE_vTaskSuspend */
+	}
+
+#endif /* configUSE_EVENT_GROUPS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EVENT_GROUPS == 1 )
+
+	signed portBASE_TYPE xTaskRemoveFromUnorderedEventList( xListItem * pxEventListItem, portTickType xItemValue )
+	{
+	tskTCB *pxUnblockedTCB;
+	portBASE_TYPE xReturn;
+
+		/* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is
+		used by the event groups, which set bits from an interrupt through the
+		timer service task, so it is never called from an interrupt. */
+		configASSERT( uxSchedulerSuspended != 0 );
+
+		/* Hand the bits that unblocked the task back to it. */
+		listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+		pxUnblockedTCB = ( tskTCB * ) listGET_LIST_ITEM_OWNER( pxEventListItem );
+		configASSERT( pxUnblockedTCB );
+		( void ) uxListRemove( pxEventListItem );
+
+		/* Interrupts only use the pending ready list while the scheduler is
+		suspended, so the ready lists can be used directly. */
+		( void ) uxListRemove( &( pxUnblockedTCB->xGenericListItem ) );
+		prvAddTaskToReadyList( pxUnblockedTCB );
+
+		if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+		{
+			/* The task was not moved through the pending ready list, so
+			xTaskResumeAll() must be told to yield. */
+			xYieldPending = pdTRUE;
+			xReturn = pdTRUE;
+		}
+		else
+		{
+			xReturn = pdFALSE;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_EVENT_GROUPS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EVENT_GROUPS == 1 )
+
+	portTickType uxTaskResetEventItemValue( void )
+	{
+	portTickType uxReturn;
+
+		uxReturn = listGET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ) );
+
+		/* Put the priority back, for the next time the task blocks on a queue
+		or semaphore. */
+		listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), ( ( portTickType ) configMAX_PRIORITIES - ( portTickType ) pxCurrentTCB->uxPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+		return uxReturn;
+	}
+
+#endif /* configUSE_EVENT_GROUPS */
+/*-----------------------------------------------------------*/
+
 void vTaskSetTimeOutState( xTimeOutType * const pxTimeOut )
 {
 	configASSERT( pxTimeOut );
@@ -2137,6 +2481,15 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 		}
 		#endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) ) */
 
+		#if ( configUSE_CO_ROUTINES == 1 )
+		{
+			/* Run the highest priority ready co-routine, on this task's stack.
+			Co-routines therefore only run when no task of a higher priority
+			than the idle task is able to run. */
+			vCoRoutineSchedule();
+		}
+		#endif /* configUSE_CO_ROUTINES */
+
 		#if ( configUSE_IDLE_HOOK == 1 )
 		{
 			extern void vApplicationIdleHook( void );
@@ -2295,6 +2648,20 @@ unsigned portBASE_TYPE x;
 	}
 	#endif /* configGENERATE_RUN_TIME_STATS */
 
+	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+	{
+		pxTCB->ulNotifiedValue = 0UL;
+		pxTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+	}
+	#endif /* configUSE_TASK_NOTIFICATIONS */
+
+	#if ( configUSE_TASK_MEMORY_BANKS == 1 )
+	{
+		/* Bank 0 is shared by every task that has not been given a bank. */
+		pxTCB->ucMemoryBank = 0U;
+	}
+	#endif /* configUSE_TASK_MEMORY_BANKS */
+
 	#if ( portUSING_MPU_WRAPPERS == 1 )
 	{
 		vPortStoreTaskMPUSettings( &( pxTCB->xMPUSettings ), xRegions, pxTCB->pxStack, usStackDepth );
@@ -2339,8 +2706,20 @@ unsigned portBASE_TYPE uxPriority;
 		vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
 	}
 
-	vListInitialise( &xDelayedTaskList1 );
-	vListInitialise( &xDelayedTaskList2 );
+	#if ( configUSE_TIMING_WHEEL == 1 )
+	{
+		for( uxPriority = ( unsigned portBASE_TYPE ) 0U; uxPriority < ( unsigned portBASE_TYPE ) configTIMING_WHEEL_SLOTS; uxPriority++ )
+		{
+			vListInitialise( &( xDelayedTaskWheel[ uxPriority ] ) );
+		}
+	}
+	#else
+	{
+		vListInitialise( &xDelayedTaskList1 );
+		vListInitialise( &xDelayedTaskList2 );
+	}
+	#endif /* configUSE_TIMING_WHEEL */
+
 	vListInitialise( &xPendingReadyList );
 
 	#if ( INCLUDE_vTaskDelete == 1 )
@@ -2355,10 +2734,14 @@ unsigned portBASE_TYPE uxPriority;
 	}
 	#endif /* INCLUDE_vTaskSuspend */
 
-	/* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
-	using list2. */
-	pxDelayedTaskList = &xDelayedTaskList1;
-	pxOverflowDelayedTaskList = &xDelayedTaskList2;
+	#if ( configUSE_TIMING_WHEEL == 0 )
+	{
+		/* Start with pxDelayedTaskList using list1 and the
+		pxOverflowDelayedTaskList using list2. */
+		pxDelayedTaskList = &xDelayedTaskList1;
+		pxOverflowDelayedTaskList = &xDelayedTaskList2;
+	}
+	#endif /* configUSE_TIMING_WHEEL */
 }
 /*-----------------------------------------------------------*/
 
@@ -2397,6 +2780,132 @@ static void prvCheckTasksWaitingTermination( void )
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TIMING_WHEEL == 1 )
+
+static void prvAddCurrentTaskToDelayedList( portTickType xTimeToWake )
+{
+	/* A wake time of now would otherwise wait for the tick count to come all
+	the way round.  The sorted lists wake such a task on the next tick, so do
+	the same. */
+	if( xTimeToWake == xTickCount )
+	{
+		++xTimeToWake;
+	}
+
+	/* The slot is chosen by the wake time, and the slots are not sorted, so
+	this takes the same time however many tasks are delayed. */
+	listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xGenericListItem ), xTimeToWake );
+	vListInsertEnd( taskDELAYED_LIST_FOR_TIME( xTimeToWake ), &( pxCurrentTCB->xGenericListItem ) );
+
+	#if ( configUSE_TICKLESS_IDLE != 0 )
+	{
+		/* xNextTaskUnblockTime is only a hint here, for the idle task's first
+		look at the expected idle time.  The exact time is found with the
+		scheduler suspended.  As with the sorted lists, a wake time after the
+		tick count overflows is left out. */
+		if( ( xTimeToWake > xTickCount ) && ( xTimeToWake < xNextTaskUnblockTime ) )
+		{
+			xNextTaskUnblockTime = xTimeToWake;
+		}
+	}
+	#endif /* configUSE_TICKLESS_IDLE */
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvCheckDelayedTaskWheel( const portTickType xConstTickCount )
+{
+xList * const pxSlot = taskDELAYED_LIST_FOR_TIME( xConstTickCount );
+const xListItem * const pxEnd = ( const xListItem * ) &( pxSlot->xListEnd );
+xListItem *pxItem, *pxNextItem;
+tskTCB *pxTCB;
+portBASE_TYPE xSwitchRequired = pdFALSE;
+
+	#if ( configUSE_TICKLESS_IDLE != 0 )
+	{
+		if( xConstTickCount == xNextTaskUnblockTime )
+		{
+			/* The next wake time is not known until the wheel is searched,
+			which the idle task does before it sleeps. */
+			xNextTaskUnblockTime = portMAX_DELAY;
+		}
+	}
+	#endif /* configUSE_TICKLESS_IDLE */
+
+	/* The tasks in this slot wake either now, or a whole number of turns of
+	the wheel from now. */
+	for( pxItem = pxSlot->xListEnd.pxNext; pxItem != pxEnd; pxItem = pxNextItem )
+	{
+		pxNextItem = pxItem->pxNext;
+
+		if( listGET_LIST_ITEM_VALUE( pxItem ) == xConstTickCount )
+		{
+			pxTCB = ( tskTCB * ) listGET_LIST_ITEM_OWNER( pxItem );
+
+			/* It is time to remove the item from the Blocked state. */
+			( void ) uxListRemove( pxItem );
+
+			/* Is the task waiting on an event also?  If so remove it from the
+			event list. */
+			if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+			{
+				( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+			}
+
+			prvAddTaskToReadyList( pxTCB );
+
+			#if (  configUSE_PREEMPTION == 1 )
+			{
+				if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+				{
+					xSwitchRequired = pdTRUE;
+				}
+			}
+			#endif /* configUSE_PREEMPTION */
+		}
+	}
+
+	return xSwitchRequired;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TICKLESS_IDLE != 0 )
+
+	static portTickType prvDelayedTaskWheelNextUnblockTime( void )
+	{
+	const xListItem *pxItem;
+	portTickType xTicks, xNearest = portMAX_DELAY;
+	unsigned portBASE_TYPE uxSlot;
+
+		for( uxSlot = 0; uxSlot < ( unsigned portBASE_TYPE ) configTIMING_WHEEL_SLOTS; uxSlot++ )
+		{
+			for( pxItem = xDelayedTaskWheel[ uxSlot ].xListEnd.pxNext; pxItem != ( const xListItem * ) &( xDelayedTaskWheel[ uxSlot ].xListEnd ); pxItem = pxItem->pxNext )
+			{
+				/* Wake times are compared as ticks from now, as the tick
+				count may overflow before some of them. */
+				xTicks = listGET_LIST_ITEM_VALUE( pxItem ) - xTickCount;
+
+				if( xTicks < xNearest )
+				{
+					xNearest = xTicks;
+				}
+			}
+		}
+
+		/* As with the sorted lists, look no further than the tick count
+		overflow.  This also covers an empty wheel. */
+		if( xNearest > ( portTickType ) ( portMAX_DELAY - xTickCount ) )
+		{
+			return portMAX_DELAY;
+		}
+
+		return xTickCount + xNearest;
+	}
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
+#else
+
 static void prvAddCurrentTaskToDelayedList( portTickType xTimeToWake )
 {
 	/* The list item will be inserted in wake time order. */
@@ -2423,10 +2932,29 @@ static void prvAddCurrentTaskToDelayedList( portTickType xTimeToWake )
 }
 /*-----------------------------------------------------------*/
 
-static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TYPE *puxStackBuffer )
+#endif /* configUSE_TIMING_WHEEL */
+
+static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TYPE *puxStackBuffer, tskTCB *pxTaskBuffer )
 {
 tskTCB *pxNewTCB;
 
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	{
+		if( pxTaskBuffer != NULL )
+		{
+			/* The TCB and stack were allocated at link time by the caller. */
+			pxTaskBuffer->pxStack = puxStackBuffer;
+			pxTaskBuffer->ucStaticallyAllocated = pdTRUE;
+			( void ) memset( pxTaskBuffer->pxStack, ( int ) tskSTACK_FILL_BYTE, ( size_t ) usStackDepth * sizeof( portSTACK_TYPE ) );
+			return pxTaskBuffer;
+		}
+	}
+	#else
+	{
+		( void ) pxTaskBuffer;
+	}
+	#endif /* configSUPPORT_STATIC_ALLOCATION */
+
 	/* Allocate space for the TCB.  Where the memory comes from depends on
 	the implementation of the port malloc function. */
 	pxNewTCB = ( tskTCB * ) pvPortMalloc( sizeof( tskTCB ) );
@@ -2446,6 +2974,12 @@ tskTCB *pxNewTCB;
 		}
 		else
 		{
+			#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				pxNewTCB->ucStaticallyAllocated = pdFALSE;
+			}
+			#endif
+
 			/* Just to help debugging. */
 			( void ) memset( pxNewTCB->pxStack, ( int ) tskSTACK_FILL_BYTE, ( size_t ) usStackDepth * sizeof( portSTACK_TYPE ) );
 		}
@@ -2510,6 +3044,16 @@ tskTCB *pxNewTCB;
 				}
 				#endif
 
+				#if ( ( portSTACK_GROWTH > 0 ) || ( configUSE_STACK_REPORT == 1 ) )
+				{
+					pxTaskStatusArray[ uxTask ].usStackDepth = ( unsigned short ) ( ( pxNextTCB->pxEndOfStack - pxNextTCB->pxStack ) + 1 );
+				}
+				#else
+				{
+					pxTaskStatusArray[ uxTask ].usStackDepth = 0;
+				}
+				#endif
+
 				uxTask++;
 
 			} while( pxNextTCB != pxFirstTCB );
@@ -2578,6 +3122,17 @@ tskTCB *pxNewTCB;
 		want to allocate and clean RAM statically. */
 		portCLEAN_UP_TCB( pxTCB );
 
+		#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		{
+			/* The caller owns the buffers of a task created with
+			xTaskCreateStatic(), and can reuse them once it has been deleted. */
+			if( pxTCB->ucStaticallyAllocated != pdFALSE )
+			{
+				return;
+			}
+		}
+		#endif
+
 		/* Free up the memory allocated by the scheduler for the task.  It is up to
 		the task to free any memory allocated at the application level. */
 		vPortFreeAligned( pxTCB->pxStack );
@@ -2644,8 +3199,13 @@ tskTCB *pxNewTCB;
 		{
 			if( pxTCB->uxPriority < pxCurrentTCB->uxPriority )
 			{
-				/* Adjust the mutex holder state to account for its new priority. */
-				listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( portTickType ) configMAX_PRIORITIES - ( portTickType ) pxCurrentTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+				/* Adjust the mutex holder state to account for its new
+				priority, unless its event list item value is holding event
+				group bits. */
+				if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0 )
+				{
+					listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( portTickType ) configMAX_PRIORITIES - ( portTickType ) pxCurrentTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+				}
 
 				/* If the task being modified is in the ready state it will need to
 				be moved into a new list. */
@@ -2695,7 +3255,10 @@ tskTCB *pxNewTCB;
 				ready list. */
 				traceTASK_PRIORITY_DISINHERIT( pxTCB, pxTCB->uxBasePriority );
 				pxTCB->uxPriority = pxTCB->uxBasePriority;
-				listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( portTickType ) configMAX_PRIORITIES - ( portTickType ) pxTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+				if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0 )
+				{
+					listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( portTickType ) configMAX_PRIORITIES - ( portTickType ) pxTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+				}
 				prvAddTaskToReadyList( pxTCB );
 			}
 		}
@@ -2926,6 +3489,329 @@ tskTCB *pxNewTCB;
 	}
 
 #endif /* configGENERATE_RUN_TIME_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	static void prvBlockCurrentTaskForNotification( portTickType xTicksToWait )
+	{
+	portTickType xTimeToWake;
+
+		/* The task is not on an event list, so only its generic list item
+		moves, as in vTaskPlaceOnEventList(). */
+		if( uxListRemove( &( pxCurrentTCB->xGenericListItem ) ) == ( unsigned portBASE_TYPE ) 0 )
+		{
+			portRESET_READY_PRIORITY( pxCurrentTCB->uxPriority, uxTopReadyPriority );
+		}
+
+		#if ( INCLUDE_vTaskSuspend == 1 )
+		{
+			if( xTicksToWait == portMAX_DELAY )
+			{
+				vListInsertEnd( &xSuspendedTaskList, &( pxCurrentTCB->xGenericListItem ) );
+			}
+			else
+			{
+				xTimeToWake = xTickCount + xTicksToWait;
+				prvAddCurrentTaskToDelayedList( xTimeToWake );
+			}
+		}
+		#else /* INCLUDE_vTaskSuspend */
+		{
+			xTimeToWake = xTickCount + xTicksToWait;
+			prvAddCurrentTaskToDelayedList( xTimeToWake );
+		}
+		#endif /* INCLUDE_vTaskSuspend */
+	}
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	unsigned long ulTaskNotifyTake( portBASE_TYPE xClearCountOnExit, portTickType xTicksToWait )
+	{
+	unsigned long ulReturn;
+
+		taskENTER_CRITICAL();
+		{
+			/* Only block if the notification count is not already non-zero. */
+			if( pxCurrentTCB->ulNotifiedValue == 0UL )
+			{
+				pxCurrentTCB->ucNotifyState = taskWAITING_NOTIFICATION;
+
+				if( xTicksToWait > ( portTickType ) 0 )
+				{
+					prvBlockCurrentTaskForNotification( xTicksToWait );
+
+					/* As in queue.c, it is ok to yield from within the
+					critical section - the kernel takes care of that. */
+					portYIELD_WITHIN_API();
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		taskENTER_CRITICAL();
+		{
+			ulReturn = pxCurrentTCB->ulNotifiedValue;
+
+			if( ulReturn != 0UL )
+			{
+				if( xClearCountOnExit != pdFALSE )
+				{
+					pxCurrentTCB->ulNotifiedValue = 0UL;
+				}
+				else
+				{
+					pxCurrentTCB->ulNotifiedValue = ulReturn - 1UL;
+				}
+			}
+
+			pxCurrentTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+		}
+		taskEXIT_CRITICAL();
+
+		return ulReturn;
+	}
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	portBASE_TYPE xTaskNotifyWait( unsigned long ulBitsToClearOnEntry, unsigned long ulBitsToClearOnExit, unsigned long *pulNotificationValue, portTickType xTicksToWait )
+	{
+	portBASE_TYPE xReturn;
+
+		taskENTER_CRITICAL();
+		{
+			/* Only block if a notification is not already pending. */
+			if( pxCurrentTCB->ucNotifyState != taskNOTIFICATION_RECEIVED )
+			{
+				pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnEntry;
+				pxCurrentTCB->ucNotifyState = taskWAITING_NOTIFICATION;
+
+				if( xTicksToWait > ( portTickType ) 0 )
+				{
+					prvBlockCurrentTaskForNotification( xTicksToWait );
+					portYIELD_WITHIN_API();
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		taskENTER_CRITICAL();
+		{
+			if( pulNotificationValue != NULL )
+			{
+				/* Output the current notification value, which may or may
+				not have changed. */
+				*pulNotificationValue = pxCurrentTCB->ulNotifiedValue;
+			}
+
+			/* If the state is still waiting then no notification arrived
+			before the block time expired. */
+			if( pxCurrentTCB->ucNotifyState == taskWAITING_NOTIFICATION )
+			{
+				xReturn = pdFALSE;
+			}
+			else
+			{
+				pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnExit;
+				xReturn = pdTRUE;
+			}
+
+			pxCurrentTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	/*
+	 * Update the notification value of pxTCB as eAction says.  Returns pdFAIL
+	 * only for eSetValueWithoutOverwrite when a notification is pending.  Must
+	 * be called from a critical section or an ISR.
+	 */
+	static portBASE_TYPE prvUpdateNotifiedValue( tskTCB * const pxTCB, unsigned long ulValue, eNotifyAction eAction, unsigned char ucOriginalNotifyState )
+	{
+	portBASE_TYPE xReturn = pdPASS;
+
+		switch( eAction )
+		{
+			case eSetBits :
+				pxTCB->ulNotifiedValue |= ulValue;
+				break;
+
+			case eIncrement :
+				( pxTCB->ulNotifiedValue )++;
+				break;
+
+			case eSetValueWithOverwrite :
+				pxTCB->ulNotifiedValue = ulValue;
+				break;
+
+			case eSetValueWithoutOverwrite :
+				if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
+				{
+					pxTCB->ulNotifiedValue = ulValue;
+				}
+				else
+				{
+					/* The value could not be written to the task. */
+					xReturn = pdFAIL;
+				}
+				break;
+
+			case eNoAction :
+			default :
+				/* The task is being notified without its notify value being
+				updated. */
+				break;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	portBASE_TYPE xTaskGenericNotify( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction, unsigned long *pulPreviousNotificationValue )
+	{
+	tskTCB * const pxTCB = ( tskTCB * ) xTaskToNotify;
+	portBASE_TYPE xReturn;
+	unsigned char ucOriginalNotifyState;
+
+		configASSERT( pxTCB );
+
+		taskENTER_CRITICAL();
+		{
+			if( pulPreviousNotificationValue != NULL )
+			{
+				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue;
+			}
+
+			ucOriginalNotifyState = pxTCB->ucNotifyState;
+			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+
+			xReturn = prvUpdateNotifiedValue( pxTCB, ulValue, eAction, ucOriginalNotifyState );
+
+			/* If the task is blocked waiting for a notification then unblock
+			it now.  It is not on an event list, only a delayed or the
+			suspended list. */
+			if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
+			{
+				( void ) uxListRemove( &( pxTCB->xGenericListItem ) );
+				prvAddTaskToReadyList( pxTCB );
+
+				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				{
+					/* The notified task has a priority above the currently
+					executing task so a yield is required. */
+					portYIELD_WITHIN_API();
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	portBASE_TYPE xTaskGenericNotifyFromISR( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction, unsigned long *pulPreviousNotificationValue, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+	{
+	tskTCB * const pxTCB = ( tskTCB * ) xTaskToNotify;
+	portBASE_TYPE xReturn;
+	unsigned char ucOriginalNotifyState;
+	unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+		configASSERT( pxTCB );
+
+		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			if( pulPreviousNotificationValue != NULL )
+			{
+				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue;
+			}
+
+			ucOriginalNotifyState = pxTCB->ucNotifyState;
+			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+
+			xReturn = prvUpdateNotifiedValue( pxTCB, ulValue, eAction, ucOriginalNotifyState );
+
+			if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
+			{
+				if( uxSchedulerSuspended == ( unsigned portBASE_TYPE ) pdFALSE )
+				{
+					( void ) uxListRemove( &( pxTCB->xGenericListItem ) );
+					prvAddTaskToReadyList( pxTCB );
+				}
+				else
+				{
+					/* The delayed and ready lists cannot be accessed, so hold
+					the task pending until the scheduler is resumed, as
+					xTaskRemoveFromEventList() does. */
+					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+				}
+
+				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				{
+					if( pxHigherPriorityTaskWoken != NULL )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+				}
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		return xReturn;
+	}
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	portBASE_TYPE xTaskNotifyStateClear( xTaskHandle xTask )
+	{
+	tskTCB *pxTCB;
+	portBASE_TYPE xReturn;
+
+		pxTCB = prvGetTCBFromHandle( xTask );
+
+		taskENTER_CRITICAL();
+		{
+			if( pxTCB->ucNotifyState == taskNOTIFICATION_RECEIVED )
+			{
+				pxTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+				xReturn = pdPASS;
+			}
+			else
+			{
+				xReturn = pdFAIL;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
 
 
 
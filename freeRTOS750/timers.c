@@ -75,6 +75,10 @@ task.h is included from an application file. */
 #include "queue.h"
 #include "timers.h"
 
+#if ( configUSE_EVENT_GROUPS == 1 )
+	#include "event_groups.h"
+#endif
+
 /* Lint e961 and e750 are suppressed as a MISRA exception justified because the
 MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
 header files above, but not in this file, in order to generate the correct
@@ -95,11 +99,16 @@ configUSE_TIMERS is set to 1 in FreeRTOSConfig.h. */
 typedef struct tmrTimerControl
 {
 	const signed char		*pcTimerName;		/*<< Text name.  This is not used by the kernel, it is included simply to make debugging easier. */
-	xListItem				xTimerListItem;		/*<< Standard linked list item as used by all kernel features for event management. */
+	xListItem				xTimerListItem;		/*<< Standard linked list item as used by all kernel features for event management.  While the timer is active the item value is the tick count at which its current period started. */
 	portTickType			xTimerPeriodInTicks;/*<< How quickly and often the timer expires. */
+	portTickType			xTimerSlackInTicks;	/*<< How long after its expiry time the callback may be run, so that it can share a wake up of the timer service task with other timers. */
 	unsigned portBASE_TYPE	uxAutoReload;		/*<< Set to pdTRUE if the timer should be automatically restarted once expired.  Set to pdFALSE if the timer is, in effect, a one shot timer. */
 	void 					*pvTimerID;			/*<< An ID to identify the timer.  This allows the timer to be identified when the same callback is used for multiple timers. */
 	tmrTIMER_CALLBACK		pxCallbackFunction;	/*<< The function that will be called when the timer expires. */
+
+	#if ( configUSE_TIMER_STATS == 1 )
+		xTimerStatsType		xStats;				/*<< Callback counts and run times, read with vTimerGetStats(). */
+	#endif
 } xTIMER;
 
 /* The definition of messages that can be sent and received on the timer
@@ -114,13 +123,15 @@ typedef struct tmrTimerQueueMessage
 /*lint -e956 A manual analysis and inspection has been used to determine which
 static variables must be declared volatile. */
 
-/* The list in which active timers are stored.  Timers are referenced in expire
-time order, with the nearest expiry time at the front of the list.  Only the
-timer service task is allowed to access xActiveTimerList. */
-PRIVILEGED_DATA static xList xActiveTimerList1;
-PRIVILEGED_DATA static xList xActiveTimerList2;
-PRIVILEGED_DATA static xList *pxCurrentTimerList;
-PRIVILEGED_DATA static xList *pxOverflowTimerList;
+/* The list in which active timers are stored.  The list is not sorted, so
+starting, stopping and changing a timer never searches it.  Instead the timer
+service task looks at every active timer each time it wakes, runs the callback
+of each one that has expired, and works out when it next needs to wake.  Only
+the timer service task is allowed to access xActiveTimerList. */
+PRIVILEGED_DATA static xList xActiveTimerList;
+
+/* The tick count when the timer service task last looked at the active timers. */
+PRIVILEGED_DATA static portTickType xLastTime = ( portTickType ) 0U;
 
 /* A queue that is used to send commands to the timer service task. */
 PRIVILEGED_DATA static xQueueHandle xTimerQueue = NULL;
@@ -155,42 +166,32 @@ static void prvTimerTask( void *pvParameters ) PRIVILEGED_FUNCTION;
 static void	prvProcessReceivedCommands( void ) PRIVILEGED_FUNCTION;
 
 /*
- * Insert the timer into either xActiveTimerList1, or xActiveTimerList2,
- * depending on if the expire time causes a timer counter overflow.
- */
-static portBASE_TYPE prvInsertTimerInActiveList( xTIMER *pxTimer, portTickType xNextExpiryTime, portTickType xTimeNow, portTickType xCommandTime ) PRIVILEGED_FUNCTION;
-
-/*
- * An active timer has reached its expire time.  Reload the timer if it is an
- * auto reload timer, then call its callback.
- */
-static void prvProcessExpiredTimer( portTickType xNextExpireTime, portTickType xTimeNow ) PRIVILEGED_FUNCTION;
-
-/*
- * The tick count has overflowed.  Switch the timer lists after ensuring the
- * current timer list does not still reference some timers.
+ * Make the timer active, with its current period starting at xPeriodStart.
+ * The timer is added to the end of the unsorted active timer list.
  */
-static void prvSwitchTimerLists( portTickType xLastTime ) PRIVILEGED_FUNCTION;
+static void prvInsertTimerInActiveList( xTIMER *pxTimer, portTickType xPeriodStart ) PRIVILEGED_FUNCTION;
 
 /*
- * Obtain the current tick count, setting *pxTimerListsWereSwitched to pdTRUE
- * if a tick count overflow occurred since prvSampleTimeNow() was last called.
+ * Run the callback of every active timer that has expired by xTimeNow,
+ * reloading or stopping each one, then return the number of ticks from
+ * xTimeNow until the timer service task must next wake.  That is the earliest
+ * expiry time plus slack of the timers still active, so timers whose expiry
+ * times fall within each other's slack are run from the same wake up.
  */
-static portTickType prvSampleTimeNow( portBASE_TYPE *pxTimerListsWereSwitched ) PRIVILEGED_FUNCTION;
+static portTickType prvProcessExpiredTimers( portTickType xTimeNow ) PRIVILEGED_FUNCTION;
 
 /*
- * If the timer list contains any active timers then return the expire time of
- * the timer that will expire first and set *pxListWasEmpty to false.  If the
- * timer list does not contain any timers then return 0 and set *pxListWasEmpty
- * to pdTRUE.
+ * Run the callback of an expired timer, recording its run time when
+ * configUSE_TIMER_STATS is 1.  xLateness is the number of ticks since the
+ * timer's expiry time.
  */
-static portTickType prvGetNextExpireTime( portBASE_TYPE *pxListWasEmpty ) PRIVILEGED_FUNCTION;
+static void prvRunTimerCallback( xTIMER *pxTimer, portTickType xLateness ) PRIVILEGED_FUNCTION;
 
 /*
- * If a timer has expired, process it.  Otherwise, block the timer service task
- * until either a timer does expire or a command is received.
+ * Block the timer service task until xTicksToWait ticks after xLastTime, or
+ * until a command is received, whichever comes first.
  */
-static void prvProcessTimerOrBlockTask( portTickType xNextExpireTime, portBASE_TYPE xListWasEmpty ) PRIVILEGED_FUNCTION;
+static void prvWaitForTimerOrCommand( portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
 
 /*-----------------------------------------------------------*/
 
@@ -247,10 +248,21 @@ xTIMER *pxNewTimer;
 			/* Initialise the timer structure members using the function parameters. */
 			pxNewTimer->pcTimerName = pcTimerName;
 			pxNewTimer->xTimerPeriodInTicks = xTimerPeriodInTicks;
+			pxNewTimer->xTimerSlackInTicks = configTIMER_DEFAULT_SLACK;
 			pxNewTimer->uxAutoReload = uxAutoReload;
 			pxNewTimer->pvTimerID = pvTimerID;
 			pxNewTimer->pxCallbackFunction = pxCallbackFunction;
 			vListInitialiseItem( &( pxNewTimer->xTimerListItem ) );
+			listSET_LIST_ITEM_OWNER( &( pxNewTimer->xTimerListItem ), pxNewTimer );
+
+			#if ( configUSE_TIMER_STATS == 1 )
+			{
+				pxNewTimer->xStats.ulCallbacks = 0UL;
+				pxNewTimer->xStats.ulTotalRunTime = 0UL;
+				pxNewTimer->xStats.ulMaxRunTime = 0UL;
+				pxNewTimer->xStats.xMaxLateness = ( portTickType ) 0U;
+			}
+			#endif
 
 			traceTIMER_CREATE( pxNewTimer );
 		}
@@ -314,202 +326,167 @@ xTIMER_MESSAGE xMessage;
 #endif
 /*-----------------------------------------------------------*/
 
-static void prvProcessExpiredTimer( portTickType xNextExpireTime, portTickType xTimeNow )
+static portTickType prvProcessExpiredTimers( portTickType xTimeNow )
 {
+xListItem *pxItem, *pxNextItem;
+const xListItem * const pxEnd = ( const xListItem * ) &( xActiveTimerList.xListEnd );
 xTIMER *pxTimer;
-portBASE_TYPE xResult;
-
-	/* Remove the timer from the list of active timers.  A check has already
-	been performed to ensure the list is not empty. */
-	pxTimer = ( xTIMER * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList );
-	( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
-	traceTIMER_EXPIRED( pxTimer );
-
-	/* If the timer is an auto reload timer then calculate the next
-	expiry time and re-insert the timer in the list of active timers. */
-	if( pxTimer->uxAutoReload == ( unsigned portBASE_TYPE ) pdTRUE )
-	{
-		/* This is the only time a timer is inserted into a list using
-		a time relative to anything other than the current time.  It
-		will therefore be inserted into the correct list relative to
-		the time this task thinks it is now, even if a command to
-		switch lists due to a tick count overflow is already waiting in
-		the timer queue. */
-		if( prvInsertTimerInActiveList( pxTimer, ( xNextExpireTime + pxTimer->xTimerPeriodInTicks ), xTimeNow, xNextExpireTime ) == pdTRUE )
-		{
-			/* The timer expired before it was added to the active timer
-			list.  Reload it now.  */
-			xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START, xNextExpireTime, NULL, tmrNO_DELAY );
-			configASSERT( xResult );
-			( void ) xResult;
-		}
-	}
-
-	/* Call the timer callback. */
-	pxTimer->pxCallbackFunction( ( xTimerHandle ) pxTimer );
-}
-/*-----------------------------------------------------------*/
-
-static void prvTimerTask( void *pvParameters )
-{
-portTickType xNextExpireTime;
-portBASE_TYPE xListWasEmpty;
-
-	/* Just to avoid compiler warnings. */
-	( void ) pvParameters;
+portTickType xElapsed, xLimit, xTicksToWait = portMAX_DELAY;
 
-	for( ;; )
+	for( pxItem = xActiveTimerList.xListEnd.pxNext; pxItem != pxEnd; pxItem = pxNextItem )
 	{
-		/* Query the timers list to see if it contains any timers, and if so,
-		obtain the time at which the next timer will expire. */
-		xNextExpireTime = prvGetNextExpireTime( &xListWasEmpty );
+		/* Callbacks can only send commands, which are not processed until
+		after this loop, so the list cannot change under it. */
+		pxNextItem = pxItem->pxNext;
+		pxTimer = ( xTIMER * ) listGET_LIST_ITEM_OWNER( pxItem );
 
-		/* If a timer has expired, process it.  Otherwise, block this task
-		until either a timer does expire, or a command is received. */
-		prvProcessTimerOrBlockTask( xNextExpireTime, xListWasEmpty );
+		/* Ticks are counted from the start of the period rather than compared
+		with an expiry time, so the tick count overflowing needs no special
+		handling. */
+		xElapsed = xTimeNow - listGET_LIST_ITEM_VALUE( pxItem );
 
-		/* Empty the command queue. */
-		prvProcessReceivedCommands();
-	}
-}
-/*-----------------------------------------------------------*/
-
-static void prvProcessTimerOrBlockTask( portTickType xNextExpireTime, portBASE_TYPE xListWasEmpty )
-{
-portTickType xTimeNow;
-portBASE_TYPE xTimerListsWereSwitched;
-
-	vTaskSuspendAll();
-	{
-		/* Obtain the time now to make an assessment as to whether the timer
-		has expired or not.  If obtaining the time causes the lists to switch
-		then don't process this timer as any timers that remained in the list
-		when the lists were switched will have been processed within the
-		prvSampelTimeNow() function. */
-		xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
-		if( xTimerListsWereSwitched == pdFALSE )
+		while( xElapsed >= pxTimer->xTimerPeriodInTicks )
 		{
-			/* The tick count has not overflowed, has the timer expired? */
-			if( ( xListWasEmpty == pdFALSE ) && ( xNextExpireTime <= xTimeNow ) )
+			traceTIMER_EXPIRED( pxTimer );
+
+			if( pxTimer->uxAutoReload == ( unsigned portBASE_TYPE ) pdTRUE )
 			{
-				( void ) xTaskResumeAll();
-				prvProcessExpiredTimer( xNextExpireTime, xTimeNow );
+				/* The next period starts at this expiry time, not now, so an
+				auto reload timer does not drift however late it is run.  If
+				it is more than a whole period late it is run once for each
+				period missed. */
+				listSET_LIST_ITEM_VALUE( pxItem, listGET_LIST_ITEM_VALUE( pxItem ) + pxTimer->xTimerPeriodInTicks );
+				xElapsed -= pxTimer->xTimerPeriodInTicks;
+				prvRunTimerCallback( pxTimer, xElapsed );
 			}
 			else
 			{
-				/* The tick count has not overflowed, and the next expire
-				time has not been reached yet.  This task should therefore
-				block to wait for the next expire time or a command to be
-				received - whichever comes first.  The following line cannot
-				be reached unless xNextExpireTime > xTimeNow, except in the
-				case when the current timer list is empty. */
-				vQueueWaitForMessageRestricted( xTimerQueue, ( xNextExpireTime - xTimeNow ) );
-
-				if( xTaskResumeAll() == pdFALSE )
-				{
-					/* Yield to wait for either a command to arrive, or the block time
-					to expire.  If a command arrived between the critical section being
-					exited and this yield then the yield will not cause the task
-					to block. */
-					portYIELD_WITHIN_API();
-				}
+				( void ) uxListRemove( pxItem );
+				prvRunTimerCallback( pxTimer, xElapsed - pxTimer->xTimerPeriodInTicks );
+				break;
 			}
 		}
-		else
+
+		if( listIS_CONTAINED_WITHIN( &xActiveTimerList, pxItem ) != pdFALSE )
 		{
-			( void ) xTaskResumeAll();
+			/* The latest the timer can be run is its expiry time plus its
+			slack, limited to what a tick count can hold. */
+			xLimit = pxTimer->xTimerPeriodInTicks + pxTimer->xTimerSlackInTicks;
+			if( xLimit < pxTimer->xTimerPeriodInTicks )
+			{
+				xLimit = portMAX_DELAY;
+			}
+
+			if( ( xLimit - xElapsed ) < xTicksToWait )
+			{
+				xTicksToWait = xLimit - xElapsed;
+			}
 		}
 	}
+
+	return xTicksToWait;
 }
 /*-----------------------------------------------------------*/
 
-static portTickType prvGetNextExpireTime( portBASE_TYPE *pxListWasEmpty )
+static void prvRunTimerCallback( xTIMER *pxTimer, portTickType xLateness )
 {
-portTickType xNextExpireTime;
-
-	/* Timers are listed in expiry time order, with the head of the list
-	referencing the task that will expire first.  Obtain the time at which
-	the timer with the nearest expiry time will expire.  If there are no
-	active timers then just set the next expire time to 0.  That will cause
-	this task to unblock when the tick count overflows, at which point the
-	timer lists will be switched and the next expiry time can be
-	re-assessed.  */
-	*pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
-	if( *pxListWasEmpty == pdFALSE )
+	#if ( configUSE_TIMER_STATS == 1 )
 	{
-		xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+	unsigned long ulStart, ulRunTime;
+
+		ulStart = portGET_RUN_TIME_COUNTER_VALUE();
+		pxTimer->pxCallbackFunction( ( xTimerHandle ) pxTimer );
+		ulRunTime = portGET_RUN_TIME_COUNTER_VALUE() - ulStart;
+
+		/* vTimerGetStats() can be called from any task. */
+		taskENTER_CRITICAL();
+		{
+			pxTimer->xStats.ulCallbacks++;
+			pxTimer->xStats.ulTotalRunTime += ulRunTime;
+
+			if( ulRunTime > pxTimer->xStats.ulMaxRunTime )
+			{
+				pxTimer->xStats.ulMaxRunTime = ulRunTime;
+			}
+
+			if( xLateness > pxTimer->xStats.xMaxLateness )
+			{
+				pxTimer->xStats.xMaxLateness = xLateness;
+			}
+		}
+		taskEXIT_CRITICAL();
 	}
-	else
+	#else
 	{
-		/* Ensure the task unblocks when the tick count rolls over. */
-		xNextExpireTime = ( portTickType ) 0U;
+		( void ) xLateness;
+		pxTimer->pxCallbackFunction( ( xTimerHandle ) pxTimer );
 	}
-
-	return xNextExpireTime;
+	#endif /* configUSE_TIMER_STATS */
 }
 /*-----------------------------------------------------------*/
 
-static portTickType prvSampleTimeNow( portBASE_TYPE *pxTimerListsWereSwitched )
+static void prvTimerTask( void *pvParameters )
 {
-portTickType xTimeNow;
-PRIVILEGED_DATA static portTickType xLastTime = ( portTickType ) 0U; /*lint !e956 Variable is only accessible to one task. */
+portTickType xTicksToWait;
 
-	xTimeNow = xTaskGetTickCount();
+	/* Just to avoid compiler warnings. */
+	( void ) pvParameters;
 
-	if( xTimeNow < xLastTime )
-	{
-		prvSwitchTimerLists( xLastTime );
-		*pxTimerListsWereSwitched = pdTRUE;
-	}
-	else
+	for( ;; )
 	{
-		*pxTimerListsWereSwitched = pdFALSE;
-	}
+		/* Run the callbacks of the timers that have expired, and find out
+		how long until the next one must be run. */
+		xLastTime = xTaskGetTickCount();
+		xTicksToWait = prvProcessExpiredTimers( xLastTime );
 
-	xLastTime = xTimeNow;
+		/* Block this task until then, or until a command is received. */
+		prvWaitForTimerOrCommand( xTicksToWait );
 
-	return xTimeNow;
+		/* Empty the command queue. */
+		prvProcessReceivedCommands();
+	}
 }
 /*-----------------------------------------------------------*/
 
-static portBASE_TYPE prvInsertTimerInActiveList( xTIMER *pxTimer, portTickType xNextExpiryTime, portTickType xTimeNow, portTickType xCommandTime )
+static void prvWaitForTimerOrCommand( portTickType xTicksToWait )
 {
-portBASE_TYPE xProcessTimerNow = pdFALSE;
-
-	listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
-	listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+portTickType xTicksPassed;
 
-	if( xNextExpiryTime <= xTimeNow )
-	{
-		/* Has the expiry time elapsed between the command to start/reset a
-		timer was issued, and the time the command was processed? */
-		if( ( xTimeNow - xCommandTime ) >= pxTimer->xTimerPeriodInTicks )
-		{
-			/* The time between a command being issued and the command being
-			processed actually exceeds the timers period.  */
-			xProcessTimerNow = pdTRUE;
-		}
-		else
-		{
-			vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
-		}
-	}
-	else
+	vTaskSuspendAll();
 	{
-		if( ( xTimeNow < xCommandTime ) && ( xNextExpiryTime >= xCommandTime ) )
+		/* The callbacks may have taken some ticks.  With no timers active
+		xTicksToWait is portMAX_DELAY, and the task just wakes once in a while
+		to look again. */
+		xTicksPassed = xTaskGetTickCount() - xLastTime;
+
+		if( xTicksPassed < xTicksToWait )
 		{
-			/* If, since the command was issued, the tick count has overflowed
-			but the expiry time has not, then the timer must have already passed
-			its expiry time and should be processed immediately. */
-			xProcessTimerNow = pdTRUE;
+			vQueueWaitForMessageRestricted( xTimerQueue, ( xTicksToWait - xTicksPassed ) );
+
+			if( xTaskResumeAll() == pdFALSE )
+			{
+				/* Yield to wait for either a command to arrive, or the block time
+				to expire.  If a command arrived between the critical section being
+				exited and this yield then the yield will not cause the task
+				to block. */
+				portYIELD_WITHIN_API();
+			}
 		}
 		else
 		{
-			vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+			( void ) xTaskResumeAll();
 		}
 	}
+}
+/*-----------------------------------------------------------*/
 
-	return xProcessTimerNow;
+static void prvInsertTimerInActiveList( xTIMER *pxTimer, portTickType xPeriodStart )
+{
+	/* A timer that expired while its start command was waiting in the queue
+	is run the next time the active timers are looked at, which is as soon as
+	the commands have been processed. */
+	listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xPeriodStart );
+	vListInsertEnd( &xActiveTimerList, &( pxTimer->xTimerListItem ) );
 }
 /*-----------------------------------------------------------*/
 
@@ -517,46 +494,46 @@ static void	prvProcessReceivedCommands( void )
 {
 xTIMER_MESSAGE xMessage;
 xTIMER *pxTimer;
-portBASE_TYPE xTimerListsWereSwitched, xResult;
-portTickType xTimeNow;
 
 	while( xQueueReceive( xTimerQueue, &xMessage, tmrNO_DELAY ) != pdFAIL ) /*lint !e603 xMessage does not have to be initialised as it is passed out, not in, and it is not used unless xQueueReceive() returns pdTRUE. */
 	{
 		pxTimer = xMessage.pxTimer;
 
+		traceTIMER_COMMAND_RECEIVED( pxTimer, xMessage.xMessageID, xMessage.xMessageValue );
+
+		if( xMessage.xMessageID == tmrCOMMAND_CHANGE_SLACK )
+		{
+			/* Applies from the next time the active timers are looked at,
+			and leaves the timer running or not as it was. */
+			pxTimer->xTimerSlackInTicks = xMessage.xMessageValue;
+			continue;
+		}
+
+		#if ( configUSE_EVENT_GROUPS == 1 )
+		{
+			if( xMessage.xMessageID == tmrCOMMAND_SET_EVENT_BITS )
+			{
+				/* Bits set by an interrupt.  Setting them can unblock any
+				number of tasks, so is done here rather than in the interrupt.
+				The message carries an event group rather than a timer. */
+				vEventGroupSetBitsCallback( ( void * ) pxTimer, ( xEventBits ) xMessage.xMessageValue );
+				continue;
+			}
+		}
+		#endif /* configUSE_EVENT_GROUPS */
+
 		if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE )
 		{
 			/* The timer is in a list, remove it. */
 			( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
 		}
 
-		traceTIMER_COMMAND_RECEIVED( pxTimer, xMessage.xMessageID, xMessage.xMessageValue );
-
-		/* In this case the xTimerListsWereSwitched parameter is not used, but 
-		it must be present in the function call.  prvSampleTimeNow() must be 
-		called after the message is received from xTimerQueue so there is no 
-		possibility of a higher priority task adding a message to the message
-		queue with a time that is ahead of the timer daemon task (because it
-		pre-empted the timer daemon task after the xTimeNow value was set). */
-		xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
-
 		switch( xMessage.xMessageID )
 		{
 			case tmrCOMMAND_START :
-				/* Start or restart a timer. */
-				if( prvInsertTimerInActiveList( pxTimer,  xMessage.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, xMessage.xMessageValue ) == pdTRUE )
-				{
-					/* The timer expired before it was added to the active timer
-					list.  Process it now. */
-					pxTimer->pxCallbackFunction( ( xTimerHandle ) pxTimer );
-
-					if( pxTimer->uxAutoReload == ( unsigned portBASE_TYPE ) pdTRUE )
-					{
-						xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START, xMessage.xMessageValue + pxTimer->xTimerPeriodInTicks, NULL, tmrNO_DELAY );
-						configASSERT( xResult );
-						( void ) xResult;
-					}
-				}
+				/* Start or restart a timer.  The period starts at the time
+				the command was sent. */
+				prvInsertTimerInActiveList( pxTimer, xMessage.xMessageValue );
 				break;
 
 			case tmrCOMMAND_STOP :
@@ -567,7 +544,7 @@ portTickType xTimeNow;
 			case tmrCOMMAND_CHANGE_PERIOD :
 				pxTimer->xTimerPeriodInTicks = xMessage.xMessageValue;
 				configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
-				( void ) prvInsertTimerInActiveList( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
+				prvInsertTimerInActiveList( pxTimer, xTaskGetTickCount() );
 				break;
 
 			case tmrCOMMAND_DELETE :
@@ -584,63 +561,6 @@ portTickType xTimeNow;
 }
 /*-----------------------------------------------------------*/
 
-static void prvSwitchTimerLists( portTickType xLastTime )
-{
-portTickType xNextExpireTime, xReloadTime;
-xList *pxTemp;
-xTIMER *pxTimer;
-portBASE_TYPE xResult;
-
-	/* Remove compiler warnings if configASSERT() is not defined. */
-	( void ) xLastTime;
-
-	/* The tick count has overflowed.  The timer lists must be switched.
-	If there are any timers still referenced from the current timer list
-	then they must have expired and should be processed before the lists
-	are switched. */
-	while( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE )
-	{
-		xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
-
-		/* Remove the timer from the list. */
-		pxTimer = ( xTIMER * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList );
-		( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
-
-		/* Execute its callback, then send a command to restart the timer if
-		it is an auto-reload timer.  It cannot be restarted here as the lists
-		have not yet been switched. */
-		pxTimer->pxCallbackFunction( ( xTimerHandle ) pxTimer );
-
-		if( pxTimer->uxAutoReload == ( unsigned portBASE_TYPE ) pdTRUE )
-		{
-			/* Calculate the reload value, and if the reload value results in
-			the timer going into the same timer list then it has already expired
-			and the timer should be re-inserted into the current list so it is
-			processed again within this loop.  Otherwise a command should be sent
-			to restart the timer to ensure it is only inserted into a list after
-			the lists have been swapped. */
-			xReloadTime = ( xNextExpireTime + pxTimer->xTimerPeriodInTicks );
-			if( xReloadTime > xNextExpireTime )
-			{
-				listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xReloadTime );
-				listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
-				vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
-			}
-			else
-			{
-				xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START, xNextExpireTime, NULL, tmrNO_DELAY );
-				configASSERT( xResult );
-				( void ) xResult;
-			}
-		}
-	}
-
-	pxTemp = pxCurrentTimerList;
-	pxCurrentTimerList = pxOverflowTimerList;
-	pxOverflowTimerList = pxTemp;
-}
-/*-----------------------------------------------------------*/
-
 static void prvCheckForValidListAndQueue( void )
 {
 	/* Check that the list from which active timers are referenced, and the
@@ -650,10 +570,7 @@ static void prvCheckForValidListAndQueue( void )
 	{
 		if( xTimerQueue == NULL )
 		{
-			vListInitialise( &xActiveTimerList1 );
-			vListInitialise( &xActiveTimerList2 );
-			pxCurrentTimerList = &xActiveTimerList1;
-			pxOverflowTimerList = &xActiveTimerList2;
+			vListInitialise( &xActiveTimerList );
 			xTimerQueue = xQueueCreate( ( unsigned portBASE_TYPE ) configTIMER_QUEUE_LENGTH, sizeof( xTIMER_MESSAGE ) );
 		}
 	}
@@ -688,6 +605,32 @@ xTIMER *pxTimer = ( xTIMER * ) xTimer;
 }
 /*-----------------------------------------------------------*/
 
+const signed char *pcTimerGetTimerName( xTimerHandle xTimer )
+{
+xTIMER *pxTimer = ( xTIMER * ) xTimer;
+
+	return pxTimer->pcTimerName;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIMER_STATS == 1 )
+
+	void vTimerGetStats( xTimerHandle xTimer, xTimerStatsType *pxStats )
+	{
+	xTIMER *pxTimer = ( xTIMER * ) xTimer;
+
+		/* The timer service task updates the statistics in a critical
+		section too, so the copy is consistent. */
+		taskENTER_CRITICAL();
+		{
+			*pxStats = pxTimer->xStats;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_TIMER_STATS */
+/*-----------------------------------------------------------*/
+
 /* This entire source file will be skipped if the application is not configured
 to include software timer functionality.  If you want to include software timer
 functionality then ensure configUSE_TIMERS is set to 1 in FreeRTOSConfig.h. */
@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+# ----------------------------------------------------------------------------
+# Decode the heap report printed by xSerialxPrintHeapStats().
+#
+# The report is a "Heap free ... min ... largest ... blocks ... frag ..%" line,
+# followed (with configUSE_HEAP_TRACE set to 1) by the recent pvPortMalloc()
+# and vPortFree() calls:
+#
+#     SEQ E   ADDR  SIZE CALLER  TICK
+#    1203 M 0x0a1c    34 0x1b2e   512
+#
+# Capture the serial output to a file (any number of reports, other output is
+# ignored), then:
+#
+#   heap_decode.py capture.txt --elf firmware.elf
+#
+# prints each event with the function and source line of its caller, then a
+# summary of the blocks still allocated, the failed allocations with the heap
+# state in the report that showed them, and the allocations per caller.  Events repeated in
+# consecutive reports are shown once; a jump in SEQ means events were lost
+# because the trace ring overflowed between reports.
+#
+# On the AVR the caller is a word address.  It is doubled when the elf is an
+# AVR elf, so it matches the map file and avr-objdump listings.
+# ----------------------------------------------------------------------------
+
+import argparse
+import re
+import struct
+import subprocess
+import sys
+from collections import OrderedDict
+
+STATS = re.compile(r'Heap free (\d+) min (\d+) largest (\d+) blocks (\d+) frag (\d+)%')
+EVENT = re.compile(r'^\s*(\d+) ([MFX]) 0x([0-9a-fA-F]+)\s+(\d+) 0x([0-9a-fA-F]+)\s+(\d+)\s*$')
+
+EM_AVR = 83
+
+
+def elf_is_avr(path):
+    with open(path, 'rb') as f:
+        header = f.read(20)
+    if header[:4] != b'\x7fELF':
+        sys.exit('%s is not an elf file' % path)
+    endian = '<' if header[5] == 1 else '>'
+    return struct.unpack(endian + 'H', header[18:20])[0] == EM_AVR
+
+
+def resolve(callers, elf, addr2line, word_addresses):
+    """Map each caller address to 'function file:line' with addr2line."""
+    names = {}
+    if not elf or not callers:
+        return names
+    # Step back from the return address into the call instruction.
+    query = [(c * 2 - 2) if word_addresses else (c - 1) for c in callers]
+    try:
+        out = subprocess.run([addr2line, '-f', '-s', '-e', elf] + ['0x%x' % q for q in query],
+                             capture_output=True, text=True, check=True).stdout.split('\n')
+    except (OSError, subprocess.CalledProcessError) as e:
+        sys.stderr.write('%s failed: %s\n' % (addr2line, e))
+        return names
+    for i, c in enumerate(callers):
+        names[c] = '%s %s' % (out[2 * i], out[2 * i + 1])
+    return names
+
+
+def main():
+    ap = argparse.ArgumentParser(description='Decode xSerialxPrintHeapStats() reports.')
+    ap.add_argument('capture', nargs='?', type=argparse.FileType('r'), default=sys.stdin,
+                    help='captured serial output (default stdin)')
+    ap.add_argument('--elf', help='the firmware, to name the callers')
+    ap.add_argument('--addr2line', default='avr-addr2line', help='addr2line to use (default avr-addr2line)')
+    args = ap.parse_args()
+
+    word_addresses = elf_is_avr(args.elf) if args.elf else True
+
+    stats = None
+    events = []         # (seq, event, addr, size, caller, tick, stats of its report)
+    last_seq = None
+    lost = 0
+
+    for line in args.capture:
+        m = STATS.search(line)
+        if m:
+            stats = tuple(int(v) for v in m.groups())
+            continue
+        m = EVENT.match(line)
+        if not m:
+            continue
+        seq = int(m.group(1))
+        if last_seq is not None:
+            step = (seq - last_seq) & 0xffff
+            if step == 0 or step >= 0x8000:
+                continue        # already seen in an earlier report
+            lost += step - 1
+        last_seq = seq
+        events.append((seq, m.group(2), int(m.group(3), 16), int(m.group(4)),
+                       int(m.group(5), 16), int(m.group(6)), stats))
+
+    if stats is None and not events:
+        sys.exit('no heap report found')
+
+    names = resolve(sorted(set(e[4] for e in events)), args.elf, args.addr2line, word_addresses)
+
+    def caller(c):
+        return names.get(c, '0x%04x' % c)
+
+    if stats:
+        print('Last report: free %u, minimum ever free %u, largest block %u, %u free blocks, %u%% fragmented'
+              % stats)
+
+    print('\n  SEQ E   ADDR  SIZE  TICK  CALLER')
+    for seq, ev, addr, size, c, tick, _ in events:
+        print('%5u %s 0x%04x %5u %5u  %s' % (seq, ev, addr, size, tick, caller(c)))
+    if lost:
+        print('(%u events were overwritten between reports)' % lost)
+
+    # Blocks allocated within the trace and not freed within it.
+    live = OrderedDict()
+    for seq, ev, addr, size, c, tick, _ in events:
+        if ev == 'M':
+            live[addr] = (seq, size, c)
+        elif ev == 'F':
+            live.pop(addr, None)
+    if live:
+        print('\nStill allocated at the end of the trace:')
+        for addr, (seq, size, c) in live.items():
+            print('  0x%04x %5u bytes, seq %u, from %s' % (addr, size, seq, caller(c)))
+
+    failed = [e for e in events if e[1] == 'X']
+    if failed:
+        print('\nFailed allocations:')
+        for seq, ev, addr, size, c, tick, st in failed:
+            where = ''
+            if st:
+                where = ' (heap when reported: free %u, largest block %u)' % (st[0], st[2])
+            print('  %5u bytes, seq %u, from %s%s' % (size, seq, caller(c), where))
+
+    per_caller = {}
+    for seq, ev, addr, size, c, tick, _ in events:
+        if ev != 'F':
+            n, total = per_caller.get(c, (0, 0))
+            per_caller[c] = (n + 1, total + size)
+    if per_caller:
+        print('\nAllocations by caller:')
+        for c, (n, total) in sorted(per_caller.items(), key=lambda kv: -kv[1][1]):
+            print('  %4u calls %6u bytes  %s' % (n, total, caller(c)))
+
+
+if __name__ == '__main__':
+    main()
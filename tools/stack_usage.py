@@ -0,0 +1,406 @@
+#!/usr/bin/env python3
+# ----------------------------------------------------------------------------
+# Work out the worst case stack each task can use, from the compiler's stack
+# frame sizes and the call graph of the firmware, and set it beside the size
+# each task was given and (optionally) the most it has been seen to use.
+#
+# Build with -fstack-usage added to the compiler flags, so avr-gcc writes a
+# .su file of frame sizes next to each object file, then:
+#
+#   stack_usage.py firmware.elf Release/ --src .. --src ../freeRTOS750
+#   stack_usage.py firmware.elf Release/ --src .. --report capture.txt
+#   stack_usage.py firmware.elf Release/ --src .. --path TaskBlinkGreenLED
+#
+# The elf is disassembled with avr-objdump to find the calls.  --src is
+# searched for xTaskCreate() calls, for the task functions, their names and
+# stack sizes, for xTimerCreate() calls, whose callbacks run on the timer
+# service task, and for xCoRoutineCreate() calls, whose functions run on the
+# idle task.  --report is a capture of xSerialxPrintStackReport() output.
+#
+# For each task the worst case is the deepest call path from the task
+# function, with a return address for each call, plus the deepest interrupt
+# (interrupts run on the stack of the task they interrupt, and do not nest),
+# plus the three bytes pxPortInitialiseStack() puts at the top.  vPortYield()
+# and vPortYieldFromTick() push the context, 33 registers (35 on the
+# ATmega2560) on top of the path that called them.
+#
+# The analysis cannot see:
+#  - calls through function pointers, other than the timer callbacks.  They
+#    are listed for each task; add them with --call CALLER=CALLEE.
+#  - frames of functions without a .su file (avr-libc, assembler).  These are
+#    counted as 0 and listed; give sizes with --frame NAME=BYTES.
+#  - recursion, and frames marked "dynamic" (alloca, variable length arrays).
+#    Results that depend on them are marked.
+# ----------------------------------------------------------------------------
+
+import argparse
+import os
+import re
+import struct
+import subprocess
+import sys
+
+EM_AVR = 83
+EF_AVR_MACH = 0x7f
+AVR6 = 6                                # 3 byte program counter, EIND and RAMPZ
+
+SU_LINE = re.compile(r'^(.*?):\d+:\d+:(.+)\t(\d+)\t(\S+)')
+FUNCTION = re.compile(r'^([0-9a-f]+) <(.+)>:$')
+INSTRUCTION = re.compile(r'^\s+[0-9a-f]+:\t(?:[0-9a-f]{2} )+\s*\t(\w+)\s*(.*)$')
+TARGET = re.compile(r'<([^>+]+)(\+0x[0-9a-f]+)?>')
+VECTOR = re.compile(r'^__vector_\d+$')
+REPORT = re.compile(r'^Stack (.+?)\s+(\d+)\s+(\d+)\s+(\d+)\s*$')
+
+CALLS = ('call', 'rcall')
+JUMPS = ('jmp', 'rjmp')
+INDIRECT = ('icall', 'eicall', 'ijmp', 'eijmp')
+
+# Naked functions that push the whole context with portSAVE_CONTEXT().
+CONTEXT_SAVERS = ('vPortYield', 'vPortYieldFromTick')
+
+# Bytes above the context that pxPortInitialiseStack() puts on a new stack.
+STACK_TOP_MARKERS = 3
+
+# Kernel tasks, and the FreeRTOSConfig.h names of their stack sizes.
+KERNEL_TASKS = [('IDLE', 'prvIdleTask', 'configMINIMAL_STACK_SIZE'),
+                ('Tmr Svc', 'prvTimerTask', 'configTIMER_TASK_STACK_DEPTH')]
+
+
+def elf_mach(path):
+    """The AVR architecture number of an elf, or None if it is not an AVR elf."""
+    with open(path, 'rb') as f:
+        header = f.read(52)
+    if header[:4] != b'\x7fELF':
+        sys.exit('%s is not an elf file' % path)
+    endian = '<' if header[5] == 1 else '>'
+    if struct.unpack(endian + 'H', header[18:20])[0] != EM_AVR:
+        return None
+    return struct.unpack(endian + 'I', header[36:40])[0] & EF_AVR_MACH
+
+
+def read_stack_usage(dirs):
+    """Frame size, dynamic flag and source file of each function, from the .su files."""
+    frames = {}
+    for top in dirs:
+        for root, _, files in os.walk(top):
+            for name in files:
+                if not name.endswith('.su'):
+                    continue
+                with open(os.path.join(root, name)) as f:
+                    for line in f:
+                        m = SU_LINE.match(line)
+                        if not m:
+                            continue
+                        source, function, size, kind = m.group(1), m.group(2), int(m.group(3)), m.group(4)
+                        # Static functions of the same name in two files: keep the larger.
+                        if function in frames and frames[function][0] >= size:
+                            continue
+                        frames[function] = (size, kind != 'static', os.path.basename(source))
+    return frames
+
+
+def read_call_graph(lines):
+    """Direct callees and indirect call flag of each function in an objdump -d listing."""
+    calls = {}
+    indirect = set()
+    function = None
+    for line in lines:
+        m = FUNCTION.match(line)
+        if m:
+            function = m.group(2)
+            calls.setdefault(function, set())
+            continue
+        m = INSTRUCTION.match(line)
+        if not m or function is None:
+            continue
+        op, operands = m.group(1), m.group(2)
+        if op in INDIRECT:
+            indirect.add(function)
+            continue
+        if op not in CALLS and op not in JUMPS:
+            continue
+        t = TARGET.search(operands)
+        # "rcall .+0" reserves stack, and jumps within a function are not calls.
+        if not t or t.group(2) or (op in JUMPS and t.group(1) == function):
+            continue
+        calls[function].add((t.group(1), op in CALLS))
+    return calls, indirect
+
+
+def strip_comments(text):
+    text = re.sub(r'/\*.*?\*/', ' ', text, flags=re.S)
+    return re.sub(r'//[^\n]*', '', text)
+
+
+def split_arguments(text, start):
+    """The comma separated arguments of the call whose '(' is at text[start]."""
+    depth, args, current = 0, [], ''
+    for i in range(start, len(text)):
+        c = text[i]
+        if c == '(':
+            depth += 1
+            if depth == 1:
+                continue
+        elif c == ')':
+            depth -= 1
+            if depth == 0:
+                args.append(current.strip())
+                return args
+        elif c == ',' and depth == 1:
+            args.append(current.strip())
+            current = ''
+            continue
+        current += c
+    return args
+
+
+def read_sources(dirs):
+    """Tasks (name, function, stack size expression), timer callbacks and co-routines created in the sources."""
+    tasks, callbacks, coroutines = [], set(), set()
+    for top in dirs:
+        for root, _, files in os.walk(top):
+            for name in files:
+                if not name.endswith(('.c', '.cpp')):
+                    continue
+                with open(os.path.join(root, name), errors='replace') as f:
+                    text = strip_comments(f.read())
+                for m in re.finditer(r'\bxTaskCreate\s*\(', text):
+                    args = split_arguments(text, m.end() - 1)
+                    if len(args) < 3 or not re.match(r'^\w+$', args[0]):
+                        continue
+                    n = re.search(r'"([^"]*)"', args[1])
+                    tasks.append((n.group(1) if n else args[0], args[0], args[2]))
+                for m in re.finditer(r'\bxTimerCreate\s*\(', text):
+                    args = split_arguments(text, m.end() - 1)
+                    if len(args) == 5 and re.match(r'^\w+$', args[4]):
+                        callbacks.add(args[4])
+                for m in re.finditer(r'\bxCoRoutineCreate\s*\(', text):
+                    args = split_arguments(text, m.end() - 1)
+                    if len(args) == 3 and re.match(r'^\w+$', args[0]):
+                        coroutines.add(args[0])
+    return tasks, callbacks, coroutines
+
+
+def evaluate(expression, defines):
+    """A stack size expression as a number, or None."""
+    for _ in range(4):
+        expression = re.sub(r'\b[A-Za-z_]\w*\b', lambda m: defines.get(m.group(0), m.group(0)), expression)
+        expression = re.sub(r'\(\s*(?:unsigned\s+)?(?:u?int\d+_t|short|char|portBASE_TYPE)\s*\)', '', expression)
+    if not re.match(r'^[\d\s()+\-*/]+$', expression):
+        return None
+    try:
+        return int(eval(expression))
+    except (SyntaxError, ZeroDivisionError):
+        return None
+
+
+def read_defines(dirs):
+    """Simple #defines, with those in FreeRTOSConfig.h taking precedence."""
+    defines = {}
+    paths = []
+    for top in dirs:
+        for root, _, files in os.walk(top):
+            paths += [os.path.join(root, n) for n in files if n.endswith(('.h', '.c'))]
+    paths.sort(key=lambda p: os.path.basename(p) != 'FreeRTOSConfig.h')
+    for path in paths:
+        with open(path, errors='replace') as f:
+            for line in f:
+                m = re.match(r'^\s*#define\s+(\w+)\s+(.+)$', line.split('//')[0].rstrip())
+                if m and m.group(1) not in defines:
+                    defines[m.group(1)] = m.group(2)
+    return defines
+
+
+def read_report(path):
+    """Size, used and free of each stack in an xSerialxPrintStackReport() capture (the last report wins)."""
+    measured = {}
+    with open(path, errors='replace') as f:
+        for line in f:
+            m = REPORT.match(line.rstrip('\r\n'))
+            if m and m.group(1) != 'NAME':
+                measured[m.group(1).strip()] = (int(m.group(2)), int(m.group(3)), int(m.group(4)))
+    return measured
+
+
+class Analysis:
+    def __init__(self, frames, calls, indirect, extra_calls, pc_bytes, context_bytes):
+        self.frames = frames
+        self.calls = calls
+        self.indirect = indirect
+        self.extra_calls = extra_calls
+        self.pc_bytes = pc_bytes
+        self.context_bytes = context_bytes
+        self.memo = {}
+
+    def frame(self, function):
+        if function in CONTEXT_SAVERS:
+            return self.context_bytes, False
+        if function in self.frames:
+            return self.frames[function][0], self.frames[function][1]
+        return 0, False
+
+    def callees(self, function):
+        for callee, pushes in sorted(self.calls.get(function, ())):
+            yield callee, pushes
+        for callee in sorted(self.extra_calls.get(function, ())):
+            yield callee, True
+
+    def worst(self, function, active=()):
+        """(bytes, path, notes) of the deepest call path from function."""
+        if function in self.memo:
+            return self.memo[function]
+        size, dynamic = self.frame(function)
+        notes = set()
+        if dynamic:
+            notes.add('dynamic frame: %s' % function)
+        if function not in self.frames and function not in CONTEXT_SAVERS:
+            notes.add('no frame size: %s' % function)
+        if function in self.indirect and function not in self.extra_calls:
+            notes.add('indirect call: %s' % function)
+        best, best_path = 0, []
+        for callee, pushes in self.callees(function):
+            if callee in active or callee == function:
+                notes.add('recursion: %s' % callee)
+                continue
+            depth, path, callee_notes = self.worst(callee, active + (function,))
+            notes |= callee_notes
+            depth += self.pc_bytes if pushes else 0
+            if depth > best:
+                best, best_path = depth, path
+        result = (size + best, [function] + best_path, notes)
+        if not active or not any(n.startswith('recursion') for n in notes):
+            self.memo[function] = result
+        return result
+
+
+def main():
+    ap = argparse.ArgumentParser(description='Worst case task stack use, from -fstack-usage and the call graph.')
+    ap.add_argument('elf', help='the firmware')
+    ap.add_argument('su', nargs='+', help='directories to search for .su files')
+    ap.add_argument('--src', action='append', default=[], help='source directory to search for xTaskCreate() (repeatable)')
+    ap.add_argument('--report', help='captured xSerialxPrintStackReport() output')
+    ap.add_argument('--call', action='append', default=[], metavar='CALLER=CALLEE[,CALLEE]',
+                    help='add calls made through function pointers')
+    ap.add_argument('--frame', action='append', default=[], metavar='NAME=BYTES',
+                    help='frame size of a function without a .su entry')
+    ap.add_argument('--task', action='append', default=[], metavar='NAME=FUNCTION[:SIZE]',
+                    help='a task not found by --src')
+    ap.add_argument('--path', action='append', default=[], metavar='FUNCTION',
+                    help='print the deepest call path from a task or function')
+    ap.add_argument('--objdump', default='avr-objdump', help='objdump to use (default avr-objdump)')
+    ap.add_argument('--disassembly', help='use this objdump -d listing rather than running objdump')
+    args = ap.parse_args()
+
+    mach = elf_mach(args.elf)
+    pc_bytes = 3 if mach == AVR6 else 2
+    context_bytes = 35 if mach == AVR6 else 33
+
+    frames = read_stack_usage(args.su)
+    if not frames:
+        sys.exit('no .su files found: build with -fstack-usage')
+    for f in args.frame:
+        name, size = f.split('=')
+        frames[name] = (int(size), False, '')
+
+    if args.disassembly:
+        with open(args.disassembly) as f:
+            listing = f.read().split('\n')
+    else:
+        try:
+            listing = subprocess.run([args.objdump, '-d', args.elf], capture_output=True,
+                                     text=True, check=True).stdout.split('\n')
+        except (OSError, subprocess.CalledProcessError) as e:
+            sys.exit('%s failed: %s' % (args.objdump, e))
+    calls, indirect = read_call_graph(listing)
+
+    tasks, callbacks, coroutines = read_sources(args.src)
+    defines = read_defines(args.src)
+
+    # The timer callbacks are called through a pointer in timers.c, and the
+    # co-routine functions through a pointer in croutine.c.
+    extra_calls = {}
+    for function in indirect:
+        if callbacks and function in frames and frames[function][2] == 'timers.c':
+            extra_calls.setdefault(function, set()).update(callbacks)
+        if coroutines and function in frames and frames[function][2] == 'croutine.c':
+            extra_calls.setdefault(function, set()).update(coroutines)
+    for c in args.call:
+        caller, callees = c.split('=')
+        extra_calls.setdefault(caller, set()).update(callees.split(','))
+
+    for name, function, size in KERNEL_TASKS:
+        if function in calls:
+            if function == 'prvIdleTask' and defines.get('configUSE_CO_ROUTINES', '0').strip('() ') == '1':
+                size = 'configCO_ROUTINE_STACK_DEPTH'
+            tasks.append((name, function, size))
+    for t in args.task:
+        name, rest = t.split('=')
+        function, _, size = rest.partition(':')
+        tasks.append((name, function, size or '?'))
+
+    analysis = Analysis(frames, calls, indirect, extra_calls, pc_bytes, context_bytes)
+
+    # Interrupts do not nest, so a task needs room for the deepest one.
+    vectors = sorted(f for f in calls if VECTOR.match(f))
+    print('Interrupts (return address included):')
+    isr_worst, isr_notes = 0, set()
+    for v in vectors:
+        depth, path, notes = analysis.worst(v)
+        depth += pc_bytes
+        isr_notes |= notes
+        isr_worst = max(isr_worst, depth)
+        print('  %-14s %5u  %s' % (v, depth, ' > '.join(path[1:4]) + (' ...' if len(path) > 4 else '')))
+
+    measured = read_report(args.report) if args.report else {}
+
+    print('\nTasks (worst case = deepest path + deepest interrupt %u + %u top bytes):'
+          % (isr_worst, STACK_TOP_MARKERS))
+    print('  %-16s %-24s %5s %6s %6s %6s' % ('NAME', 'FUNCTION', 'SIZE', 'WORST', 'SPARE', 'USED'))
+    seen, marked = set(), False
+    for name, function, size_expression in tasks:
+        if (name, function) in seen:
+            continue
+        seen.add((name, function))
+        if function not in calls:
+            print('  %-16s %-24s (not in the elf)' % (name, function))
+            continue
+        depth, path, notes = analysis.worst(function)
+        worst = depth + isr_worst + STACK_TOP_MARKERS
+        size = evaluate(size_expression, defines)
+        used = ''
+        for report_name, (report_size, report_used, _) in measured.items():
+            if name.startswith(report_name) or report_name.startswith(name):
+                used = '%u' % report_used
+                if size is None:
+                    size = report_size
+        mark = '+' if notes or isr_notes else ''
+        marked = marked or bool(mark)
+        print('  %-16s %-24s %5s %5u%1s %6s %6s' % (name, function,
+              '%u' % size if size is not None else size_expression[:5],
+              worst, mark, '%d' % (size - worst) if size is not None else '', used))
+        for n in sorted(notes):
+            print('  %16s %s' % ('', n))
+
+    if isr_notes:
+        print('\nInterrupt notes:')
+        for n in sorted(isr_notes):
+            print('  %s' % n)
+
+    if '(system)' in measured:
+        size, used, free = measured['(system)']
+        print('\nSystem stack (main() and interrupts before the scheduler started): %u bytes, %u used, %u never used'
+              % (size, used, free))
+
+    if marked:
+        print('\n+ the worst case may be larger: see the notes.')
+
+    for function in args.path:
+        depth, path, notes = analysis.worst(function)
+        print('\nDeepest path from %s, %u bytes:' % (function, depth))
+        for f in path:
+            size, _ = analysis.frame(f)
+            print('  %5u  %s' % (size, f))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,339 @@
+#!/usr/bin/env python3
+# ----------------------------------------------------------------------------
+# Decode the kernel event trace written by xTraceFlushToFile() or
+# usTraceFlushToSerial() (lib_trace/traceRecorder.c).
+#
+# Each flush is a block: a 24 byte "FRTR" header, the task names, then the
+# events oldest first.  Give the decoder the file from the SD card, or a raw
+# capture of the serial port (other output around the blocks is skipped):
+#
+#   trace_decode.py TRACE.BIN
+#   trace_decode.py capture.bin --width 120 --from 2.5 --to 2.6
+#   trace_decode.py capture.bin --events
+#
+# prints the span of the trace and the events lost to a full buffer, then
+#  - a timeline per task: '#' running, '+' ready but not running, ' ' blocked
+#    or suspended, '?' before the first event seen for the task.
+#  - a histogram per task of the time from being made ready to running.
+#  - a histogram per queue of the time from each send from an interrupt to the
+#    next receive from that queue by a task.
+#  - the vTraceUserEvent() codes, with the time from each to the next switch
+#    to a task.  A 0 value with no non zero value before it is counted as
+#    "unpaired": for RAMFS_TRACE_CLIENT_CALL (code 1) that is a Client SS
+#    pulse that ended before the supervisor's interrupt ran.
+#
+# Keep EVENTS in step with the traceEVENT_ codes in include/traceHooks.h.
+# ----------------------------------------------------------------------------
+
+import argparse
+import struct
+import sys
+from collections import OrderedDict
+
+MAGIC = b'FRTR'
+HEADER = struct.Struct('<4sBBBBIIIHH')
+EVENT = struct.Struct('<IHBB')
+FORMAT_VERSION = 1
+
+EVENTS = {
+    0x01: 'SWITCHED_IN',
+    0x02: 'READY',
+    0x03: 'CREATE',
+    0x04: 'DELETE',
+    0x05: 'DELAY',
+    0x06: 'DELAY_UNTIL',
+    0x07: 'SUSPEND',
+    0x08: 'RESUME',
+    0x09: 'RESUME_FROM_ISR',
+    0x0a: 'PRIORITY_SET',
+    0x0b: 'PRIORITY_INHERIT',
+    0x0c: 'PRIORITY_DISINHERIT',
+    0x10: 'QUEUE_CREATE',
+    0x11: 'QUEUE_DELETE',
+    0x12: 'QUEUE_SEND',
+    0x13: 'QUEUE_SEND_FAILED',
+    0x14: 'QUEUE_RECEIVE',
+    0x15: 'QUEUE_RECEIVE_FAILED',
+    0x16: 'QUEUE_PEEK',
+    0x17: 'QUEUE_SEND_FROM_ISR',
+    0x18: 'QUEUE_SEND_FROM_ISR_FAILED',
+    0x19: 'QUEUE_RECEIVE_FROM_ISR',
+    0x1a: 'QUEUE_RECEIVE_FROM_ISR_FAILED',
+    0x1b: 'BLOCKING_ON_QUEUE_SEND',
+    0x1c: 'BLOCKING_ON_QUEUE_RECEIVE',
+    0x20: 'TICK',
+    0x21: 'LOW_POWER_IDLE_BEGIN',
+    0x22: 'LOW_POWER_IDLE_END',
+    0x23: 'TIMER_EXPIRED',
+    0x30: 'USER',
+}
+CODE = {name: code for code, name in EVENTS.items()}
+
+# Events recorded by the running task that mean it is about to block.
+BLOCKING = {CODE['DELAY'], CODE['DELAY_UNTIL'], CODE['BLOCKING_ON_QUEUE_SEND'],
+            CODE['BLOCKING_ON_QUEUE_RECEIVE']}
+
+# Events whose object is a task handle.
+TASK_EVENTS = {CODE['SWITCHED_IN'], CODE['READY'], CODE['CREATE'], CODE['DELETE'],
+               CODE['SUSPEND'], CODE['RESUME'], CODE['RESUME_FROM_ISR'], CODE['PRIORITY_SET'],
+               CODE['PRIORITY_INHERIT'], CODE['PRIORITY_DISINHERIT']}
+
+RANK = {'?': 0, ' ': 1, '+': 2, '#': 3}
+
+QUEUE_TYPES = {0: 'queue', 1: 'mutex', 2: 'counting semaphore', 3: 'binary semaphore',
+               4: 'recursive mutex'}
+
+
+def read_blocks(data):
+    """Yield (header, names, events) for each block, skipping anything between blocks."""
+    pos = 0
+    while True:
+        pos = data.find(MAGIC, pos)
+        if pos < 0 or pos + HEADER.size > len(data):
+            return
+        (magic, version, task_count, name_length, event_size, stamp_hz, tick_hz, lost,
+         event_count, buffer_events) = HEADER.unpack_from(data, pos)
+        if version != FORMAT_VERSION or event_size != EVENT.size or stamp_hz == 0:
+            pos += 1                # "FRTR" in the middle of some other output
+            continue
+        header = {'stamp_hz': stamp_hz, 'tick_hz': tick_hz, 'lost': lost,
+                  'events': event_count, 'buffer': buffer_events}
+        p = pos + HEADER.size
+        names = {}
+        name_size = 2 + name_length
+        for _ in range(task_count):
+            if p + name_size > len(data):
+                break
+            handle = struct.unpack_from('<H', data, p)[0]
+            names[handle] = data[p + 2:p + name_size].split(b'\0')[0].decode('ascii', 'replace')
+            p += name_size
+        events = []
+        for _ in range(event_count):
+            if p + EVENT.size > len(data):
+                header['truncated'] = True
+                break
+            events.append(EVENT.unpack_from(data, p))
+            p += EVENT.size
+        yield header, names, events
+        pos = p
+
+
+class Trace:
+    def __init__(self):
+        self.names = {}
+        self.events = []        # (seconds, event, object, param)
+        self.blocks = 0
+        self.lost = 0
+        self.truncated = 0
+        self.buffer = 0
+        self.stamp_hz = None
+        self._last = None
+        self._base = 0
+
+    def add(self, header, names, events):
+        self.blocks += 1
+        self.lost += header['lost']
+        self.truncated += 1 if header.get('truncated') else 0
+        self.buffer = header['buffer']
+        self.stamp_hz = header['stamp_hz']
+        self.names.update(names)
+        for stamp, obj, event, param in events:
+            # The 32 bit counter wraps; keep the times rising across it.
+            if self._last is not None and stamp < self._last and self._last - stamp > 0x80000000:
+                self._base += 1 << 32
+            self._last = stamp
+            self.events.append(((self._base + stamp) / header['stamp_hz'], event, obj, param))
+
+    def task(self, handle):
+        return self.names.get(handle, '0x%04x' % handle)
+
+
+def fmt_time(seconds):
+    if seconds < 1e-3:
+        return '%.0fus' % (seconds * 1e6)
+    if seconds < 1:
+        return '%.2fms' % (seconds * 1e3)
+    return '%.3fs' % seconds
+
+
+def histogram(title, samples):
+    """Print samples (seconds) in power of two buckets of microseconds."""
+    if not samples:
+        return
+    buckets = OrderedDict()
+    for s in samples:
+        us = int(s * 1e6)
+        b = 1
+        while b <= us:
+            b <<= 1
+        buckets[b] = buckets.get(b, 0) + 1
+    samples = sorted(samples)
+    print('  %s: %u, min %s, median %s, max %s' % (title, len(samples), fmt_time(samples[0]),
+                                                    fmt_time(samples[len(samples) // 2]),
+                                                    fmt_time(samples[-1])))
+    most = max(buckets.values())
+    for b in sorted(buckets):
+        lo = b >> 1
+        bar = '*' * max(1, buckets[b] * 40 // most)
+        print('    %8uus - %-8uus %6u %s' % (lo, b, buckets[b], bar))
+
+
+def timelines(trace, start, end, width):
+    """One row per task: running '#', ready '+', blocked ' ', unknown '?'."""
+    state = {}                  # handle -> '#', '+' or ' '
+    rows = {h: ['?'] * width for h in trace.names}
+    running = None
+    blocking = False            # the running task has recorded a blocking event
+    span = end - start
+
+    def column(t):
+        return min(width - 1, max(0, int((t - start) * width / span)))
+
+    def paint(upto):
+        # Each task keeps its state through the columns not yet painted, up to 'upto'.
+        for h, s in state.items():
+            row = rows.setdefault(h, ['?'] * width)
+            for c in range(paint.col, upto):
+                row[c] = s
+        paint.col = max(paint.col, upto)
+    paint.col = 0
+
+    for t, event, obj, param in trace.events:
+        if t < start:
+            col = 0
+        elif t > end:
+            break
+        else:
+            col = column(t)
+            paint(col + 1)
+
+        if event == CODE['SWITCHED_IN']:
+            if running is not None and running != obj:
+                state[running] = ' ' if blocking else '+'
+            running = obj
+            blocking = False
+            state[obj] = '#'
+        elif event == CODE['READY'] or event == CODE['CREATE']:
+            if obj != running:
+                state[obj] = '+'
+        elif event in BLOCKING:
+            blocking = True
+        elif event in (CODE['SUSPEND'], CODE['DELETE']):
+            if obj == running:
+                blocking = True
+            else:
+                state[obj] = ' '
+        if t >= start:
+            # A column shows the busiest state a task was in during it.
+            for h, s in state.items():
+                row = rows.setdefault(h, ['?'] * width)
+                if RANK[s] > RANK[row[col]]:
+                    row[col] = s
+    paint(width)
+
+    name_width = max([len(trace.task(h)) for h in rows] + [4])
+    print('\nTimeline %s to %s, %s per column:' % (fmt_time(start), fmt_time(end),
+                                                    fmt_time(span / width)))
+    for h in sorted(rows, key=lambda h: trace.task(h)):
+        print('  %-*s |%s|' % (name_width, trace.task(h), ''.join(rows[h])))
+
+
+def main():
+    ap = argparse.ArgumentParser(description='Decode a FreeRTOS kernel event trace.')
+    ap.add_argument('trace', nargs='?', type=argparse.FileType('rb'), default=sys.stdin.buffer,
+                    help='the trace file or serial capture (default stdin)')
+    ap.add_argument('--width', type=int, default=100, help='timeline columns (default 100)')
+    ap.add_argument('--from', dest='start', type=float, help='start of the timeline, in seconds')
+    ap.add_argument('--to', dest='end', type=float, help='end of the timeline, in seconds')
+    ap.add_argument('--events', action='store_true', help='list every event')
+    args = ap.parse_args()
+
+    trace = Trace()
+    for block in read_blocks(args.trace.read()):
+        trace.add(*block)
+
+    if not trace.blocks:
+        sys.exit('no trace found')
+    if not trace.events:
+        sys.exit('the trace has no events')
+
+    resolution = 1.0 / trace.stamp_hz
+    first, last = trace.events[0][0], trace.events[-1][0]
+    print('%u blocks, %u events over %s, timestamps every %s, %u event buffer'
+          % (trace.blocks, len(trace.events), fmt_time(last - first), fmt_time(resolution),
+             trace.buffer))
+    if trace.lost:
+        print('%u events were overwritten before they were flushed; flush more often.' % trace.lost)
+    if trace.truncated:
+        print('%u blocks were cut short.' % trace.truncated)
+
+    if args.events:
+        print('\n        TIME EVENT                          OBJECT  PARAM')
+        for t, event, obj, param in trace.events:
+            name = EVENTS.get(event, '0x%02x' % event)
+            what = trace.task(obj) if event in TASK_EVENTS else '0x%04x' % obj
+            if event == CODE['QUEUE_CREATE']:
+                param = QUEUE_TYPES.get(param, param)
+            print('%12.6f %-30s %-8s %s' % (t - first, name, what, param))
+
+    start = first + (args.start if args.start is not None else 0)
+    end = first + args.end if args.end is not None else last
+    if end > start and args.width > 0:
+        timelines(trace, start, end, args.width)
+
+    # Ready to running, per task.
+    ready = {}
+    latency = {}
+    for t, event, obj, param in trace.events:
+        if event == CODE['READY'] and obj not in ready:
+            ready[obj] = t
+        elif event == CODE['SWITCHED_IN'] and obj in ready:
+            latency.setdefault(obj, []).append(t - ready.pop(obj))
+    if latency:
+        print('\nReady to running:')
+        for h in sorted(latency, key=lambda h: trace.task(h)):
+            histogram(trace.task(h), latency[h])
+
+    # Send from an interrupt to the next receive by a task, per queue.
+    sent = {}
+    latency = {}
+    for t, event, obj, param in trace.events:
+        if event == CODE['QUEUE_SEND_FROM_ISR']:
+            sent.setdefault(obj, []).append(t)
+        elif event == CODE['QUEUE_RECEIVE'] and sent.get(obj):
+            latency.setdefault(obj, []).append(t - sent[obj].pop(0))
+    if latency:
+        print('\nInterrupt send to task receive:')
+        for q in sorted(latency):
+            histogram('queue 0x%04x' % q, latency[q])
+
+    # User events: counts, unpaired zero values, and the time to the next task switch.
+    users = OrderedDict()
+    pending = []
+    for t, event, obj, param in trace.events:
+        if event == CODE['USER']:
+            u = users.setdefault(param, {'count': 0, 'zero': 0, 'unpaired': 0, 'armed': False,
+                                         'switch': []})
+            u['count'] += 1
+            if obj == 0:
+                u['zero'] += 1
+                if not u['armed']:
+                    u['unpaired'] += 1
+                u['armed'] = False
+            else:
+                u['armed'] = True
+            pending.append((param, t))
+        elif event == CODE['SWITCHED_IN'] and pending:
+            for code, since in pending:
+                users[code]['switch'].append(t - since)
+            pending = []
+    if users:
+        print('\nUser events:')
+        for code, u in sorted(users.items()):
+            print('  code %u: %u events, %u with value 0, %u unpaired' % (code, u['count'], u['zero'],
+                                                                          u['unpaired']))
+            histogram('to the next task switch', u['switch'])
+
+
+if __name__ == '__main__':
+    main()